@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Small portable bit-twiddling helpers for the mask-driven particle passes.
+class BitUtil
+{
+public:
+	// Index of the lowest set bit. Undefined for 0 (callers loop while bits != 0).
+	static int CountTrailingZeros(const uint64_t bits)
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+		unsigned long index;
+		_BitScanForward64(&index, bits);
+		return static_cast<int>(index);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		if (_BitScanForward(&index, static_cast<unsigned long>(bits)))
+		{
+			return static_cast<int>(index);
+		}
+		_BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+		return static_cast<int>(index) + 32;
+#else
+		return __builtin_ctzll(bits);
+#endif
+	}
+};
@@ -0,0 +1,78 @@
+#include "CpuFeatures.h"
+
+#if defined(LIR_ARCH_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+SimdLevel CpuFeatures::GetSimdLevel()
+{
+	static const SimdLevel level = Detect();
+	return level;
+}
+
+const char* CpuFeatures::GetSimdLevelName(const SimdLevel level)
+{
+	switch (level)
+	{
+	case SimdLevel::Sse2: return "SSE2";
+	case SimdLevel::Sse41: return "SSE4.1";
+	case SimdLevel::Avx2: return "AVX2";
+	case SimdLevel::Neon: return "NEON";
+	default: return "Scalar";
+	}
+}
+
+bool CpuFeatures::IsSupported(const SimdLevel level)
+{
+	if (level == SimdLevel::Scalar) return true;
+#if defined(LIR_ARCH_X86)
+	return level != SimdLevel::Neon && static_cast<int>(level) <= static_cast<int>(GetSimdLevel());
+#elif defined(LIR_ARCH_ARM64)
+	return level == SimdLevel::Neon;
+#else
+	return false;
+#endif
+}
+
+SimdLevel CpuFeatures::Detect()
+{
+#if defined(LIR_ARCH_X86) && defined(_MSC_VER)
+	int regs[4] = {};
+	__cpuid(regs, 0);
+	const int maxLeaf = regs[0];
+
+	__cpuid(regs, 1);
+	const bool sse2 = (regs[3] & (1 << 26)) != 0;
+	const bool sse41 = (regs[2] & (1 << 19)) != 0;
+	const bool osxsave = (regs[2] & (1 << 27)) != 0;
+	const bool avx = (regs[2] & (1 << 28)) != 0;
+
+	bool avx2 = false;
+	if (maxLeaf >= 7 && osxsave && avx)
+	{
+		// The OS must also save the YMM state across context switches.
+		const unsigned long long xcr0 = _xgetbv(0);
+		if ((xcr0 & 0x6) == 0x6)
+		{
+			__cpuidex(regs, 7, 0);
+			avx2 = (regs[1] & (1 << 5)) != 0;
+		}
+	}
+
+	if (avx2) return SimdLevel::Avx2;
+	if (sse41) return SimdLevel::Sse41;
+	if (sse2) return SimdLevel::Sse2;
+	return SimdLevel::Scalar;
+#elif defined(LIR_ARCH_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+	if (__builtin_cpu_supports("sse4.1")) return SimdLevel::Sse41;
+	if (__builtin_cpu_supports("sse2")) return SimdLevel::Sse2;
+	return SimdLevel::Scalar;
+#elif defined(LIR_ARCH_ARM64)
+	return SimdLevel::Neon; // Advanced SIMD is mandatory on ARM64
+#else
+	return SimdLevel::Scalar;
+#endif
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+// Runtime CPU feature detection for the batched (SIMD) particle kernels.
+// Detection runs once; kernels pick their implementation from the result so a
+// single binary uses AVX2 where the CPU (and OS) support it and falls back to
+// SSE2 / NEON / scalar code elsewhere.
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define LIR_ARCH_X86 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define LIR_ARCH_ARM64 1
+#endif
+
+// GCC/Clang only emit wider instructions inside functions tagged for them;
+// MSVC accepts intrinsics anywhere, so the tags expand to nothing there.
+#if defined(LIR_ARCH_X86) && !defined(_MSC_VER)
+#define LIR_TARGET_SSE2 __attribute__((target("sse2")))
+#define LIR_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define LIR_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LIR_TARGET_SSE2
+#define LIR_TARGET_SSE41
+#define LIR_TARGET_AVX2
+#endif
+
+enum class SimdLevel
+{
+	Scalar,
+	Sse2,
+	Sse41,
+	Avx2,
+	Neon
+};
+
+class CpuFeatures
+{
+public:
+	// Best instruction set usable on this machine (cached after the first call).
+	static SimdLevel GetSimdLevel();
+	static const char* GetSimdLevelName(SimdLevel level);
+	// True when a kernel may be forced to `level` here: Scalar everywhere, every
+	// x86 level up to GetSimdLevel(), NEON on ARM64.
+	static bool IsSupported(SimdLevel level);
+
+private:
+	static SimdLevel Detect();
+};
@@ -0,0 +1,225 @@
+#include "D2DRenderBackend.h"
+
+D2DRenderBackend::D2DRenderBackend(ID2D1RenderTarget* target) : Target(target)
+{
+	target->GetFactory(Factory.GetAddressOf());
+	// Sprite batches (flakes, splatters) require ID2D1DeviceContext3.
+	Microsoft::WRL::ComPtr<ID2D1RenderTarget>(target).As(&Dc3);
+}
+
+ID2D1SolidColorBrush* D2DRenderBackend::Brush(const Color& color)
+{
+	const D2D1_COLOR_F d2dColor = D2D1::ColorF(color.R, color.G, color.B, color.A);
+	if (SolidBrush == nullptr)
+	{
+		if (FAILED(Target->CreateSolidColorBrush(d2dColor, SolidBrush.GetAddressOf()))) return nullptr;
+		BrushColor = color;
+	}
+	else if (color.R != BrushColor.R || color.G != BrushColor.G || color.B != BrushColor.B || color.A != BrushColor.A)
+	{
+		SolidBrush->SetColor(d2dColor);
+		BrushColor = color;
+	}
+	return SolidBrush.Get();
+}
+
+void D2DRenderBackend::SetAntialiasing(const bool enabled)
+{
+	Target->SetAntialiasMode(enabled ? D2D1_ANTIALIAS_MODE_PER_PRIMITIVE : D2D1_ANTIALIAS_MODE_ALIASED);
+}
+
+void D2DRenderBackend::PushClip(const float left, const float top, const float right, const float bottom)
+{
+	Target->PushAxisAlignedClip(D2D1::RectF(left, top, right, bottom), D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
+}
+
+void D2DRenderBackend::PopClip()
+{
+	Target->PopAxisAlignedClip();
+}
+
+void D2DRenderBackend::DrawLine(const Vector2 start, const Vector2 end, const float width, const Color& color)
+{
+	ID2D1SolidColorBrush* brush = Brush(color);
+	if (brush == nullptr) return;
+	Target->DrawLine(ToD2DPoint(start), ToD2DPoint(end), brush, width);
+}
+
+void D2DRenderBackend::FillEllipse(const Vector2 center, const float radiusX, const float radiusY, const Color& color)
+{
+	ID2D1SolidColorBrush* brush = Brush(color);
+	if (brush == nullptr) return;
+	Target->FillEllipse(D2D1::Ellipse(ToD2DPoint(center), radiusX, radiusY), brush);
+}
+
+void D2DRenderBackend::FillPolygon(const Vector2* points, const size_t count, const Color& color)
+{
+	if (count < 3 || Factory == nullptr) return;
+	ID2D1SolidColorBrush* brush = Brush(color);
+	if (brush == nullptr) return;
+
+	Microsoft::WRL::ComPtr<ID2D1PathGeometry> geometry;
+	if (FAILED(Factory->CreatePathGeometry(geometry.GetAddressOf()))) return;
+	Microsoft::WRL::ComPtr<ID2D1GeometrySink> sink;
+	if (FAILED(geometry->Open(sink.GetAddressOf()))) return;
+
+	// Vector2 is two floats, as D2D1_POINT_2F.
+	static_assert(sizeof(Vector2) == sizeof(D2D1_POINT_2F), "Vector2 must match D2D1_POINT_2F");
+	sink->BeginFigure(ToD2DPoint(points[0]), D2D1_FIGURE_BEGIN_FILLED);
+	sink->AddLines(reinterpret_cast<const D2D1_POINT_2F*>(points + 1), static_cast<UINT32>(count - 1));
+	sink->EndFigure(D2D1_FIGURE_END_CLOSED);
+	if (FAILED(sink->Close())) return;
+
+	Target->FillGeometry(geometry.Get(), brush);
+}
+
+void D2DRenderBackend::FillQuads(const Vector2* corners, const size_t quadCount, const Color& color)
+{
+	if (quadCount == 0 || Factory == nullptr) return;
+	ID2D1SolidColorBrush* brush = Brush(color);
+	if (brush == nullptr) return;
+
+	Microsoft::WRL::ComPtr<ID2D1PathGeometry> geometry;
+	if (FAILED(Factory->CreatePathGeometry(geometry.GetAddressOf()))) return;
+	Microsoft::WRL::ComPtr<ID2D1GeometrySink> sink;
+	if (FAILED(geometry->Open(sink.GetAddressOf()))) return;
+
+	// Nonzero fill, so overlapping quads stay covered instead of cancelling out.
+	sink->SetFillMode(D2D1_FILL_MODE_WINDING);
+	for (size_t i = 0; i < quadCount; ++i)
+	{
+		const Vector2* quad = corners + i * 4;
+		sink->BeginFigure(ToD2DPoint(quad[0]), D2D1_FIGURE_BEGIN_FILLED);
+		sink->AddLines(reinterpret_cast<const D2D1_POINT_2F*>(quad + 1), 3);
+		sink->EndFigure(D2D1_FIGURE_END_CLOSED);
+	}
+	if (FAILED(sink->Close())) return;
+
+	Target->FillGeometry(geometry.Get(), brush);
+}
+
+void D2DRenderBackend::BuildSpriteSheet(const SpriteSheet sheet, const float width, const float height,
+                                        const std::function<void(RenderBackend&)>& draw)
+{
+	Microsoft::WRL::ComPtr<ID2D1BitmapRenderTarget> bmpRT;
+	if (FAILED(Target->CreateCompatibleRenderTarget(D2D1::SizeF(width, height), &bmpRT))) return;
+
+	bmpRT->BeginDraw();
+	bmpRT->Clear(D2D1::ColorF(0.0f, 0.0f, 0.0f, 0.0f)); // Transparent
+	{
+		D2DRenderBackend target(bmpRT.Get());
+		draw(target);
+	}
+	if (FAILED(bmpRT->EndDraw())) return;
+
+	Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap;
+	if (SUCCEEDED(bmpRT->GetBitmap(&bitmap)))
+	{
+		Sheets[static_cast<int>(sheet)] = bitmap;
+	}
+}
+
+void D2DRenderBackend::ReleaseSpriteSheets()
+{
+	for (Microsoft::WRL::ComPtr<ID2D1Bitmap>& sheet : Sheets) sheet.Reset();
+	SpriteSource = nullptr;
+}
+
+void D2DRenderBackend::BeginSprites(const SpriteSheet sheet)
+{
+	SpriteSource = nullptr;
+	if (Dc3 == nullptr || Sheets[static_cast<int>(sheet)] == nullptr) return;
+	if (SpriteBatch == nullptr)
+	{
+		if (FAILED(Dc3->CreateSpriteBatch(SpriteBatch.GetAddressOf()))) return;
+	}
+	SpriteBatch->Clear();
+	SpriteSource = Sheets[static_cast<int>(sheet)].Get();
+}
+
+void D2DRenderBackend::AddSprites(const SpriteRect& source, const SpriteRect* dests, const SpriteTransform* transforms,
+                                  const float* alphas, const size_t count)
+{
+	if (SpriteSource == nullptr || count == 0) return;
+
+	// The sprites come in Direct2D's layout.
+	static_assert(sizeof(SpriteRect) == sizeof(D2D1_RECT_F), "SpriteRect must match D2D1_RECT_F");
+	static_assert(sizeof(SpriteTransform) == sizeof(D2D1_MATRIX_3X2_F), "SpriteTransform must match D2D1_MATRIX_3X2_F");
+
+	// Source rects are in sheet pixels (D2D1_RECT_U), from the sheet's actual
+	// pixel size (DPI-safe). It is passed once with a zero stride.
+	const D2D1_SIZE_U sheetPx = SpriteSource->GetPixelSize();
+	const auto toPixels = [](const float fraction, const UINT32 size)
+	{
+		return static_cast<UINT32>(fraction * static_cast<float>(size) + 0.5f);
+	};
+	const D2D1_RECT_U src = D2D1::RectU(toPixels(source.Left, sheetPx.width), toPixels(source.Top, sheetPx.height),
+	                                    toPixels(source.Right, sheetPx.width), toPixels(source.Bottom, sheetPx.height));
+
+	// Fades are white tints with the sprite's alpha (the sheet is premultiplied,
+	// so the tint scales every channel); no colors at all when nothing fades.
+	const D2D1_COLOR_F* tints = nullptr;
+	if (alphas != nullptr)
+	{
+		SpriteTints.resize(count);
+		for (size_t i = 0; i < count; ++i) SpriteTints[i] = D2D1::ColorF(1.0f, 1.0f, 1.0f, alphas[i]);
+		tints = SpriteTints.data();
+	}
+
+	SpriteBatch->AddSprites(static_cast<UINT32>(count), reinterpret_cast<const D2D1_RECT_F*>(dests), &src, tints,
+	                        reinterpret_cast<const D2D1_MATRIX_3X2_F*>(transforms), sizeof(D2D1_RECT_F), 0,
+	                        tints != nullptr ? sizeof(D2D1_COLOR_F) : 0,
+	                        transforms != nullptr ? sizeof(D2D1_MATRIX_3X2_F) : 0);
+}
+
+void D2DRenderBackend::EndSprites()
+{
+	if (SpriteSource == nullptr) return;
+
+	// Sprite batch requires aliased AA; sprite edges are pre-antialiased in the sheet.
+	const D2D1_ANTIALIAS_MODE prevAA = Dc3->GetAntialiasMode();
+	Dc3->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+	Dc3->DrawSpriteBatch(SpriteBatch.Get(), SpriteSource);
+	Dc3->SetAntialiasMode(prevAA);
+	SpriteSource = nullptr;
+}
+
+bool D2DRenderBackend::ResizeImage(const int width, const int height)
+{
+	const D2D1_SIZE_U size = D2D1::SizeU(static_cast<UINT32>(width), static_cast<UINT32>(height));
+	if (SettledBitmap != nullptr && SettledBitmap->GetPixelSize().width == size.width &&
+		SettledBitmap->GetPixelSize().height == size.height)
+	{
+		return false;
+	}
+
+	// A (re)created bitmap starts undefined, so the caller hands over every row.
+	SettledBitmap.Reset();
+	const D2D1_BITMAP_PROPERTIES properties = D2D1::BitmapProperties(
+		D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+	Target->CreateBitmap(size, nullptr, 0, properties, SettledBitmap.GetAddressOf());
+	return true;
+}
+
+void D2DRenderBackend::UploadImageRows(const SnowRaster& raster)
+{
+	if (SettledBitmap == nullptr) return;
+	const UINT32 width = SettledBitmap->GetPixelSize().width;
+	if (static_cast<UINT32>(raster.Width()) != width) return;
+
+	const UINT32 pitch = width * sizeof(uint32_t);
+	for (const SnowRaster::Span& span : raster.DirtySpans())
+	{
+		const D2D1_RECT_U rows = D2D1::RectU(0, static_cast<UINT32>(span.Begin), width, static_cast<UINT32>(span.End));
+		SettledBitmap->CopyFromMemory(&rows, raster.Pixels() + span.Offset, pitch);
+	}
+}
+
+void D2DRenderBackend::DrawImage(const float left, const float top)
+{
+	if (SettledBitmap == nullptr) return;
+	const D2D1_SIZE_U size = SettledBitmap->GetPixelSize();
+	Target->DrawBitmap(SettledBitmap.Get(),
+	                   D2D1::RectF(left, top, left + static_cast<float>(size.width), top + static_cast<float>(size.height)),
+	                   1.0f, D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
+}
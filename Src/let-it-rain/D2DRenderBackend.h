@@ -0,0 +1,68 @@
+#pragma once
+
+#include <d2d1_3.h>
+#include <vector>
+#include <wrl/client.h>
+
+#include "RenderBackend.h"
+
+// D2DRenderBackend Class
+// Direct2D implementation of RenderBackend on a render target: the swap-chain
+// device context of a display, or the bitmap target of a sprite sheet. Owns
+// the device resources of the draw paths (one solid brush recolored per call,
+// the sprite sheets and batch, the settled-snow bitmap); they are rebuilt
+// with the backend on device loss.
+class D2DRenderBackend final : public RenderBackend
+{
+public:
+	explicit D2DRenderBackend(ID2D1RenderTarget* target);
+
+	void SetAntialiasing(bool enabled) override;
+	void PushClip(float left, float top, float right, float bottom) override;
+	void PopClip() override;
+
+	void DrawLine(Vector2 start, Vector2 end, float width, const Color& color) override;
+	void FillEllipse(Vector2 center, float radiusX, float radiusY, const Color& color) override;
+	void FillPolygon(const Vector2* points, size_t count, const Color& color) override;
+	// All quads as figures of one path geometry (nonzero fill), one FillGeometry.
+	void FillQuads(const Vector2* corners, size_t quadCount, const Color& color) override;
+
+	bool HasSpriteSheet(SpriteSheet sheet) const override { return Sheets[static_cast<int>(sheet)] != nullptr; }
+	void BuildSpriteSheet(SpriteSheet sheet, float width, float height,
+	                      const std::function<void(RenderBackend&)>& draw) override;
+	void ReleaseSpriteSheets() override;
+	// One ID2D1SpriteBatch per Begin/End; fades are per-sprite tint colors.
+	// Needs ID2D1DeviceContext3 (Windows 10+); draws nothing on other targets.
+	void BeginSprites(SpriteSheet sheet) override;
+	void AddSprites(const SpriteRect& source, const SpriteRect* dests, const SpriteTransform* transforms,
+	                const float* alphas, size_t count) override;
+	void EndSprites() override;
+
+	bool ResizeImage(int width, int height) override;
+	void UploadImageRows(const SnowRaster& raster) override;
+	void DrawImage(float left, float top) override;
+
+private:
+	// The brush in `color`; SetColor only when it differs from the last call's.
+	ID2D1SolidColorBrush* Brush(const Color& color);
+	static D2D1_POINT_2F ToD2DPoint(const Vector2& v) { return D2D1::Point2F(v.x, v.y); }
+
+	ID2D1RenderTarget* Target;
+	Microsoft::WRL::ComPtr<ID2D1DeviceContext3> Dc3; // null below Windows 10
+	// Cached factory for per-frame geometry creation (avoids a GetFactory call each frame).
+	Microsoft::WRL::ComPtr<ID2D1Factory> Factory;
+
+	Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> SolidBrush;
+	Color BrushColor = { -1.0f, -1.0f, -1.0f, -1.0f };
+
+	// Sprite sheets (pre-colored bitmaps) and the sprite batch reused by every
+	// Begin/EndSprites.
+	Microsoft::WRL::ComPtr<ID2D1Bitmap> Sheets[SPRITE_SHEET_COUNT];
+	Microsoft::WRL::ComPtr<ID2D1SpriteBatch> SpriteBatch;
+	ID2D1Bitmap* SpriteSource = nullptr; // sheet between BeginSprites and EndSprites
+	std::vector<D2D1_COLOR_F> SpriteTints; // per-sprite fades of one AddSprites
+
+	// Per-pixel settled snow is kept as one persistent bitmap, drawn with a
+	// single call; only the raster's changed rows are copied into it.
+	Microsoft::WRL::ComPtr<ID2D1Bitmap> SettledBitmap;
+};
@@ -1,64 +1,34 @@
 #pragma once
 
 #include <d2d1_3.h>
-#include <vector>
 #include <dcomp.h>
 #include <wrl/client.h>
-#include <memory>
 
-class FastNoiseLite;
+#include "D2DRenderBackend.h"
+#include "RenderBackend.h"
+#include "SimulationData.h"
+#include "SnowRaster.h"
 
-class DisplayData
+// Windows side of a display: the platform-neutral simulation state plus the
+// Direct2D backend (and its device resources) used to draw it.
+class DisplayData final : public SimulationData
 {
 public:
 	explicit DisplayData(ID2D1DeviceContext* dc);
-	~DisplayData();
+	~DisplayData() override;
 	void SetRainColor(COLORREF color);
-	void SetSceneBounds(RECT sceneRect, float scaleFactor);
-	void InvalidateSnowAtlas();
-	void ClearSnowAccumulation();
-	// Switch settle representation: frees the per-pixel buffer in simple mode,
-	// (re)allocates it in per-pixel mode, then clears the heap.
-	void ApplySnowHeapMode(bool simple);
-
-	int Width = 100;
-	int Height = 100;
-	float ScaleFactor = 1.0f; // FullHD is considered as 1. 4K will be 2(twice height and width change).
-
-	RECT SceneRect = { 0, 0, 100, 100 };
-	RECT SceneRectNorm = { 0, 0, 100, 100 }; // normalized to left top as 0,0
+	void InvalidateSpriteSheets();
 
 	ID2D1DeviceContext* DC;
 
-	// Cached D2D factory (from DC) for per-frame geometry creation — avoids a
-	// GetFactory call each frame. Refreshed with this DisplayData on device loss.
-	Microsoft::WRL::ComPtr<ID2D1Factory> Factory;
-
-	Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> DropColorBrush;
-	// Single brush reused for all splatter draws — opacity is set dynamically at draw time
-	Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> SplatterColorBrush;
-
-	// Snow flakes are drawn with one batched sprite call: a 2x2 atlas of the
-	// four shapes plus a reused sprite batch. Both are device-dependent (rebuilt
-	// on device loss); the atlas is also rebuilt on particle-color change.
-	Microsoft::WRL::ComPtr<ID2D1Bitmap> SnowAtlas;
-	Microsoft::WRL::ComPtr<ID2D1SpriteBatch> SnowSpriteBatch;
-
-	int MaxSnowHeight = 0;
-	std::vector<uint8_t> ScenePixels;
-
-	// "Simple snow heap" mode: settled snow as a per-column height (pixels)
-	// instead of the per-pixel ScenePixels accumulation — O(Width) memory and
-	// per-frame cost. Selected at runtime via the settings checkbox.
-	bool SimpleSnowHeap = false;
-	std::vector<float> ColumnHeights;
-	int SnowColumnWidth = 1; // width in pixels of each ColumnHeights entry (DPI-scaled)
-
-	std::unique_ptr<FastNoiseLite> pNoiseGen;
-
-private:
-	// Allocate the per-pixel ScenePixels buffer in per-pixel mode, or free it in
-	// simple mode. forceRealloc re-creates it (e.g. after a scene-bounds change).
-	void AllocateOrFreeScenePixels(bool forceRealloc);
-	static bool IsSame(const RECT& l, const RECT& r);
-};
\ No newline at end of file
+	// The renderers draw through this (see RenderBackend); it owns the device
+	// resources of the draw paths and is rebuilt with this DisplayData on device loss.
+	D2DRenderBackend Backend;
+	// Particle color of rain, splatters, flakes and settled snow (opaque).
+	RenderBackend::Color ParticleColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+	// Per-pixel settled snow: SettledRaster rasterizes only the rows that
+	// changed since the last drawn frame (by the stamps of the frame's copy of
+	// ScenePixels), and just those rows are uploaded to the backend's image.
+	SnowRaster SettledRaster;
+};
@@ -14,8 +14,10 @@
 #include "CPUUsageTracker.h"
 #include "Global.h"
 #include "MathUtil.h"
+#include "RainRenderer.h"
 #include "Resource.h"
 #include "SettingsManager.h"
+#include "SnowRenderer.h"
 
 #ifndef HINST_THISCOMPONENT
 EXTERN_C IMAGE_DOS_HEADER __ImageBase;
@@ -99,6 +101,7 @@ HRESULT DisplayWindow::Initialize(const HINSTANCE hInstance, const MonitorData&
 	pDisplaySpecificData = std::make_unique<DisplayData>(Dc.Get());
 	pDisplaySpecificData->SetRainColor(GeneralSettings.ParticleColor);
 	pDisplaySpecificData->SimpleSnowHeap = GeneralSettings.SimpleSnowHeap;
+	pDisplaySpecificData->SeedRandomStreams(GeneralSettings.RandomSeed, MonitorDat.Index);
 	HandleWindowBoundsChange(window, false);
 
 	// Apply the AllowHide setting from saved configuration
@@ -130,11 +133,14 @@ void DisplayWindow::UpdateParticleColor(const COLORREF color)
 void DisplayWindow::UpdateParticleType(const ParticleType partType)
 {
 	GeneralSettings.PartType = partType;
+	DiscardFrames();
 }
 
 void DisplayWindow::UpdateSnowHeapMode(const bool simpleSnowHeap)
 {
 	GeneralSettings.SimpleSnowHeap = simpleSnowHeap;
+	// The step in flight still settles the current heap.
+	DiscardFrames();
 	if (pDisplaySpecificData)
 	{
 		// Frees/allocates the per-pixel buffer to match the mode, then clears the heap.
@@ -294,13 +300,35 @@ double DisplayWindow::GetCurrentTimeInSeconds()
 }
 
 void DisplayWindow::Animate()
+{
+	if (Visibility.GetState() != VisibilityTracker::State::Visible)
+	{
+		if (Visibility.TakeKeepAliveTick(GetCurrentTimeInSeconds()))
+		{
+			KeepAlive();
+		}
+		return;
+	}
+	if (!BeginFrame()) return;
+	Render();
+	FinishSimulation();
+	SimulationStep step;
+	if (TakeSimulationStep(step))
+	{
+		Simulate(step);
+	}
+}
+
+bool DisplayWindow::BeginFrame()
 {
 	// Do not render while the session is locked
-	if (IsSessionLocked) return;
+	if (IsSessionLocked) return false;
 
 	// If the device was lost, attempt to recreate it before rendering
 	if (IsDeviceLost)
 	{
+		// The step in flight still uses the DisplayData about to be replaced.
+		FinishSimulation();
 		ReleaseDeviceResources();
 		if (SUCCEEDED(RecreateDeviceResources(WindowHandle)))
 		{
@@ -311,33 +339,34 @@ void DisplayWindow::Animate()
 		}
 		else
 		{
-			return; // not ready yet, retry next frame
+			return false; // not ready yet, retry next frame
 		}
 	}
 
-	// Variable timestep (matches the macOS build): integrate exactly one step per
-	// rendered frame using the real elapsed time, clamped to 50 ms so a stall or a
-	// device-lost recovery can't produce a huge integration jump. All particle
-	// physics is time-scaled (× deltaSeconds), so rain/splatter/snow motion is
-	// frame-rate independent. (Snow settling is per-frame and intentionally runs
-	// faster on high-refresh monitors — it's Windows-only and low priority.)
+	// The real elapsed time, clamped to MAX_STEP_SECONDS, advances the frame
+	// clock; the physics catches up with it in steps (TakeSimulationStep). All
+	// particle physics is time-scaled (× deltaSeconds), so rain/splatter/snow
+	// motion is frame-rate independent either way. (Snow settling is per-update,
+	// so without a fixed SimulationRate it runs faster on high-refresh monitors.)
 	const double newTime = GetCurrentTimeInSeconds();
-	float deltaSeconds;
+	float frameSeconds;
 	if (CurrentTime < 0)
 	{
 		// First frame after start/recovery: no previous timestamp — use a nominal step.
-		deltaSeconds = 1.0f / 60.0f;
+		frameSeconds = 1.0f / 60.0f;
 	}
 	else
 	{
 		const double elapsed = newTime - CurrentTime;
-		deltaSeconds = static_cast<float>(elapsed > 0.05 ? 0.05 : elapsed);
+		frameSeconds = static_cast<float>(elapsed > MAX_STEP_SECONDS ? MAX_STEP_SECONDS : elapsed);
 	}
 	CurrentTime = newTime;
+	FrameClock += frameSeconds;
+	LastFrameSeconds = frameSeconds;
 
 #ifdef SHOW_FPS
 	FpsFrameCount++;
-	FpsElapsed += deltaSeconds;
+	FpsElapsed += frameSeconds;
 	if (FpsElapsed >= 0.5)
 	{
 		CurrentFps = static_cast<float>(FpsFrameCount / FpsElapsed);
@@ -345,25 +374,205 @@ void DisplayWindow::Animate()
 		FpsElapsed = 0.0;
 	}
 #endif
+	return true;
+}
+
+void DisplayWindow::StartSimulation()
+{
+	// The previous step is still running: keep drawing the last snapshot; the
+	// time it hasn't covered goes into a later step.
+	if (!SimulationGroup.Done()) return;
+
+	SimulationStep step;
+	if (!TakeSimulationStep(step)) return;
+	SubmitStep(step);
+}
+
+void DisplayWindow::SubmitStep(const SimulationStep& step)
+{
+	TaskPool& taskPool = TaskPool::GetInstance();
+	if (taskPool.WorkerCount() == 0)
+	{
+		// No pool threads to run it before the next Wait: step inline instead.
+		Simulate(step);
+		return;
+	}
+	taskPool.Submit(SimulationGroup, [this, step] { Simulate(step); });
+}
+
+void DisplayWindow::FinishSimulation()
+{
+	TaskPool::GetInstance().Wait(SimulationGroup);
+}
+
+QualityGovernor::Knobs DisplayWindow::CurrentKnobs() const
+{
+	QualityGovernor::Knobs knobs = Quality.GetKnobs();
+	knobs.ParticleScale = (std::min)(knobs.ParticleScale, PowerLimits.ParticleScale);
+	knobs.SettleInterval = (std::max)(knobs.SettleInterval, PowerLimits.SettleInterval);
+	return knobs;
+}
+
+void DisplayWindow::CopyStepSettings(SimulationStep& step) const
+{
+	step.Knobs = CurrentKnobs();
+	step.MaxParticles = GeneralSettings.MaxParticles;
+	step.WindSpeed = GeneralSettings.WindSpeed;
+	step.PartType = GeneralSettings.PartType;
+	step.ParallelUpdate = GeneralSettings.ParallelUpdate;
+}
 
-	if (GeneralSettings.PartType == RAIN)
+bool DisplayWindow::TakeSimulationStep(SimulationStep& step)
+{
+	step.ClockTime = CurrentTime;
+	CopyStepSettings(step);
+	const unsigned int rate = GeneralSettings.SimulationRate;
+	if (rate == 0)
+	{
+		// Variable timestep (matches the macOS build): one update up to the frame
+		// being drawn; time beyond MAX_STEP_SECONDS is dropped.
+		step.Ticks = 1;
+		step.TickSeconds = static_cast<float>((std::min)(FrameClock - SimulatedClock, static_cast<double>(MAX_STEP_SECONDS)));
+		step.EndTime = FrameClock;
+		step.Interpolated = false;
+		SimulatedClock = FrameClock;
+		return true;
+	}
+
+	// Fixed ticks through the end of the next frame, which is the first to draw
+	// this step: it shows the state one tick behind its clock, so everything it
+	// needs is simulated by then and it blends between the last two ticks.
+	const double tickSeconds = 1.0 / rate;
+	const double horizon = FrameClock + LastFrameSeconds;
+	int ticks = static_cast<int>((horizon - SimulatedClock) / tickSeconds);
+	if (ticks <= 0) return false;
+	if (ticks > MAX_TICKS_PER_STEP)
+	{
+		// Fallen too far behind (a hitch, or a machine slower than the rate):
+		// skip the excess rather than spend ever longer steps catching up.
+		ticks = MAX_TICKS_PER_STEP;
+		SimulatedClock = horizon - ticks * tickSeconds;
+	}
+	SimulatedClock += ticks * tickSeconds;
+
+	step.Ticks = ticks;
+	step.TickSeconds = static_cast<float>(tickSeconds);
+	step.EndTime = SimulatedClock;
+	step.Interpolated = true;
+	return true;
+}
+
+void DisplayWindow::Simulate(const SimulationStep& step)
+{
+	const double startTime = GetCurrentTimeInSeconds();
+	pDisplaySpecificData->NoiseRefreshScale = step.Knobs.NoiseRefreshScale;
+	pDisplaySpecificData->ParallelUpdate = step.ParallelUpdate;
+	for (int tick = 0; tick < step.Ticks; ++tick)
+	{
+		// The snow noise clock of this tick, counted back from the step's end.
+		const double clockTime = step.ClockTime - (step.Ticks - 1 - tick) * static_cast<double>(step.TickSeconds);
+		if (step.PartType == RAIN)
+		{
+			UpdateRainDrops(step);
+		}
+		else if (step.PartType == SNOW)
+		{
+			UpdateSnowFlakes(step, clockTime);
+		}
+	}
+
+	FrameSnapshot& frame = Frames.Back();
+	frame.EndTime = step.EndTime;
+	frame.TickSeconds = step.Interpolated ? step.TickSeconds : 0.0f;
+	if (step.PartType == RAIN)
 	{
-		UpdateRainDrops(deltaSeconds);
+		frame.CaptureRain(RainDrops, pDisplaySpecificData.get());
 	}
-	else if (GeneralSettings.PartType == SNOW)
+	else if (step.PartType == SNOW)
 	{
-		UpdateSnowFlakes(deltaSeconds);
+		frame.CaptureSnow(SnowFlakes, pDisplaySpecificData.get(),
+		                  SnowRenderer::FlakeHalfSizePerRadius(pDisplaySpecificData->ScaleFactor));
 	}
+	frame.SimulateSeconds = static_cast<float>(GetCurrentTimeInSeconds() - startTime);
+	Frames.Publish();
+}
+
+void DisplayWindow::KeepAlive()
+{
+	if (!SimulationGroup.Done()) return;
+
+	// Longest regular step; the frame clock stands still meanwhile.
+	SimulationStep step;
+	step.Ticks = 1;
+	step.TickSeconds = MAX_STEP_SECONDS;
+	step.EndTime = SimulatedClock;
+	step.ClockTime = GetCurrentTimeInSeconds();
+	step.Interpolated = false;
+	CopyStepSettings(step);
+	SubmitStep(step);
+}
+
+void DisplayWindow::UpdateVisibility()
+{
+	const bool covered = GeneralSettings.AllowHide && !IsSessionLocked && IsCoveredByForegroundWindow();
+	if (!Visibility.Update(covered, GetCurrentTimeInSeconds())) return;
 
+	if (Visibility.GetState() == VisibilityTracker::State::Visible)
+	{
+		// Resume where the scene stands: the first frame takes a nominal step
+		// rather than the whole time spent hidden.
+		CurrentTime = -1.0;
+	}
+}
+
+bool DisplayWindow::IsCoveredByForegroundWindow() const
+{
+	const HWND hwndFG = GetForegroundWindow();
+	if (!hwndFG || hwndFG == WindowHandle || hwndFG == GetShellWindow() || IsIconic(hwndFG)) return false;
+
+	// The desktop's own windows span the monitor too but are behind us.
+	wchar_t className[16];
+	if (GetClassNameW(hwndFG, className, ARRAYSIZE(className)) &&
+		(wcscmp(className, L"WorkerW") == 0 || wcscmp(className, L"Progman") == 0))
+	{
+		return false;
+	}
+
+	MONITORINFO info = { sizeof(info) };
+	if (!GetMonitorInfo(MonitorFromWindow(WindowHandle, MONITOR_DEFAULTTONEAREST), &info)) return false;
+
+	RECT fgRect = {};
+	GetWindowRect(hwndFG, &fgRect);
+	const RECT& monitorRect = info.rcMonitor;
+	return fgRect.left <= monitorRect.left && fgRect.top <= monitorRect.top &&
+		fgRect.right >= monitorRect.right && fgRect.bottom >= monitorRect.bottom;
+}
+
+void DisplayWindow::DiscardFrames()
+{
+	FinishSimulation();
+	Frames.ForEachSlot([](FrameSnapshot& frame) { frame.Clear(); });
+	// The timings so far were of the old scene (or device).
+	Quality.Reset();
+}
+
+void DisplayWindow::Render()
+{
+	// The newest finished step, or the one drawn last if none finished since,
+	// at this frame's point between its last two ticks.
+	const double drawStart = GetCurrentTimeInSeconds();
+	const bool newStep = Frames.Acquire();
+	const FrameSnapshot& frame = Frames.Front();
+	frame.Interpolate(frame.InterpolationFactor(FrameClock), Geometry);
 	try
 	{
 		if (GeneralSettings.PartType == RAIN)
 		{
-			DrawRainDrops();
+			DrawRainDrops(Geometry, drawStart);
 		}
 		else if (GeneralSettings.PartType == SNOW)
 		{
-			DrawSnowFlakes();
+			DrawSnowFlakes(Geometry, frame, drawStart);
 		}
 	}
 	catch (const ComException&)
@@ -371,6 +580,14 @@ void DisplayWindow::Animate()
 		// Catch any device-lost error that slipped through — schedule recreation
 		IsDeviceLost = true;
 	}
+
+	// Each step's cost counts once, on the frame that first shows it. The step
+	// may have run beside the drawing on another core; counting both is the
+	// safe side on a machine short of cores.
+	if (GeneralSettings.AdaptiveQuality && !IsDeviceLost)
+	{
+		Quality.AddSample(newStep ? frame.SimulateSeconds : 0.0f, LastDrawSeconds);
+	}
 }
 
 void DisplayWindow::InitNotifyIcon(const HWND hWnd)
@@ -550,20 +767,26 @@ void DisplayWindow::InitDirect2D(const HWND hWnd)
 
 void DisplayWindow::HandleWindowBoundsChange(const HWND window, const bool clearDrops)
 {
+	UpdateFramePeriod();
+
 	RECT sceneRect;
 	float scaleFactor = 1.0f;
 	FindSceneRect(sceneRect, scaleFactor);
-	if (sceneRect != pDisplaySpecificData->SceneRect)
+	if (sceneRect != pDisplaySpecificData->SceneRect || scaleFactor != pDisplaySpecificData->ScaleFactor)
 	{
-		if (!RainDrops.empty() && clearDrops)
+		// The snapshots hold geometry of the old bounds.
+		DiscardFrames();
+		if (clearDrops)
 		{
-			// clear existing value-based drops
-			RainDrops.clear();
+			RainDrops.Clear();
+			pDisplaySpecificData->Splatters.Clear();
 		}
 		pDisplaySpecificData->SetSceneBounds(sceneRect, scaleFactor);
 
 		// Reserve memory to avoid reallocations and fragmentation
-		RainDrops.reserve(GeneralSettings.MaxParticles * RainDrop::RAIN_DROP_MULTIPLIER);
+		const size_t maxDrops = static_cast<size_t>(GeneralSettings.MaxParticles) * RainField::RAIN_DROP_MULTIPLIER;
+		RainDrops.Reserve(maxDrops);
+		pDisplaySpecificData->Splatters.Reserve(RainField::SplatterCapacity(maxDrops));
 
 		//std::wostringstream  oss;
 		//oss << "Monitor Name: " << MonitorDat.Name.c_str() << ", "
@@ -577,13 +800,43 @@ void DisplayWindow::HandleWindowBoundsChange(const HWND window, const bool clear
 	}
 }
 
-void DisplayWindow::HandleTaskBarChange() const
+void DisplayWindow::UpdateFramePeriod()
+{
+	// 0 or 1 Hz stand for "hardware default"; assume 60 Hz then.
+	DEVMODEW mode = { };
+	mode.dmSize = sizeof(mode);
+	unsigned int hertz = 60;
+	if (EnumDisplaySettingsW(MonitorDat.Name.c_str(), ENUM_CURRENT_SETTINGS, &mode) && mode.dmDisplayFrequency > 1)
+	{
+		hertz = mode.dmDisplayFrequency;
+	}
+
+	// Whole vblanks per frame, enough to stay at or under the cap.
+	SyncInterval = 1;
+	if (PowerLimits.MaxFrameRate > 0.0f)
+	{
+		const float vblanks = std::ceil(static_cast<float>(hertz) / PowerLimits.MaxFrameRate - 0.01f);
+		SyncInterval = static_cast<UINT>(std::clamp(vblanks, 1.0f, static_cast<float>(MAX_SYNC_INTERVAL)));
+	}
+	Quality.SetFramePeriod(static_cast<float>(SyncInterval) / static_cast<float>(hertz));
+}
+
+void DisplayWindow::ApplyPowerLimits(const PowerPolicy::Limits& limits)
+{
+	PowerLimits = limits;
+	UpdateFramePeriod();
+}
+
+void DisplayWindow::HandleTaskBarChange()
 {
 	RECT sceneRect;
 	float scaleFactor = 1.0f;
 	FindSceneRect(sceneRect, scaleFactor);
-	if (sceneRect != pDisplaySpecificData->SceneRect)
+	if (sceneRect != pDisplaySpecificData->SceneRect || scaleFactor != pDisplaySpecificData->ScaleFactor)
 	{
+		// SetSceneBounds reallocates what a step in flight reads, and the
+		// snapshots hold geometry of the old bounds.
+		DiscardFrames();
 		pDisplaySpecificData->SetSceneBounds(sceneRect, scaleFactor);
 
 		//std::wostringstream  oss;
@@ -745,15 +998,13 @@ void DisplayWindow::FindSceneRect2(RECT& sceneRect, float& scaleFactor) const
 	scaleFactor = static_cast<float>(monitorHeight) / 1080.0f;
 }
 
-void DisplayWindow::DrawRainDrops()
+void DisplayWindow::DrawRainDrops(const FrameGeometry& geometry, const double drawStart)
 {
 	Dc->BeginDraw();
 	Dc->Clear();
 
-	for (const auto& drop : RainDrops)
-	{
-		drop.Draw(Dc.Get());
-	}
+	DisplayData* pDispData = pDisplaySpecificData.get();
+	RainRenderer::Draw(pDispData->Backend, geometry, pDispData->ParticleColor, Quality.GetKnobs().SmoothTrails);
 
 #ifdef SHOW_FPS
 	{
@@ -772,33 +1023,34 @@ void DisplayWindow::DrawRainDrops()
 		IsDeviceLost = true;
 		return;
 	}
+	LastDrawSeconds = static_cast<float>(GetCurrentTimeInSeconds() - drawStart);
 
 	// Make the swap chain available to the composition engine
-	const HRESULT presentHr = SwapChain->Present(1, 0);
+	const HRESULT presentHr = SwapChain->Present(SyncInterval, 0);
 	if (FAILED(presentHr))
 	{
 		IsDeviceLost = true;
 	}
 }
 
-void DisplayWindow::DrawSnowFlakes()
+void DisplayWindow::DrawSnowFlakes(const FrameGeometry& geometry, const FrameSnapshot& frame, const double drawStart)
 {
 	Dc->BeginDraw();
 	Dc->Clear();
 
 	// Draw all falling flakes in a single batched sprite call.
-	SnowFlake::DrawFallingFlakes(Dc3.Get(), SnowFlakes, pDisplaySpecificData.get());
+	DisplayData* pDispData = pDisplaySpecificData.get();
+	SnowRenderer::DrawFallingFlakes(pDispData->Backend, geometry.Flakes, pDispData->ParticleColor);
 
-	if (!SnowFlakes.empty())
+	if (pDispData->SimpleSnowHeap)
 	{
-		if (pDisplaySpecificData->SimpleSnowHeap)
-		{
-			SnowFlake::DrawSettledSnowSimple(Dc.Get(), pDisplaySpecificData.get());
-		}
-		else
-		{
-			SnowFlake::DrawSettledSnow(Dc.Get(), pDisplaySpecificData.get());
-		}
+		SnowRenderer::DrawSettledSnowSimple(pDispData->Backend, frame.ColumnHeights, pDispData,
+		                                    pDispData->ParticleColor);
+	}
+	else
+	{
+		SnowRenderer::DrawSettledSnow(pDispData->Backend, frame.SettledSnow, pDispData->SettledRaster, pDispData,
+		                              pDispData->ParticleColor);
 	}
 
 #ifdef SHOW_FPS
@@ -818,112 +1070,86 @@ void DisplayWindow::DrawSnowFlakes()
 		IsDeviceLost = true;
 		return;
 	}
+	LastDrawSeconds = static_cast<float>(GetCurrentTimeInSeconds() - drawStart);
 
 	// Make the swap chain available to the composition engine
-	const HRESULT presentHr = SwapChain->Present(1, 0);
+	const HRESULT presentHr = SwapChain->Present(SyncInterval, 0);
 	if (FAILED(presentHr))
 	{
 		IsDeviceLost = true;
 	}
 }
 
-void DisplayWindow::UpdateRainDrops(const float deltaSeconds)
+void DisplayWindow::UpdateRainDrops(const SimulationStep& step)
 {
-	// Move each raindrop to the next point
-	for (auto & drop : RainDrops)
+	const float deltaSeconds = step.TickSeconds;
+	// Move each raindrop to the next point (one streaming pass over the drop
+	// columns), then drop the dead ones and count the still-falling survivors.
+	RainDrops.UpdatePositions(deltaSeconds, pDisplaySpecificData.get());
+	const int countOfFallingDrops = RainDrops.RemoveDead();
+
+	const int maxDrops = static_cast<int>(static_cast<float>(step.MaxParticles * RainField::RAIN_DROP_MULTIPLIER) *
+	                                      step.Knobs.ParticleScale);
+	const int noOfDropsToGenerate = maxDrops - countOfFallingDrops;
+
+	// Grow the splatter ring only when MaxParticles was raised via settings; in
+	// steady state it is already large enough and this never allocates.
+	SplatterPool& splatters = pDisplaySpecificData->Splatters;
+	const size_t splatterCapacity = RainField::SplatterCapacity(static_cast<size_t>(maxDrops));
+	if (splatters.Capacity() < splatterCapacity)
 	{
-		drop.UpdatePosition(deltaSeconds);
+		splatters.Reserve(splatterCapacity);
 	}
 
-	// Remove expired raindrops (swap-and-pop) and, in the same pass, count the
-	// still-falling survivors. A kept element passes through the else-branch
-	// exactly once, so the tally is exact.
-	int countOfFallingDrops = 0;
-	for (size_t i = 0; i < RainDrops.size(); )
-	{
-		if (RainDrops[i].IsReadyForErase())
-		{
-			// Move last element into position i and pop
-			if (i + 1 != RainDrops.size())
-			{
-				RainDrops[i] = std::move(RainDrops.back());
-			}
-			RainDrops.pop_back();
-			// do not increment i, re-evaluate new element at i
-		}
-		else
-		{
-			if (!RainDrops[i].DidTouchGround())
-			{
-				countOfFallingDrops++;
-			}
-			++i;
-		}
-	}
-
-	const int noOfDropsToGenerate = GeneralSettings.MaxParticles * RainDrop::RAIN_DROP_MULTIPLIER - countOfFallingDrops;
-
-	// Generate new raindrops (emplace so constructor runs in-place)
 	if (noOfDropsToGenerate > 0)
 	{
 		// Reserve up front so raising MaxParticles via settings (no bounds change)
-		// can't trigger a mid-loop reallocation of the whole vector.
-		RainDrops.reserve(RainDrops.size() + static_cast<size_t>(noOfDropsToGenerate));
-		for (int i = 0; i < noOfDropsToGenerate; ++i)
-		{
-			RainDrops.emplace_back(GeneralSettings.WindSpeed, pDisplaySpecificData.get());
-		}
+		// grows each column once rather than mid-spawn.
+		RainDrops.Reserve(RainDrops.Size() + static_cast<size_t>(noOfDropsToGenerate));
+		RainDrops.Spawn(noOfDropsToGenerate, step.WindSpeed, pDisplaySpecificData.get());
 	}
 	else if (noOfDropsToGenerate < 0)
 	{
-		// If we have too many drops, remove some dead/falling ones. We'll pop from the back.
-		int excess = -noOfDropsToGenerate;
-		while (excess > 0 && !RainDrops.empty())
-		{
-			RainDrops.pop_back();
-			--excess;
-		}
+		// If we have too many drops, remove some dead/falling ones from the back.
+		const size_t excess = static_cast<size_t>(-noOfDropsToGenerate);
+		RainDrops.Truncate(RainDrops.Size() > excess ? RainDrops.Size() - excess : 0);
 	}
 }
 
-void DisplayWindow::UpdateSnowFlakes(const float deltaSeconds)
+void DisplayWindow::UpdateSnowFlakes(const SimulationStep& step, const double clockTime)
 {
-	const int noOfFlakesToGenerate = GeneralSettings.MaxParticles * SnowFlake::SNOW_FLAKE_MULTIPLIER - static_cast<int>(SnowFlakes.size());
+	const float deltaSeconds = step.TickSeconds;
+	const int maxFlakes = static_cast<int>(static_cast<float>(step.MaxParticles * SnowField::SNOW_FLAKE_MULTIPLIER) *
+	                                       step.Knobs.ParticleScale);
+	const int noOfFlakesToGenerate = maxFlakes - static_cast<int>(SnowFlakes.Size());
 
 	if (noOfFlakesToGenerate > 0)
 	{
-		for (int i = 0; i < noOfFlakesToGenerate; i++)
-		{
-			SnowFlakes.emplace_back(pDisplaySpecificData.get());
-		}
+		SnowFlakes.Reserve(SnowFlakes.Size() + static_cast<size_t>(noOfFlakesToGenerate));
+		SnowFlakes.Spawn(noOfFlakesToGenerate, pDisplaySpecificData.get());
 	}
-
-	if (noOfFlakesToGenerate < 0)
+	else if (noOfFlakesToGenerate < 0)
 	{
-		int excess = -noOfFlakesToGenerate;
-		// Remove using swap-and-pop from vector's back
-		while (excess > 0 && !SnowFlakes.empty())
-		{
-			SnowFlakes.pop_back();
-			--excess;
-		}
+		// Remove the excess from the back.
+		const size_t excess = static_cast<size_t>(-noOfFlakesToGenerate);
+		SnowFlakes.Truncate(SnowFlakes.Size() > excess ? SnowFlakes.Size() - excess : 0);
 	}
 
-
 	// Move each snowflake to the next point. The noise time is identical for every
-	// flake this frame, so compute it once here rather than per flake.
-	const float noiseTime = SnowFlake::ComputeNoiseTime(CurrentTime);
-	for (auto & flake : SnowFlakes)
-	{
-		flake.UpdatePosition(deltaSeconds, noiseTime);
-	}
+	// flake this frame, so the shared drift field is advanced once here; flakes
+	// then re-sample it on a staggered schedule.
+	SnowField::AdvanceFlowField(pDisplaySpecificData.get(), SnowField::ComputeNoiseTime(clockTime));
+	SnowFlakes.RefreshNoise(deltaSeconds, pDisplaySpecificData.get());
+	SnowFlakes.UpdatePositions(deltaSeconds, pDisplaySpecificData.get());
+	if (++UpdatesSinceSettle < step.Knobs.SettleInterval) return;
+	UpdatesSinceSettle = 0;
 	if (pDisplaySpecificData->SimpleSnowHeap)
 	{
-		SnowFlake::SmoothSnowHeap(pDisplaySpecificData.get());
+		SnowField::SmoothSnowHeap(pDisplaySpecificData.get());
 	}
 	else
 	{
-		SnowFlake::SettleSnow(pDisplaySpecificData.get());
+		SnowField::SettleSnow(pDisplaySpecificData.get());
 	}
 }
 
@@ -980,6 +1206,9 @@ HRESULT DisplayWindow::RecreateDeviceResources(const HWND hWnd)
 		pDisplaySpecificData = std::make_unique<DisplayData>(Dc.Get());
 		pDisplaySpecificData->SetRainColor(GeneralSettings.ParticleColor);
 		pDisplaySpecificData->SimpleSnowHeap = GeneralSettings.SimpleSnowHeap;
+		pDisplaySpecificData->SeedRandomStreams(GeneralSettings.RandomSeed, MonitorDat.Index);
+		// The snapshots' settled-snow row stamps refer to the old heap.
+		DiscardFrames();
 		HandleWindowBoundsChange(hWnd, true);
 		return S_OK;
 	}
@@ -991,6 +1220,8 @@ HRESULT DisplayWindow::RecreateDeviceResources(const HWND hWnd)
 
 DisplayWindow::~DisplayWindow()
 {
+	// The step in flight uses this window's state.
+	FinishSimulation();
 	// unique_ptr will clean up automatically.
 	// Destructor does not go through ReleaseDeviceResources(), so close the
 	// waitable handle here too (guarded against an already-released swap chain).
@@ -13,11 +13,17 @@
 #ifdef SHOW_FPS
 #include <dwrite.h>
 #endif
-#include "RainDrop.h"
 #include "CallBackWindow.h"
+#include "FrameSnapshot.h"
 #include "OptionDialog.h"
+#include "PowerPolicy.h"
+#include "QualityGovernor.h"
+#include "RainField.h"
 #include "SettingsManager.h"
-#include "SnowFlake.h"
+#include "SnowField.h"
+#include "TaskPool.h"
+#include "TripleBuffer.h"
+#include "VisibilityTracker.h"
 
 // https://docs.microsoft.com/en-us/archive/msdn-magazine/2014/june/windows-with-c-high-performance-window-layering-using-the-windows-composition-engine
 
@@ -31,8 +37,9 @@ struct MonitorData
 	RECT MonitorRect; // The display's rectangle dimensions
 	std::wstring Name; // The display name, if available
 	bool IsPrimaryDisplay; // True if the display is the primary one
+	uint32_t Index; // Enumeration order; selects this display's random streams
 
-	MonitorData() : MonitorRect{0, 0, 0, 0}, IsPrimaryDisplay(false)
+	MonitorData() : MonitorRect{0, 0, 0, 0}, IsPrimaryDisplay(false), Index(0)
 	{
 	}
 };
@@ -41,8 +48,26 @@ class DisplayWindow final : CallBackWindow
 {
 public:
 	HRESULT Initialize(HINSTANCE hInstance, const MonitorData& monitorData);
+	// One whole frame on the calling thread: BeginFrame, Render, then the
+	// simulation step for the next frame.
 	void Animate();
 
+	// A frame as a two-stage pipeline, so physics stays off the render thread's
+	// critical path. BeginFrame (UI thread) handles lock / device-lost state and
+	// advances the frame clock; false means skip this frame. Render (UI thread)
+	// draws and presents the newest published snapshot, interpolated to the
+	// frame clock, without waiting for the step in flight. StartSimulation then
+	// submits the physics for the next frame to the TaskPool, unless the
+	// previous step is still running or no tick is due yet (its time then
+	// carries over); a step makes no Direct2D or window calls, touches no other
+	// display's state, and ends by publishing a FrameSnapshot. FinishSimulation
+	// waits for that step: call it before anything else touches the simulation
+	// state (window messages, settings changes, teardown).
+	bool BeginFrame();
+	void Render();
+	void StartSimulation();
+	void FinishSimulation();
+
 	// CallBackWindow Overrides
 	void UpdateParticleCount(int val) override;
 	void UpdateWindDirection(int val) override;
@@ -53,15 +78,28 @@ public:
 
 	~DisplayWindow() override;
 
-	// Frame-pacing support for the single-threaded, multi-swap-chain render loop.
+	// Frame-pacing support for the multi-swap-chain render loop (one UI thread presents every monitor).
 	// The waitable object signals when this monitor's swap chain can accept a new
 	// frame (i.e. at that monitor's vsync), letting one thread drive several
 	// monitors at their own independent refresh rates.
 	HANDLE GetFrameLatencyWaitable() const { return FrameLatencyWaitable; }
 	// True only when Animate() will actually render and present this frame
-	// (not session-locked, not device-lost, and the swap chain/handle exists).
-	// The loop must not consume the waitable of a non-renderable window.
-	bool IsRenderable() const { return !IsSessionLocked && !IsDeviceLost && FrameLatencyWaitable != nullptr; }
+	// (not session-locked, not device-lost, not occluded, and the swap
+	// chain/handle exists). The loop must not consume the waitable of a
+	// non-renderable window.
+	bool IsRenderable() const
+	{
+		return !IsSessionLocked && !IsDeviceLost && Visibility.GetState() == VisibilityTracker::State::Visible &&
+			FrameLatencyWaitable != nullptr;
+	}
+	// Sample whether a fullscreen window covers this monitor (only possible
+	// with AllowHide) and suspend or resume drawing accordingly. Call every
+	// loop iteration; covered windows are then serviced by Animate().
+	void UpdateVisibility();
+
+	// Run within the power policy's limits (frame-rate cap, particle share,
+	// settle rate) from the next frame on. UI thread.
+	void ApplyPowerLimits(const PowerPolicy::Limits& limits);
 
 private:
 	ComPtr<ID3D11Device> Direct3dDevice;
@@ -71,7 +109,7 @@ private:
 	ComPtr<ID2D1Factory2> D2Factory;
 	ComPtr<ID2D1Device1> D2Device;
 	ComPtr<ID2D1DeviceContext> Dc;
-	ComPtr<ID2D1DeviceContext3> Dc3; // QI of Dc; used for batched snow sprites
+	ComPtr<ID2D1DeviceContext3> Dc3; // QI of Dc; batched snow sprites (D2DRenderBackend) need it
 	ComPtr<IDXGISurface2> Surface;
 	ComPtr<ID2D1Bitmap1> Bitmap;
 	ComPtr<IDCompositionDevice> DcompDevice;
@@ -85,18 +123,78 @@ private:
 	static HINSTANCE AppInstance;
 	static OptionsDialog* pOptionsDlg;
 
-	// Store raindrops by value to improve memory locality and avoid heap fragmentation
-	std::vector<RainDrop> RainDrops;
-	// Store snowflakes by value as well for locality and to enable pre-allocation
-	std::vector<SnowFlake> SnowFlakes;
+	// Raindrops as a structure of arrays (plus one shared splatter pool), so the
+	// per-frame update streams over contiguous columns
+	RainField RainDrops;
+	// Snowflakes likewise: columns the update streams over and the sprite list
+	// is written from
+	SnowField SnowFlakes;
 
 	// For animation. CurrentTime is the previous frame's timestamp (seconds);
-	// -1 means "not yet seeded" (start or post-device-loss).
+	// -1 means "not yet seeded" (start or post-device-loss). FrameClock is the
+	// animation time of the frame being drawn (elapsed frame times, clamped)
+	// and SimulatedClock how far the physics has been stepped on that clock;
+	// LastFrameSeconds is the latest frame time, the guess for the next one.
 	double CurrentTime = -1.0;
+	double FrameClock = 0.0;
+	double SimulatedClock = 0.0;
+	float LastFrameSeconds = 1.0f / 60.0f;
+	// Longest single physics step (s), so a stall or a device-lost recovery
+	// can't produce a huge integration jump. ↑ keeps real-time pace through
+	// longer hitches, at the cost of bigger jumps; ↓ smoother, slows down instead.
+	static constexpr float MAX_STEP_SECONDS = 0.05f;
+	// Most fixed ticks one step may run; past it the simulation falls behind
+	// instead of spiralling. ↑ keeps real-time pace on slower machines; ↓
+	// bounds the cost of a step that follows a hitch.
+	static constexpr int MAX_TICKS_PER_STEP = 4;
+
+	// What one step simulates: Ticks updates of TickSeconds each, ending at
+	// EndTime on the frame clock. ClockTime is the timestamp at the end
+	// (drives the snow noise). Interpolated is false for a variable step.
+	// Knobs is the detail level to simulate at.
+	struct SimulationStep
+	{
+		int Ticks;
+		float TickSeconds;
+		double EndTime;
+		double ClockTime;
+		bool Interpolated;
+		QualityGovernor::Knobs Knobs;
+		// The settings the step runs with, copied on the UI thread: settings
+		// callbacks write GeneralSettings while a step may be running.
+		int MaxParticles;
+		int WindSpeed;
+		ParticleType PartType;
+		bool ParallelUpdate;
+	};
+
+	// Sheds detail while this display misses its frame budget (UI thread; the
+	// knobs reach the simulation with each step). Fed by Render when
+	// Setting::AdaptiveQuality is on, otherwise it stays at full detail.
+	QualityGovernor Quality;
+	// Time the last frame took from Render's start up to Present.
+	float LastDrawSeconds = 0.0f;
+	// Current power limits, and the Present sync interval (vblanks per frame)
+	// that keeps this monitor under their frame-rate cap.
+	PowerPolicy::Limits PowerLimits = PowerPolicy::FULL;
+	UINT SyncInterval = 1;
+	// Longest sync interval DXGI accepts.
+	static constexpr UINT MAX_SYNC_INTERVAL = 4;
+	// Updates since the settled snow last settled (simulation side).
+	int UpdatesSinceSettle = 0;
+
+	// The step in flight (at most one) and the snapshots it hands to Render:
+	// the simulation side fills Frames.Back(), Render draws Frames.Front().
+	TaskPool::Group SimulationGroup;
+	TripleBuffer<FrameSnapshot> Frames;
+	// Render's interpolated copy of the front snapshot (UI thread only).
+	FrameGeometry Geometry;
 
 	// Session / device state
 	bool IsSessionLocked = false;
 	bool IsDeviceLost = false;
+	// Covered by a fullscreen window: nothing drawn, keep-alive steps or paused.
+	VisibilityTracker Visibility;
 
 #ifdef SHOW_FPS
 	ComPtr<IDWriteFactory> DWriteFactory;
@@ -125,7 +223,10 @@ private:
 	HRESULT RecreateDeviceResources(HWND hWnd);
 
 	void HandleWindowBoundsChange(HWND window, bool clearDrops);
-	void HandleTaskBarChange() const;
+	void HandleTaskBarChange();
+	// Pace frames by this monitor's current refresh rate and the power limits:
+	// sets SyncInterval and the QualityGovernor's budget.
+	void UpdateFramePeriod();
 	void FindSceneRect2(RECT& sceneRect, float& scaleFactor) const;
 	void FindSceneRect(RECT& sceneRect, float& scaleFactor) const;
 
@@ -134,10 +235,34 @@ private:
 	static void ShowContextMenu(HWND hWnd);
 
 	static double GetCurrentTimeInSeconds();
-	void UpdateRainDrops(float deltaSeconds);
-	void UpdateSnowFlakes(float deltaSeconds);
-	void DrawRainDrops();
-	void DrawSnowFlakes();
+	// The time not yet simulated as the next step: with a SimulationRate, the
+	// fixed ticks due by the end of the next frame (at most MAX_TICKS_PER_STEP);
+	// otherwise one variable step up to FrameClock (at most MAX_STEP_SECONDS).
+	// False if no tick is due yet.
+	bool TakeSimulationStep(SimulationStep& step);
+	// The detail to simulate at: the QualityGovernor's, within the power limits.
+	QualityGovernor::Knobs CurrentKnobs() const;
+	// Fill the step's Knobs and settings (UI thread).
+	void CopyStepSettings(SimulationStep& step) const;
+	// Run `step` on the TaskPool (inline if it has no threads).
+	void SubmitStep(const SimulationStep& step);
+	// Run the step's ticks, then capture and publish its FrameSnapshot.
+	void Simulate(const SimulationStep& step);
+	// While occluded: one short, undrawn step, so the hidden scene keeps
+	// going at a fraction of its pace.
+	void KeepAlive();
+	// A fullscreen window other than ours is in front and covers this monitor.
+	bool IsCoveredByForegroundWindow() const;
+	// Finish the step in flight, blank every snapshot and reset the
+	// QualityGovernor, after the simulation state was reset or replaced
+	// (bounds, particle type, heap mode, device).
+	void DiscardFrames();
+	// One tick of `step` (TickSeconds long).
+	void UpdateRainDrops(const SimulationStep& step);
+	void UpdateSnowFlakes(const SimulationStep& step, double clockTime);
+	// drawStart: Render's start, for LastDrawSeconds.
+	void DrawRainDrops(const FrameGeometry& geometry, double drawStart);
+	void DrawSnowFlakes(const FrameGeometry& geometry, const FrameSnapshot& frame, double drawStart);
 
 	static void SetInstanceToHwnd(HWND hWnd, LPARAM lParam);
 	static DisplayWindow* GetInstanceFromHwnd(HWND hWnd);
@@ -0,0 +1,118 @@
+#include "FlowField.h"
+
+#include <algorithm>
+#include <cmath>
+
+void FlowField::Configure(const float left, const float top, const float right, const float bottom, const float cellSize,
+                          const float keyframeInterval)
+{
+	if (!Empty() && left == Left && top == Top && right == Right && bottom == Bottom && cellSize == CellSize &&
+		keyframeInterval == KeyInterval)
+	{
+		return;
+	}
+
+	Left = left;
+	Top = top;
+	Right = (std::max)(right, left);
+	Bottom = (std::max)(bottom, top);
+	CellSize = cellSize;
+	InvCellSize = 1.0f / cellSize;
+	KeyInterval = keyframeInterval;
+	Columns = static_cast<int>(std::ceil((Right - Left) * InvCellSize)) + 1;
+	Rows = static_cast<int>(std::ceil((Bottom - Top) * InvCellSize)) + 1;
+
+	// Emptied keys make the next Advance rebuild at its time.
+	Keys[0].clear();
+	Keys[1].clear();
+	Pending.clear();
+}
+
+void FlowField::Advance(const NoiseKernel::Params& noise, const float noiseTime)
+{
+	if (Columns <= 0 || Rows <= 0) return;
+
+	if (Empty() || noiseTime < KeyTime || noiseTime >= KeyTime + 2.0f * KeyInterval)
+	{
+		Rebuild(noise, noiseTime);
+		return;
+	}
+
+	const size_t nodes = Pending.size();
+	if (noiseTime >= KeyTime + KeyInterval)
+	{
+		// Passed the second key: finish the pending one and step forward.
+		SampleNodes(noise, KeyTime + 2.0f * KeyInterval, Pending, PendingDone, nodes);
+		Keys[Current].swap(Pending);
+		Current ^= 1;
+		KeyTime += KeyInterval;
+		PendingDone = 0;
+	}
+
+	// Keep the pending key as far along as the time is between the current two,
+	// so it is complete by the time it is needed.
+	Blend = (noiseTime - KeyTime) / KeyInterval;
+	const size_t due = (std::min)(nodes, static_cast<size_t>(std::ceil(Blend * static_cast<float>(nodes))));
+	if (due > PendingDone)
+	{
+		SampleNodes(noise, KeyTime + 2.0f * KeyInterval, Pending, PendingDone, due);
+		PendingDone = due;
+	}
+}
+
+float FlowField::Sample(const float x, const float y) const
+{
+	const float gx = (std::min)((std::max)((x - Left) * InvCellSize, 0.0f), static_cast<float>(Columns - 1));
+	const float gy = (std::min)((std::max)((y - Top) * InvCellSize, 0.0f), static_cast<float>(Rows - 1));
+	const int x0 = (std::min)(static_cast<int>(gx), (std::max)(Columns - 2, 0));
+	const int y0 = (std::min)(static_cast<int>(gy), (std::max)(Rows - 2, 0));
+	const int x1 = (std::min)(x0 + 1, Columns - 1);
+	const int y1 = (std::min)(y0 + 1, Rows - 1);
+	const float fx = gx - static_cast<float>(x0);
+	const float fy = gy - static_cast<float>(y0);
+
+	const auto bilinear = [&](const std::vector<float>& key)
+	{
+		const float* row0 = key.data() + static_cast<size_t>(y0) * Columns;
+		const float* row1 = key.data() + static_cast<size_t>(y1) * Columns;
+		const float top = row0[x0] + (row0[x1] - row0[x0]) * fx;
+		const float bottom = row1[x0] + (row1[x1] - row1[x0]) * fx;
+		return top + (bottom - top) * fy;
+	};
+	const float a = bilinear(Keys[Current]);
+	const float b = bilinear(Keys[Current ^ 1]);
+	return a + (b - a) * Blend;
+}
+
+void FlowField::SampleNodes(const NoiseKernel::Params& noise, const float time, std::vector<float>& key,
+                            const size_t first, const size_t last)
+{
+	if (last <= first) return;
+
+	const size_t count = last - first;
+	NodeX.resize(count);
+	NodeY.resize(count);
+	NodeTime.assign(count, time);
+	for (size_t i = first; i < last; ++i)
+	{
+		const int column = static_cast<int>(i % static_cast<size_t>(Columns));
+		const int row = static_cast<int>(i / static_cast<size_t>(Columns));
+		NodeX[i - first] = Left + column * CellSize;
+		NodeY[i - first] = Top + row * CellSize;
+	}
+	NoiseKernel::Evaluate(noise, NodeX.data(), NodeY.data(), NodeTime.data(), count, key.data() + first);
+}
+
+void FlowField::Rebuild(const NoiseKernel::Params& noise, const float noiseTime)
+{
+	const size_t nodes = static_cast<size_t>(Columns) * Rows;
+	Keys[0].resize(nodes);
+	Keys[1].resize(nodes);
+	Pending.resize(nodes);
+	Current = 0;
+	KeyTime = noiseTime;
+	Blend = 0.0f;
+	PendingDone = 0;
+	SampleNodes(noise, KeyTime, Keys[0], 0, nodes);
+	SampleNodes(noise, KeyTime + KeyInterval, Keys[1], 0, nodes);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "NoiseKernel.h"
+
+// FlowField Class
+// Coarse, time-keyframed copy of a 3D noise field over a rectangle of the
+// scene, so per-particle lookups are a bilinear blend instead of a full noise
+// evaluation. Nodes sit every CellSize px. Two finished keyframes bracket the
+// current noise time and are blended linearly; the keyframe after them is
+// sampled a slice per Advance, so the noise cost is spread evenly over frames.
+class FlowField
+{
+public:
+	// Cover [left, right] x [top, bottom] (px) with nodes every cellSize px, one
+	// keyframe per keyframeInterval of noise time. Keeps the field when nothing
+	// changed; otherwise it is rebuilt on the next Advance.
+	void Configure(float left, float top, float right, float bottom, float cellSize, float keyframeInterval);
+	// Move to noise time `noiseTime`, sampling `noise` for whichever nodes of the
+	// upcoming keyframe are now due (one batched NoiseKernel call). A jump
+	// backwards or past the upcoming keyframe rebuilds the field at `noiseTime`.
+	void Advance(const NoiseKernel::Params& noise, float noiseTime);
+
+	// Noise value at (x, y) for the last Advance time (call Advance first).
+	// Points outside the rectangle read its nearest edge.
+	float Sample(float x, float y) const;
+
+	bool Empty() const { return Keys[0].empty(); }
+
+private:
+	// Keys[Current] and Keys[Current ^ 1] bracket the noise time; Pending is the
+	// keyframe being filled.
+	std::vector<float> Keys[2];
+	std::vector<float> Pending;
+	int Current = 0;
+
+	float Left = 0.0f;
+	float Top = 0.0f;
+	float Right = 0.0f;
+	float Bottom = 0.0f;
+	float CellSize = 0.0f;
+	float InvCellSize = 0.0f;
+	float KeyInterval = 0.0f;
+	int Columns = 0; // nodes per row
+	int Rows = 0;
+
+	float KeyTime = 0.0f;   // noise time of Keys[Current]
+	float Blend = 0.0f;     // 0-1 position of the last Advance between the two keys
+	size_t PendingDone = 0; // nodes of Pending already sampled
+
+	// Node coordinates of the slice being sampled, for the batch call.
+	std::vector<float> NodeX;
+	std::vector<float> NodeY;
+	std::vector<float> NodeTime;
+
+	// Sample nodes [first, last) of the keyframe at `time` into `key`.
+	void SampleNodes(const NoiseKernel::Params& noise, float time, std::vector<float>& key, size_t first, size_t last);
+	// Build both bracketing keys from scratch with the first at `noiseTime`.
+	void Rebuild(const NoiseKernel::Params& noise, float noiseTime);
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include "SnowField.h"
+#include "Vector2.h"
+
+// FrameGeometry Class
+// What the renderers draw for one frame of a display: drop trails, splatters
+// and flake sprites, at the moment being shown and already clipped to the
+// scene. Filled from a FrameSnapshot (FrameSnapshot::Interpolate) on the render
+// thread; buffers are refilled in place and keep their capacity.
+class FrameGeometry
+{
+public:
+	// A drop trail, already trimmed to the scene rectangle.
+	struct Trail
+	{
+		Vector2 Start;
+		Vector2 End;
+		float Width;
+	};
+	// A live splatter inside the scene, with its opacity.
+	struct Splat
+	{
+		Vector2 Pos;
+		float Radius;
+		float Alpha;
+	};
+
+	std::vector<Trail> Trails;
+	std::vector<Splat> Splatters;
+	SnowField::SpriteList Flakes;
+};
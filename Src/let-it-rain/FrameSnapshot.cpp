@@ -0,0 +1,156 @@
+#include "FrameSnapshot.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "MathUtil.h"
+
+void FrameSnapshot::CaptureRain(const RainField& drops, const SimulationData* pSimData)
+{
+	SceneRect = pSimData->SceneRect;
+	const bool interpolated = IsInterpolated();
+
+	Drops.clear();
+	const size_t count = drops.Size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Vector2 to = drops.GetPosition(i);
+		const Vector2 tail = drops.GetTrailStart(i);
+		const Vector2 tailOffset(tail.x - to.x, tail.y - to.y);
+		const Vector2 from = interpolated ? drops.GetPreviousPosition(i) : to;
+
+		// Drawn when an end of the trail is inside; keep the drop if that holds
+		// at either tick (Interpolate decides for the moment actually drawn).
+		const bool toShows = MathUtil::IsPointInRect(SceneRect, to) || MathUtil::IsPointInRect(SceneRect, tail);
+		const bool fromShows = interpolated &&
+			(MathUtil::IsPointInRect(SceneRect, from) ||
+			 MathUtil::IsPointInRect(SceneRect, Vector2(from.x + tailOffset.x, from.y + tailOffset.y)));
+		if (toShows || fromShows)
+		{
+			Drops.push_back({ from, to, tailOffset, drops.GetRadius(i) });
+		}
+	}
+
+	Splats.clear();
+	const SplatterPool& splatters = pSimData->Splatters;
+	const double now = splatters.GetClock();
+	for (size_t i = 0; i < splatters.Size(); ++i)
+	{
+		const Splatter& splatter = splatters[i];
+		if (splatter.IsExpired(now)) continue;
+
+		const Vector2 to = splatter.GetPos();
+		const Vector2 from = interpolated ? splatter.GetPrevPos() : to;
+		if (!MathUtil::IsPointInRect(SceneRect, to) && !MathUtil::IsPointInRect(SceneRect, from)) continue;
+
+		Splats.push_back({ from, to, splatter.GetRadius(), splatter.GetAlpha(now) });
+	}
+}
+
+void FrameSnapshot::CaptureSnow(const SnowField& flakes, const SimulationData* pSimData, const float halfSizePerRadius)
+{
+	if (IsInterpolated())
+	{
+		flakes.BuildSprites(pSimData->SceneRectNorm, static_cast<float>(pSimData->SceneRect.left),
+		                    static_cast<float>(pSimData->SceneRect.top), halfSizePerRadius, FlakesTo, &FlakesFrom);
+	}
+	else
+	{
+		flakes.BuildSprites(pSimData->SceneRectNorm, static_cast<float>(pSimData->SceneRect.left),
+		                    static_cast<float>(pSimData->SceneRect.top), halfSizePerRadius, FlakesTo);
+		ClearSprites(FlakesFrom);
+	}
+
+	if (pSimData->SimpleSnowHeap)
+	{
+		ColumnHeights = pSimData->ColumnHeights;
+	}
+	else
+	{
+		ColumnHeights.clear();
+		SettledSnow.CopyChangedRows(pSimData->ScenePixels);
+	}
+}
+
+void FrameSnapshot::Clear()
+{
+	EndTime = 0.0;
+	TickSeconds = 0.0f;
+	SimulateSeconds = 0.0f;
+	Drops.clear();
+	Splats.clear();
+	ClearSprites(FlakesFrom);
+	ClearSprites(FlakesTo);
+	ColumnHeights.clear();
+	SettledSnow.Release();
+}
+
+float FrameSnapshot::InterpolationFactor(const double frameClock) const
+{
+	if (!IsInterpolated()) return 1.0f;
+	return std::clamp(static_cast<float>((frameClock - EndTime) / TickSeconds), 0.0f, 1.0f);
+}
+
+void FrameSnapshot::Interpolate(const float alpha, FrameGeometry& geometry) const
+{
+	geometry.Trails.clear();
+	for (const DropState& drop : Drops)
+	{
+		const Vector2 pos = MathUtil::Lerp(drop.From, drop.To, alpha);
+		const Vector2 tail(pos.x + drop.TailOffset.x, pos.y + drop.TailOffset.y);
+
+		const bool posInside = MathUtil::IsPointInRect(SceneRect, pos);
+		const bool tailInside = MathUtil::IsPointInRect(SceneRect, tail);
+		if (posInside && tailInside)
+		{
+			geometry.Trails.push_back({ tail, pos, drop.Width });
+		}
+		else if (posInside || tailInside)
+		{
+			Vector2 startPoint, endPoint;
+			MathUtil::TrimLineSegment(SceneRect, tail, pos, startPoint, endPoint);
+			geometry.Trails.push_back({ startPoint, endPoint, drop.Width });
+		}
+	}
+
+	geometry.Splatters.clear();
+	for (const SplatState& splat : Splats)
+	{
+		const Vector2 pos = MathUtil::Lerp(splat.From, splat.To, alpha);
+		if (!MathUtil::IsPointInRect(SceneRect, pos)) continue;
+
+		geometry.Splatters.push_back({ pos, splat.Radius, splat.Alpha });
+	}
+
+	// Sprites are blended elementwise, matrices included: a tick turns a flake
+	// by a few degrees at most, so the blended matrix stays a rotation to the eye.
+	SnowField::SpriteList& flakes = geometry.Flakes;
+	flakes = FlakesTo;
+	if (FlakesFrom.Size() != FlakesTo.Size() || alpha >= 1.0f) return;
+
+	for (size_t k = 0; k < flakes.Size(); ++k)
+	{
+		const SnowField::SpriteRect& fromRect = FlakesFrom.Dests[k];
+		SnowField::SpriteRect& rect = flakes.Dests[k];
+		rect.Left = MathUtil::Lerp(fromRect.Left, rect.Left, alpha);
+		rect.Top = MathUtil::Lerp(fromRect.Top, rect.Top, alpha);
+		rect.Right = MathUtil::Lerp(fromRect.Right, rect.Right, alpha);
+		rect.Bottom = MathUtil::Lerp(fromRect.Bottom, rect.Bottom, alpha);
+
+		const SnowField::SpriteTransform& fromTransform = FlakesFrom.Transforms[k];
+		SnowField::SpriteTransform& transform = flakes.Transforms[k];
+		transform.M11 = MathUtil::Lerp(fromTransform.M11, transform.M11, alpha);
+		transform.M12 = MathUtil::Lerp(fromTransform.M12, transform.M12, alpha);
+		transform.M21 = MathUtil::Lerp(fromTransform.M21, transform.M21, alpha);
+		transform.M22 = MathUtil::Lerp(fromTransform.M22, transform.M22, alpha);
+		transform.Dx = MathUtil::Lerp(fromTransform.Dx, transform.Dx, alpha);
+		transform.Dy = MathUtil::Lerp(fromTransform.Dy, transform.Dy, alpha);
+	}
+}
+
+void FrameSnapshot::ClearSprites(SnowField::SpriteList& sprites)
+{
+	sprites.Dests.clear();
+	sprites.Transforms.clear();
+	std::fill(std::begin(sprites.ShapeBegin), std::end(sprites.ShapeBegin), size_t{ 0 });
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+
+#include "FrameGeometry.h"
+#include "RainField.h"
+#include "SimulationData.h"
+#include "SnowField.h"
+#include "SnowGrid.h"
+#include "Vector2.h"
+
+// FrameSnapshot Class
+// Everything the renderers need to draw one frame of a display, copied out of
+// the simulation once it has stepped: the simulation thread captures into a
+// snapshot and hands it over (see TripleBuffer), then moves on to the next
+// step while the render thread draws this one. Buffers are refilled in place
+// and keep their capacity.
+//
+// With a fixed simulation tick the snapshot holds moving things both as they
+// were before the last tick and after it, and the render thread draws them in
+// between (Interpolate), so a display refreshing faster than the tick still
+// moves smoothly. Only what is (or was) inside the scene is captured.
+class FrameSnapshot
+{
+public:
+	// Simulation time after the last tick, and that tick's length. Set before
+	// capturing; TickSeconds == 0 captures without the previous state (nothing
+	// to interpolate, every frame is a variable step of its own).
+	double EndTime = 0.0;
+	float TickSeconds = 0.0f;
+	// Wall time the step behind this snapshot took (for the QualityGovernor).
+	float SimulateSeconds = 0.0f;
+
+	// Rain: every drop trail and live splatter that may show.
+	void CaptureRain(const RainField& drops, const SimulationData* pSimData);
+	// Snow: the flake sprites (see SnowField::BuildSprites; halfSizePerRadius is
+	// the renderer's on-screen scale) and the settled heap of the active mode.
+	void CaptureSnow(const SnowField& flakes, const SimulationData* pSimData, float halfSizePerRadius);
+	// Draw nothing until the next capture.
+	void Clear();
+
+	// Where between the previous and the last tick to draw at `frameClock`
+	// (same clock as EndTime): 0 → previous, 1 → last. Frames show the state
+	// one tick behind the clock, so a snapshot published ahead of time blends
+	// in rather than jumping. 1 when not interpolated.
+	float InterpolationFactor(double frameClock) const;
+	// Fill `geometry` with the moving things at `alpha` between the previous
+	// and the last tick, clipped to the scene. The settled heap is not
+	// interpolated; draw it from the snapshot.
+	void Interpolate(float alpha, FrameGeometry& geometry) const;
+
+	// Copy of SimulationData::ColumnHeights (simple heap mode), or empty.
+	std::vector<float> ColumnHeights;
+	// Copy of SimulationData::ScenePixels (per-pixel mode), or empty. Rows are
+	// copied only when their stamp moved, and keep the source's stamps.
+	SnowGrid SettledSnow;
+
+private:
+	// A drop head before and after the last tick; the trail runs from
+	// head + TailOffset to the head.
+	struct DropState
+	{
+		Vector2 From;
+		Vector2 To;
+		Vector2 TailOffset;
+		float Width;
+	};
+	struct SplatState
+	{
+		Vector2 From;
+		Vector2 To;
+		float Radius;
+		float Alpha;
+	};
+
+	RECT SceneRect = {};
+	std::vector<DropState> Drops;
+	std::vector<SplatState> Splats;
+	// Same flakes in the same slots; FlakesFrom is empty when not interpolated.
+	SnowField::SpriteList FlakesFrom;
+	SnowField::SpriteList FlakesTo;
+
+	bool IsInterpolated() const { return TickSeconds > 0.0f; }
+	static void ClearSprites(SnowField::SpriteList& sprites);
+};
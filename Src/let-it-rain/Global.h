@@ -12,6 +12,7 @@ inline BOOL CALLBACK MonitorEnumProc(const HMONITOR hMonitor, HDC hdcMonitor, LP
 		monitorData.MonitorRect = monitorInfo.rcMonitor;
 		monitorData.Name = monitorInfo.szDevice;
 		monitorData.IsPrimaryDisplay = (monitorInfo.dwFlags & MONITORINFOF_PRIMARY) != 0;
+		monitorData.Index = static_cast<uint32_t>(monitorDataList->size());
 		
 		monitorDataList->push_back(monitorData);
 	}
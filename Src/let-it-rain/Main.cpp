@@ -1,5 +1,7 @@
 #include "DisplayWindow.h"
 #include "Global.h"
+#include "PowerPolicy.h"
+#include "WindowsPowerSource.h"
 
 
 //
@@ -35,10 +37,16 @@ int WINAPI WinMain(
 
 		if (!rainWindows.empty())
 		{
-			// Single-threaded render loop driving one waitable swap chain per
-			// monitor. Each monitor's frame-latency waitable signals at its own
-			// vsync, so monitors with different refresh rates are paced
-			// independently without one blocking Present stalling the others.
+			// Render loop driving one waitable swap chain per monitor from this
+			// (UI) thread, with each monitor's physics pipelined on the TaskPool.
+			// Each monitor's frame-latency waitable signals at its own vsync, so
+			// monitors with different refresh rates are paced independently
+			// without one blocking Present stalling the others.
+			// One power policy for every monitor, polled from the loop; the
+			// wait's timeout keeps it polled while everything is idle.
+			WindowsPowerSource powerSource;
+			PowerPolicy powerPolicy(powerSource);
+
 			bool running = true;
 			while (running)
 			{
@@ -46,10 +54,13 @@ int WINAPI WinMain(
 				// renderable. Locked / device-lost windows are serviced below and
 				// must NOT have their waitable consumed without a matching Present
 				// (doing so can leave the handle un-signaled and stall the window).
+				// Occlusion is sampled first, so a covered window is neither
+				// waited on nor drawn.
 				HANDLE waitHandles[MAXIMUM_WAIT_OBJECTS];
 				DWORD waitCount = 0;
 				for (DisplayWindow* rainWindow : rainWindows)
 				{
+					rainWindow->UpdateVisibility();
 					if (rainWindow->IsRenderable() && waitCount < MAXIMUM_WAIT_OBJECTS - 1)
 					{
 						waitHandles[waitCount++] = rainWindow->GetFrameLatencyWaitable();
@@ -63,7 +74,15 @@ int WINAPI WinMain(
 				const DWORD waitResult = MsgWaitForMultipleObjectsEx(
 					waitCount, waitHandles, 100, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
 
-				// Drain all pending window messages first.
+				// Drain all pending window messages first. Window procedures and
+				// settings callbacks change simulation state, so the steps in
+				// flight are finished before anything is dispatched. Always: a
+				// message may arrive after any check of the queue, and
+				// PeekMessage also runs sent messages.
+				for (DisplayWindow* rainWindow : rainWindows)
+				{
+					rainWindow->FinishSimulation();
+				}
 				MSG msg;
 				while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
 				{
@@ -77,6 +96,15 @@ int WINAPI WinMain(
 				}
 				if (!running) break;
 
+				// Power or load changed: every monitor adopts the new limits.
+				if (powerPolicy.Update(static_cast<double>(GetTickCount64()) / 1000.0))
+				{
+					for (DisplayWindow* rainWindow : rainWindows)
+					{
+						rainWindow->ApplyPowerLimits(powerPolicy.GetLimits());
+					}
+				}
+
 				// MsgWaitForMultipleObjectsEx auto-resets only the single handle it
 				// reports; remember it so that window still renders even though a
 				// later poll of the same handle would now read as not-signaled.
@@ -87,12 +115,18 @@ int WINAPI WinMain(
 				}
 				const bool timedOut = (waitResult == WAIT_TIMEOUT);
 
+				// Every monitor that is ready for a frame draws the newest finished
+				// step right away, then starts the physics for its next frame on
+				// the TaskPool (unless the last step is still running). A slow step
+				// thus delays only what is drawn, never the frame itself, and the
+				// monitors simulate in parallel with each other and the drawing.
 				for (DisplayWindow* rainWindow : rainWindows)
 				{
 					if (!rainWindow->IsRenderable())
 					{
 						// Device-lost windows recover inside Animate(); locked
-						// windows early-return cheaply. Waitable left untouched.
+						// windows early-return cheaply; occluded ones take their
+						// keep-alive step now and then. Waitable left untouched.
 						rainWindow->Animate();
 						continue;
 					}
@@ -101,10 +135,11 @@ int WINAPI WinMain(
 					// safety timeout, render unconditionally to re-arm the waitable
 					// and guarantee progress.
 					const HANDLE h = rainWindow->GetFrameLatencyWaitable();
-					if (timedOut || h == signaledHandle ||
-						WaitForSingleObject(h, 0) == WAIT_OBJECT_0)
+					if ((timedOut || h == signaledHandle ||
+						WaitForSingleObject(h, 0) == WAIT_OBJECT_0) && rainWindow->BeginFrame())
 					{
-						rainWindow->Animate();
+						rainWindow->Render();
+						rainWindow->StartSimulation();
 					}
 				}
 			}
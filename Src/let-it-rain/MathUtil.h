@@ -1,7 +1,9 @@
 #pragma once
-#include "windef.h"
-#include <d2d1.h>
 #include <algorithm>
+#include <cmath>
+
+#include "SimTypes.h"
+#include "Vector2.h"
 
 class MathUtil
 {
@@ -13,58 +15,32 @@ public:
 		return (point.x >= rect.left && point.x <= rect.right && point.y >= rect.top && point.y <= rect.bottom);
 	}
 
-	// Helper function to calculate intersection
-	static bool LineIntersect(const D2D1_POINT_2F& p1, const D2D1_POINT_2F& p2, const D2D1_POINT_2F& q1,
-	                          const D2D1_POINT_2F& q2, D2D1_POINT_2F& intersection)
+	static void TrimLineSegment(const RECT& boundRect, const Vector2& lineStart, const Vector2& lineEnd,
+	                            Vector2& lineTrimmedStart, Vector2& lineTrimmedEnd)
 	{
-		const float A1 = p2.y - p1.y;
-		const float B1 = p1.x - p2.x;
-		const float C1 = A1 * p1.x + B1 * p1.y;
-
-		const float A2 = q2.y - q1.y;
-		const float B2 = q1.x - q2.x;
-		const float C2 = A2 * q1.x + B2 * q1.y;
-
-		const float det = A1 * B2 - A2 * B1;
-		if (det == 0) return false; // Parallel lines
-
-		intersection.x = (B2 * C1 - B1 * C2) / det;
-		intersection.y = (A1 * C2 - A2 * C1) / det;
-
-		return (intersection.x >= (std::min)(p1.x, p2.x) && intersection.x <= (std::max)(p1.x, p2.x) &&
-			intersection.y >= (std::min)(p1.y, p2.y) && intersection.y <= (std::max)(p1.y, p2.y));
-	}
-
-	static void TrimLineSegment(const RECT& boundRect, const D2D1_POINT_2F& lineStart, const D2D1_POINT_2F& lineEnd,
-	                            D2D1_POINT_2F& lineTrimmedStart, D2D1_POINT_2F& lineTrimmedEnd)
-	{
-		const D2D1_POINT_2F rectPoints[4] = {
-			{static_cast<float>(boundRect.left), static_cast<float>(boundRect.top)},
-			{static_cast<float>(boundRect.right), static_cast<float>(boundRect.top)},
-			{static_cast<float>(boundRect.right), static_cast<float>(boundRect.bottom)},
-			{static_cast<float>(boundRect.left), static_cast<float>(boundRect.bottom)}
+		// Narrow the segment's parameter range [0, 1] by each edge in turn
+		// (Liang-Barsky), so a segment passing outside a corner is cut where it
+		// really enters the rect rather than where it crosses an edge's extension.
+		const float dx = lineEnd.x - lineStart.x;
+		const float dy = lineEnd.y - lineStart.y;
+		const float p[4] = { -dx, dx, -dy, dy };
+		const float q[4] = {
+			lineStart.x - static_cast<float>(boundRect.left), static_cast<float>(boundRect.right) - lineStart.x,
+			lineStart.y - static_cast<float>(boundRect.top), static_cast<float>(boundRect.bottom) - lineStart.y
 		};
-
-		lineTrimmedStart = lineStart;
-		lineTrimmedEnd = lineEnd;
-
+		float t0 = 0.0f;
+		float t1 = 1.0f;
 		for (int i = 0; i < 4; ++i)
 		{
-			const int next = (i + 1) % 4;
-			D2D1_POINT_2F intersection;
-			if (LineIntersect(lineStart, lineEnd, rectPoints[i], rectPoints[next], intersection))
-			{
-				if (!(lineTrimmedStart.x >= boundRect.left && lineTrimmedStart.x <= boundRect.right &&
-					lineTrimmedStart.y >= boundRect.top && lineTrimmedStart.y <= boundRect.bottom))
-				{
-					lineTrimmedStart = intersection;
-				}
-				else
-				{
-					lineTrimmedEnd = intersection;
-				}
-			}
+			if (p[i] == 0.0f) continue; // Parallel to this edge
+			const float t = q[i] / p[i];
+			if (p[i] < 0.0f) t0 = (std::max)(t0, t);
+			else t1 = (std::min)(t1, t);
 		}
+		if (t0 > t1) t1 = t0; // Misses the rect: collapses onto the clamped point below
+
+		lineTrimmedStart = t0 > 0.0f ? Vector2(lineStart.x + dx * t0, lineStart.y + dy * t0) : lineStart;
+		lineTrimmedEnd = t1 < 1.0f ? Vector2(lineStart.x + dx * t1, lineStart.y + dy * t1) : lineEnd;
 
 		// Clamp to rect bounds
 		lineTrimmedStart.x = std::clamp(lineTrimmedStart.x, static_cast<float>(boundRect.left),
@@ -140,6 +116,17 @@ public:
 		return firstPoint;
 	}
 
+	// Linear blend: a at t == 0, b at t == 1.
+	static float Lerp(const float a, const float b, const float t)
+	{
+		return a + (b - a) * t;
+	}
+
+	static Vector2 Lerp(const Vector2& a, const Vector2& b, const float t)
+	{
+		return Vector2(Lerp(a.x, b.x, t), Lerp(a.y, b.y, t));
+	}
+
 	static bool IsSame(const RECT& l, const RECT& r)
 	{
 		return l.left == r.left && l.top == r.top &&
@@ -0,0 +1,669 @@
+#include "NoiseKernel.h"
+#include "FastNoiseLite.h"
+
+#if defined(LIR_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	// Every implementation fills out[0, count) and may leave a tail to EvaluateTail.
+	using BatchFn = void (*)(const FastNoiseLite& reference, int seed, float frequency, const float* x,
+	                         const float* y, const float* z, size_t count, float* out);
+
+	void EvaluateTail(const FastNoiseLite& reference, const float* x, const float* y, const float* z,
+	                  const size_t begin, const size_t count, float* out)
+	{
+		for (size_t n = begin; n < count; ++n)
+		{
+			out[n] = reference.GetNoise(x[n], y[n], z[n]);
+		}
+	}
+
+	void EvaluateScalar(const FastNoiseLite& reference, int, float, const float* x, const float* y, const float* z,
+	                    const size_t count, float* out)
+	{
+		EvaluateTail(reference, x, y, z, 0, count, out);
+	}
+
+#if defined(LIR_ARCH_X86)
+	// FastNoiseLite's private hashing and lattice constants.
+	constexpr int PRIME_X = 501125321;
+	constexpr int PRIME_Y = 1136930381;
+	constexpr int PRIME_Z = 1720413743;
+	// Twice each prime, wrapped to int as FastNoiseLite's (prime << 1) is.
+	constexpr int PRIME_X2 = static_cast<int>(static_cast<unsigned>(PRIME_X) << 1);
+	constexpr int PRIME_Y2 = static_cast<int>(static_cast<unsigned>(PRIME_Y) << 1);
+	constexpr int PRIME_Z2 = static_cast<int>(static_cast<unsigned>(PRIME_Z) << 1);
+	constexpr int HASH_MULTIPLIER = 0x27d4eb2d;
+	constexpr int GRADIENT_INDEX_MASK = 63 << 2;
+	constexpr int OPEN_SIMPLEX2S_SEED_OFFSET = 1293373;
+	constexpr float ROTATE_3D = static_cast<float>(2.0 / 3.0);
+	constexpr float OPEN_SIMPLEX2_SCALE = 32.69428253173828125f;
+	constexpr float OPEN_SIMPLEX2S_SCALE = 9.046026385208288f;
+
+	// FastNoiseLite's Gradients3D table: 64 (x, y, z, 0) rows.
+	alignas(32) const float GRADIENTS_3D[256] =
+	{
+		0, 1, 1, 0,  0,-1, 1, 0,  0, 1,-1, 0,  0,-1,-1, 0,
+		1, 0, 1, 0, -1, 0, 1, 0,  1, 0,-1, 0, -1, 0,-1, 0,
+		1, 1, 0, 0, -1, 1, 0, 0,  1,-1, 0, 0, -1,-1, 0, 0,
+		0, 1, 1, 0,  0,-1, 1, 0,  0, 1,-1, 0,  0,-1,-1, 0,
+		1, 0, 1, 0, -1, 0, 1, 0,  1, 0,-1, 0, -1, 0,-1, 0,
+		1, 1, 0, 0, -1, 1, 0, 0,  1,-1, 0, 0, -1,-1, 0, 0,
+		0, 1, 1, 0,  0,-1, 1, 0,  0, 1,-1, 0,  0,-1,-1, 0,
+		1, 0, 1, 0, -1, 0, 1, 0,  1, 0,-1, 0, -1, 0,-1, 0,
+		1, 1, 0, 0, -1, 1, 0, 0,  1,-1, 0, 0, -1,-1, 0, 0,
+		0, 1, 1, 0,  0,-1, 1, 0,  0, 1,-1, 0,  0,-1,-1, 0,
+		1, 0, 1, 0, -1, 0, 1, 0,  1, 0,-1, 0, -1, 0,-1, 0,
+		1, 1, 0, 0, -1, 1, 0, 0,  1,-1, 0, 0, -1,-1, 0, 0,
+		0, 1, 1, 0,  0,-1, 1, 0,  0, 1,-1, 0,  0,-1,-1, 0,
+		1, 0, 1, 0, -1, 0, 1, 0,  1, 0,-1, 0, -1, 0,-1, 0,
+		1, 1, 0, 0, -1, 1, 0, 0,  1,-1, 0, 0, -1,-1, 0, 0,
+		1, 1, 0, 0,  0,-1, 1, 0, -1, 1, 0, 0,  0,-1,-1, 0
+	};
+
+	LIR_TARGET_SSE41
+	__m128 GradCoordSse41(const __m128i seed, const __m128i xPrimed, const __m128i yPrimed, const __m128i zPrimed,
+	                      const __m128 xd, const __m128 yd, const __m128 zd)
+	{
+		__m128i hash = _mm_xor_si128(_mm_xor_si128(seed, xPrimed), _mm_xor_si128(yPrimed, zPrimed));
+		hash = _mm_mullo_epi32(hash, _mm_set1_epi32(HASH_MULTIPLIER));
+		hash = _mm_xor_si128(hash, _mm_srai_epi32(hash, 15));
+		hash = _mm_and_si128(hash, _mm_set1_epi32(GRADIENT_INDEX_MASK));
+		// One (x, y, z, 0) table row per lane, transposed into per-component vectors.
+		alignas(16) int index[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(index), hash);
+		__m128 xg = _mm_load_ps(GRADIENTS_3D + index[0]);
+		__m128 yg = _mm_load_ps(GRADIENTS_3D + index[1]);
+		__m128 zg = _mm_load_ps(GRADIENTS_3D + index[2]);
+		__m128 unused = _mm_load_ps(GRADIENTS_3D + index[3]);
+		_MM_TRANSPOSE4_PS(xg, yg, zg, unused);
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(xd, xg), _mm_mul_ps(yd, yg)), _mm_mul_ps(zd, zg));
+	}
+
+	LIR_TARGET_SSE41
+	__m128 Pow4Sse41(const __m128 a)
+	{
+		const __m128 a2 = _mm_mul_ps(a, a);
+		return _mm_mul_ps(a2, a2);
+	}
+
+	// Contribution of one lattice vertex, or 0 in lanes where `keep` is clear.
+	LIR_TARGET_SSE41
+	__m128 MaskedSse41(const __m128 keep, const __m128 a, const __m128 grad)
+	{
+		return _mm_and_ps(keep, _mm_mul_ps(Pow4Sse41(a), grad));
+	}
+
+	LIR_TARGET_SSE41
+	__m128 ToFloatSse41(const __m128i v)
+	{
+		return _mm_cvtepi32_ps(v);
+	}
+
+	// Frequency and the default OpenSimplex2 rotation (TransformNoiseCoordinate).
+	LIR_TARGET_SSE41
+	void TransformSse41(const float* x, const float* y, const float* z, const float frequency, __m128& tx, __m128& ty,
+	                    __m128& tz)
+	{
+		const __m128 f = _mm_set1_ps(frequency);
+		tx = _mm_mul_ps(_mm_loadu_ps(x), f);
+		ty = _mm_mul_ps(_mm_loadu_ps(y), f);
+		tz = _mm_mul_ps(_mm_loadu_ps(z), f);
+		const __m128 r = _mm_mul_ps(_mm_add_ps(_mm_add_ps(tx, ty), tz), _mm_set1_ps(ROTATE_3D));
+		tx = _mm_sub_ps(r, tx);
+		ty = _mm_sub_ps(r, ty);
+		tz = _mm_sub_ps(r, tz);
+	}
+
+	// FastNoiseLite::SingleOpenSimplex2 (3D), with both branchy vertex picks
+	// turned into lane masks.
+	LIR_TARGET_SSE41
+	void OpenSimplex2Sse41(const FastNoiseLite& reference, const int seed, const float frequency, const float* x,
+	                       const float* y, const float* z, const size_t count, float* out)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i primeX = _mm_set1_epi32(PRIME_X);
+		const __m128i primeY = _mm_set1_epi32(PRIME_Y);
+		const __m128i primeZ = _mm_set1_epi32(PRIME_Z);
+		size_t n = 0;
+		for (; n + 4 <= count; n += 4)
+		{
+			__m128 px, py, pz;
+			TransformSse41(x + n, y + n, z + n, frequency, px, py, pz);
+
+			// FastRound: nearest lattice point, halves away from zero.
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 negHalf = _mm_set1_ps(-0.5f);
+			__m128i i = _mm_cvttps_epi32(_mm_add_ps(px, _mm_blendv_ps(negHalf, half, _mm_cmpge_ps(px, zero))));
+			__m128i j = _mm_cvttps_epi32(_mm_add_ps(py, _mm_blendv_ps(negHalf, half, _mm_cmpge_ps(py, zero))));
+			__m128i k = _mm_cvttps_epi32(_mm_add_ps(pz, _mm_blendv_ps(negHalf, half, _mm_cmpge_ps(pz, zero))));
+			__m128 x0 = _mm_sub_ps(px, ToFloatSse41(i));
+			__m128 y0 = _mm_sub_ps(py, ToFloatSse41(j));
+			__m128 z0 = _mm_sub_ps(pz, ToFloatSse41(k));
+
+			const __m128 minusOne = _mm_set1_ps(-1.0f);
+			__m128i xNSign = _mm_or_si128(_mm_cvttps_epi32(_mm_sub_ps(minusOne, x0)), one);
+			__m128i yNSign = _mm_or_si128(_mm_cvttps_epi32(_mm_sub_ps(minusOne, y0)), one);
+			__m128i zNSign = _mm_or_si128(_mm_cvttps_epi32(_mm_sub_ps(minusOne, z0)), one);
+
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+			__m128 ax0 = _mm_mul_ps(ToFloatSse41(xNSign), _mm_xor_ps(x0, signBit));
+			__m128 ay0 = _mm_mul_ps(ToFloatSse41(yNSign), _mm_xor_ps(y0, signBit));
+			__m128 az0 = _mm_mul_ps(ToFloatSse41(zNSign), _mm_xor_ps(z0, signBit));
+
+			i = _mm_mullo_epi32(i, primeX);
+			j = _mm_mullo_epi32(j, primeY);
+			k = _mm_mullo_epi32(k, primeZ);
+
+			__m128i seedV = _mm_set1_epi32(seed);
+			__m128 value = zero;
+			__m128 a = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.6f), _mm_mul_ps(x0, x0)),
+			                      _mm_add_ps(_mm_mul_ps(y0, y0), _mm_mul_ps(z0, z0)));
+
+			for (int l = 0; ; l++)
+			{
+				value = _mm_add_ps(value, MaskedSse41(_mm_cmpgt_ps(a, zero), a,
+				                                      GradCoordSse41(seedV, i, j, k, x0, y0, z0)));
+
+				// Step along the axis with the largest offset (ties pick x, then y).
+				const __m128 pickX = _mm_and_ps(_mm_cmpge_ps(ax0, ay0), _mm_cmpge_ps(ax0, az0));
+				const __m128 pickY = _mm_andnot_ps(pickX, _mm_and_ps(_mm_cmpgt_ps(ay0, ax0), _mm_cmpge_ps(ay0, az0)));
+				const __m128 pickZ = _mm_andnot_ps(_mm_or_ps(pickX, pickY), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+
+				const __m128 x1 = _mm_add_ps(x0, _mm_and_ps(pickX, ToFloatSse41(xNSign)));
+				const __m128 y1 = _mm_add_ps(y0, _mm_and_ps(pickY, ToFloatSse41(yNSign)));
+				const __m128 z1 = _mm_add_ps(z0, _mm_and_ps(pickZ, ToFloatSse41(zNSign)));
+				__m128 b = _mm_add_ps(a, _mm_set1_ps(1.0f));
+				b = _mm_sub_ps(b, _mm_and_ps(pickX, _mm_mul_ps(ToFloatSse41(_mm_slli_epi32(xNSign, 1)), x1)));
+				b = _mm_sub_ps(b, _mm_and_ps(pickY, _mm_mul_ps(ToFloatSse41(_mm_slli_epi32(yNSign, 1)), y1)));
+				b = _mm_sub_ps(b, _mm_and_ps(pickZ, _mm_mul_ps(ToFloatSse41(_mm_slli_epi32(zNSign, 1)), z1)));
+				const __m128i i1 = _mm_sub_epi32(i, _mm_and_si128(_mm_castps_si128(pickX), _mm_mullo_epi32(xNSign, primeX)));
+				const __m128i j1 = _mm_sub_epi32(j, _mm_and_si128(_mm_castps_si128(pickY), _mm_mullo_epi32(yNSign, primeY)));
+				const __m128i k1 = _mm_sub_epi32(k, _mm_and_si128(_mm_castps_si128(pickZ), _mm_mullo_epi32(zNSign, primeZ)));
+
+				value = _mm_add_ps(value, MaskedSse41(_mm_cmpgt_ps(b, zero), b,
+				                                      GradCoordSse41(seedV, i1, j1, k1, x1, y1, z1)));
+
+				if (l == 1) break;
+
+				ax0 = _mm_sub_ps(half, ax0);
+				ay0 = _mm_sub_ps(half, ay0);
+				az0 = _mm_sub_ps(half, az0);
+
+				x0 = _mm_mul_ps(ToFloatSse41(xNSign), ax0);
+				y0 = _mm_mul_ps(ToFloatSse41(yNSign), ay0);
+				z0 = _mm_mul_ps(ToFloatSse41(zNSign), az0);
+
+				a = _mm_add_ps(a, _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.75f), ax0), _mm_add_ps(ay0, az0)));
+
+				i = _mm_add_epi32(i, _mm_and_si128(_mm_srai_epi32(xNSign, 1), primeX));
+				j = _mm_add_epi32(j, _mm_and_si128(_mm_srai_epi32(yNSign, 1), primeY));
+				k = _mm_add_epi32(k, _mm_and_si128(_mm_srai_epi32(zNSign, 1), primeZ));
+
+				xNSign = _mm_sub_epi32(_mm_setzero_si128(), xNSign);
+				yNSign = _mm_sub_epi32(_mm_setzero_si128(), yNSign);
+				zNSign = _mm_sub_epi32(_mm_setzero_si128(), zNSign);
+
+				seedV = _mm_xor_si128(seedV, _mm_set1_epi32(-1));
+			}
+
+			_mm_storeu_ps(out + n, _mm_mul_ps(value, _mm_set1_ps(OPEN_SIMPLEX2_SCALE)));
+		}
+		EvaluateTail(reference, x, y, z, n, count, out);
+	}
+
+	// FastNoiseLite::SingleOpenSimplex2S (3D). Every candidate vertex is
+	// evaluated; the scalar branches become masks, applied in the scalar order.
+	LIR_TARGET_SSE41
+	void OpenSimplex2SSse41(const FastNoiseLite& reference, const int seed, const float frequency, const float* x,
+	                        const float* y, const float* z, const size_t count, float* out)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i primeX = _mm_set1_epi32(PRIME_X);
+		const __m128i primeY = _mm_set1_epi32(PRIME_Y);
+		const __m128i primeZ = _mm_set1_epi32(PRIME_Z);
+		const __m128i primeX2 = _mm_set1_epi32(PRIME_X2);
+		const __m128i primeY2 = _mm_set1_epi32(PRIME_Y2);
+		const __m128i primeZ2 = _mm_set1_epi32(PRIME_Z2);
+		const __m128i seed1 = _mm_set1_epi32(seed);
+		const __m128i seed2 = _mm_set1_epi32(seed + OPEN_SIMPLEX2S_SEED_OFFSET);
+		size_t n = 0;
+		for (; n + 4 <= count; n += 4)
+		{
+			__m128 px, py, pz;
+			TransformSse41(x + n, y + n, z + n, frequency, px, py, pz);
+
+			// FastFloor (one below for negative inputs, as in FastNoiseLite).
+			__m128i i = _mm_add_epi32(_mm_cvttps_epi32(px), _mm_castps_si128(_mm_cmplt_ps(px, zero)));
+			__m128i j = _mm_add_epi32(_mm_cvttps_epi32(py), _mm_castps_si128(_mm_cmplt_ps(py, zero)));
+			__m128i k = _mm_add_epi32(_mm_cvttps_epi32(pz), _mm_castps_si128(_mm_cmplt_ps(pz, zero)));
+			const __m128 xi = _mm_sub_ps(px, ToFloatSse41(i));
+			const __m128 yi = _mm_sub_ps(py, ToFloatSse41(j));
+			const __m128 zi = _mm_sub_ps(pz, ToFloatSse41(k));
+
+			i = _mm_mullo_epi32(i, primeX);
+			j = _mm_mullo_epi32(j, primeY);
+			k = _mm_mullo_epi32(k, primeZ);
+
+			const __m128 minusHalf = _mm_set1_ps(-0.5f);
+			const __m128i xNMask = _mm_cvttps_epi32(_mm_sub_ps(minusHalf, xi));
+			const __m128i yNMask = _mm_cvttps_epi32(_mm_sub_ps(minusHalf, yi));
+			const __m128i zNMask = _mm_cvttps_epi32(_mm_sub_ps(minusHalf, zi));
+			// (nMask | 1) as a float: +1 or -1.
+			const __m128 xSign = ToFloatSse41(_mm_or_si128(xNMask, one));
+			const __m128 ySign = ToFloatSse41(_mm_or_si128(yNMask, one));
+			const __m128 zSign = ToFloatSse41(_mm_or_si128(zNMask, one));
+
+			// Lattice offsets: (nMask & prime), (~nMask & prime) and (nMask & 2 * prime).
+			const __m128i iN = _mm_add_epi32(i, _mm_and_si128(xNMask, primeX));
+			const __m128i jN = _mm_add_epi32(j, _mm_and_si128(yNMask, primeY));
+			const __m128i kN = _mm_add_epi32(k, _mm_and_si128(zNMask, primeZ));
+			const __m128i iF = _mm_add_epi32(i, _mm_andnot_si128(xNMask, primeX));
+			const __m128i jF = _mm_add_epi32(j, _mm_andnot_si128(yNMask, primeY));
+			const __m128i kF = _mm_add_epi32(k, _mm_andnot_si128(zNMask, primeZ));
+			const __m128i iP = _mm_add_epi32(i, primeX);
+			const __m128i jP = _mm_add_epi32(j, primeY);
+			const __m128i kP = _mm_add_epi32(k, primeZ);
+			const __m128i iN2 = _mm_add_epi32(i, _mm_and_si128(xNMask, primeX2));
+			const __m128i jN2 = _mm_add_epi32(j, _mm_and_si128(yNMask, primeY2));
+			const __m128i kN2 = _mm_add_epi32(k, _mm_and_si128(zNMask, primeZ2));
+
+			const __m128 x0 = _mm_add_ps(xi, ToFloatSse41(xNMask));
+			const __m128 y0 = _mm_add_ps(yi, ToFloatSse41(yNMask));
+			const __m128 z0 = _mm_add_ps(zi, ToFloatSse41(zNMask));
+			const __m128 a0 = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.75f), _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0)),
+			                             _mm_mul_ps(z0, z0));
+			__m128 value = _mm_mul_ps(Pow4Sse41(a0), GradCoordSse41(seed1, iN, jN, kN, x0, y0, z0));
+
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 x1 = _mm_sub_ps(xi, half);
+			const __m128 y1 = _mm_sub_ps(yi, half);
+			const __m128 z1 = _mm_sub_ps(zi, half);
+			const __m128 a1 = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.75f), _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1)),
+			                             _mm_mul_ps(z1, z1));
+			value = _mm_add_ps(value, _mm_mul_ps(Pow4Sse41(a1), GradCoordSse41(seed2, iP, jP, kP, x1, y1, z1)));
+
+			const __m128 xAFlipMask0 = _mm_mul_ps(ToFloatSse41(_mm_slli_epi32(_mm_or_si128(xNMask, one), 1)), x1);
+			const __m128 yAFlipMask0 = _mm_mul_ps(ToFloatSse41(_mm_slli_epi32(_mm_or_si128(yNMask, one), 1)), y1);
+			const __m128 zAFlipMask0 = _mm_mul_ps(ToFloatSse41(_mm_slli_epi32(_mm_or_si128(zNMask, one), 1)), z1);
+			const __m128i minusTwo = _mm_set1_epi32(-2);
+			const __m128 oneFloat = _mm_set1_ps(1.0f);
+			const __m128 xAFlipMask1 = _mm_sub_ps(_mm_mul_ps(ToFloatSse41(_mm_sub_epi32(minusTwo, _mm_slli_epi32(xNMask, 2))), x1), oneFloat);
+			const __m128 yAFlipMask1 = _mm_sub_ps(_mm_mul_ps(ToFloatSse41(_mm_sub_epi32(minusTwo, _mm_slli_epi32(yNMask, 2))), y1), oneFloat);
+			const __m128 zAFlipMask1 = _mm_sub_ps(_mm_mul_ps(ToFloatSse41(_mm_sub_epi32(minusTwo, _mm_slli_epi32(zNMask, 2))), z1), oneFloat);
+
+			// Vertices 2, 3, 4 (x flip).
+			const __m128 a2 = _mm_add_ps(xAFlipMask0, a0);
+			const __m128 take2 = _mm_cmpgt_ps(a2, zero);
+			value = _mm_add_ps(value, MaskedSse41(take2, a2,
+				GradCoordSse41(seed1, iF, jN, kN, _mm_sub_ps(x0, xSign), y0, z0)));
+			const __m128 a3 = _mm_add_ps(_mm_add_ps(yAFlipMask0, zAFlipMask0), a0);
+			value = _mm_add_ps(value, MaskedSse41(_mm_andnot_ps(take2, _mm_cmpgt_ps(a3, zero)), a3,
+				GradCoordSse41(seed1, iN, jF, kF, x0, _mm_sub_ps(y0, ySign), _mm_sub_ps(z0, zSign))));
+			const __m128 a4 = _mm_add_ps(xAFlipMask1, a1);
+			const __m128 skip5 = _mm_andnot_ps(take2, _mm_cmpgt_ps(a4, zero));
+			value = _mm_add_ps(value, MaskedSse41(skip5, a4,
+				GradCoordSse41(seed2, iN2, jP, kP, _mm_add_ps(xSign, x1), y1, z1)));
+
+			// Vertices 6, 7, 8 (y flip).
+			const __m128 a6 = _mm_add_ps(yAFlipMask0, a0);
+			const __m128 take6 = _mm_cmpgt_ps(a6, zero);
+			value = _mm_add_ps(value, MaskedSse41(take6, a6,
+				GradCoordSse41(seed1, iN, jF, kN, x0, _mm_sub_ps(y0, ySign), z0)));
+			const __m128 a7 = _mm_add_ps(_mm_add_ps(xAFlipMask0, zAFlipMask0), a0);
+			value = _mm_add_ps(value, MaskedSse41(_mm_andnot_ps(take6, _mm_cmpgt_ps(a7, zero)), a7,
+				GradCoordSse41(seed1, iF, jN, kF, _mm_sub_ps(x0, xSign), y0, _mm_sub_ps(z0, zSign))));
+			const __m128 a8 = _mm_add_ps(yAFlipMask1, a1);
+			const __m128 skip9 = _mm_andnot_ps(take6, _mm_cmpgt_ps(a8, zero));
+			value = _mm_add_ps(value, MaskedSse41(skip9, a8,
+				GradCoordSse41(seed2, iP, jN2, kP, x1, _mm_add_ps(ySign, y1), z1)));
+
+			// Vertices A, B, C (z flip).
+			const __m128 aA = _mm_add_ps(zAFlipMask0, a0);
+			const __m128 takeA = _mm_cmpgt_ps(aA, zero);
+			value = _mm_add_ps(value, MaskedSse41(takeA, aA,
+				GradCoordSse41(seed1, iN, jN, kF, x0, y0, _mm_sub_ps(z0, zSign))));
+			const __m128 aB = _mm_add_ps(_mm_add_ps(xAFlipMask0, yAFlipMask0), a0);
+			value = _mm_add_ps(value, MaskedSse41(_mm_andnot_ps(takeA, _mm_cmpgt_ps(aB, zero)), aB,
+				GradCoordSse41(seed1, iF, jF, kN, _mm_sub_ps(x0, xSign), _mm_sub_ps(y0, ySign), z0)));
+			const __m128 aC = _mm_add_ps(zAFlipMask1, a1);
+			const __m128 skipD = _mm_andnot_ps(takeA, _mm_cmpgt_ps(aC, zero));
+			value = _mm_add_ps(value, MaskedSse41(skipD, aC,
+				GradCoordSse41(seed2, iP, jP, kN2, x1, y1, _mm_add_ps(zSign, z1))));
+
+			// Vertices 5, 9, D, unless their pair above was taken.
+			const __m128 a5 = _mm_add_ps(_mm_add_ps(yAFlipMask1, zAFlipMask1), a1);
+			value = _mm_add_ps(value, MaskedSse41(_mm_andnot_ps(skip5, _mm_cmpgt_ps(a5, zero)), a5,
+				GradCoordSse41(seed2, iP, jN2, kN2, x1, _mm_add_ps(ySign, y1), _mm_add_ps(zSign, z1))));
+			const __m128 a9 = _mm_add_ps(_mm_add_ps(xAFlipMask1, zAFlipMask1), a1);
+			value = _mm_add_ps(value, MaskedSse41(_mm_andnot_ps(skip9, _mm_cmpgt_ps(a9, zero)), a9,
+				GradCoordSse41(seed2, iN2, jP, kN2, _mm_add_ps(xSign, x1), y1, _mm_add_ps(zSign, z1))));
+			const __m128 aD = _mm_add_ps(_mm_add_ps(xAFlipMask1, yAFlipMask1), a1);
+			value = _mm_add_ps(value, MaskedSse41(_mm_andnot_ps(skipD, _mm_cmpgt_ps(aD, zero)), aD,
+				GradCoordSse41(seed2, iN2, jN2, kP, _mm_add_ps(xSign, x1), _mm_add_ps(ySign, y1), z1)));
+
+			_mm_storeu_ps(out + n, _mm_mul_ps(value, _mm_set1_ps(OPEN_SIMPLEX2S_SCALE)));
+		}
+		EvaluateTail(reference, x, y, z, n, count, out);
+	}
+
+	LIR_TARGET_AVX2
+	__m256 GradCoordAvx2(const __m256i seed, const __m256i xPrimed, const __m256i yPrimed, const __m256i zPrimed,
+	                      const __m256 xd, const __m256 yd, const __m256 zd)
+	{
+		__m256i hash = _mm256_xor_si256(_mm256_xor_si256(seed, xPrimed), _mm256_xor_si256(yPrimed, zPrimed));
+		hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32(HASH_MULTIPLIER));
+		hash = _mm256_xor_si256(hash, _mm256_srai_epi32(hash, 15));
+		hash = _mm256_and_si256(hash, _mm256_set1_epi32(GRADIENT_INDEX_MASK));
+		const __m256 xg = _mm256_i32gather_ps(GRADIENTS_3D, hash, 4);
+		const __m256 yg = _mm256_i32gather_ps(GRADIENTS_3D, _mm256_or_si256(hash, _mm256_set1_epi32(1)), 4);
+		const __m256 zg = _mm256_i32gather_ps(GRADIENTS_3D, _mm256_or_si256(hash, _mm256_set1_epi32(2)), 4);
+		return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(xd, xg), _mm256_mul_ps(yd, yg)), _mm256_mul_ps(zd, zg));
+	}
+
+	LIR_TARGET_AVX2
+	__m256 Pow4Avx2(const __m256 a)
+	{
+		const __m256 a2 = _mm256_mul_ps(a, a);
+		return _mm256_mul_ps(a2, a2);
+	}
+
+	LIR_TARGET_AVX2
+	__m256 MaskedAvx2(const __m256 keep, const __m256 a, const __m256 grad)
+	{
+		return _mm256_and_ps(keep, _mm256_mul_ps(Pow4Avx2(a), grad));
+	}
+
+	LIR_TARGET_AVX2
+	__m256 ToFloatAvx2(const __m256i v)
+	{
+		return _mm256_cvtepi32_ps(v);
+	}
+
+	LIR_TARGET_AVX2
+	void TransformAvx2(const float* x, const float* y, const float* z, const float frequency, __m256& tx, __m256& ty,
+	                    __m256& tz)
+	{
+		const __m256 f = _mm256_set1_ps(frequency);
+		tx = _mm256_mul_ps(_mm256_loadu_ps(x), f);
+		ty = _mm256_mul_ps(_mm256_loadu_ps(y), f);
+		tz = _mm256_mul_ps(_mm256_loadu_ps(z), f);
+		const __m256 r = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(tx, ty), tz), _mm256_set1_ps(ROTATE_3D));
+		tx = _mm256_sub_ps(r, tx);
+		ty = _mm256_sub_ps(r, ty);
+		tz = _mm256_sub_ps(r, tz);
+	}
+
+	// 8-lane copy of OpenSimplex2Sse41.
+	LIR_TARGET_AVX2
+	void OpenSimplex2Avx2(const FastNoiseLite& reference, const int seed, const float frequency, const float* x,
+	                       const float* y, const float* z, const size_t count, float* out)
+	{
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256i one = _mm256_set1_epi32(1);
+		const __m256i primeX = _mm256_set1_epi32(PRIME_X);
+		const __m256i primeY = _mm256_set1_epi32(PRIME_Y);
+		const __m256i primeZ = _mm256_set1_epi32(PRIME_Z);
+		size_t n = 0;
+		for (; n + 8 <= count; n += 8)
+		{
+			__m256 px, py, pz;
+			TransformAvx2(x + n, y + n, z + n, frequency, px, py, pz);
+
+			// FastRound: nearest lattice point, halves away from zero.
+			const __m256 half = _mm256_set1_ps(0.5f);
+			const __m256 negHalf = _mm256_set1_ps(-0.5f);
+			__m256i i = _mm256_cvttps_epi32(_mm256_add_ps(px, _mm256_blendv_ps(negHalf, half, _mm256_cmp_ps(px, zero, _CMP_GE_OQ))));
+			__m256i j = _mm256_cvttps_epi32(_mm256_add_ps(py, _mm256_blendv_ps(negHalf, half, _mm256_cmp_ps(py, zero, _CMP_GE_OQ))));
+			__m256i k = _mm256_cvttps_epi32(_mm256_add_ps(pz, _mm256_blendv_ps(negHalf, half, _mm256_cmp_ps(pz, zero, _CMP_GE_OQ))));
+			__m256 x0 = _mm256_sub_ps(px, ToFloatAvx2(i));
+			__m256 y0 = _mm256_sub_ps(py, ToFloatAvx2(j));
+			__m256 z0 = _mm256_sub_ps(pz, ToFloatAvx2(k));
+
+			const __m256 minusOne = _mm256_set1_ps(-1.0f);
+			__m256i xNSign = _mm256_or_si256(_mm256_cvttps_epi32(_mm256_sub_ps(minusOne, x0)), one);
+			__m256i yNSign = _mm256_or_si256(_mm256_cvttps_epi32(_mm256_sub_ps(minusOne, y0)), one);
+			__m256i zNSign = _mm256_or_si256(_mm256_cvttps_epi32(_mm256_sub_ps(minusOne, z0)), one);
+
+			const __m256 signBit = _mm256_set1_ps(-0.0f);
+			__m256 ax0 = _mm256_mul_ps(ToFloatAvx2(xNSign), _mm256_xor_ps(x0, signBit));
+			__m256 ay0 = _mm256_mul_ps(ToFloatAvx2(yNSign), _mm256_xor_ps(y0, signBit));
+			__m256 az0 = _mm256_mul_ps(ToFloatAvx2(zNSign), _mm256_xor_ps(z0, signBit));
+
+			i = _mm256_mullo_epi32(i, primeX);
+			j = _mm256_mullo_epi32(j, primeY);
+			k = _mm256_mullo_epi32(k, primeZ);
+
+			__m256i seedV = _mm256_set1_epi32(seed);
+			__m256 value = zero;
+			__m256 a = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(0.6f), _mm256_mul_ps(x0, x0)),
+			                      _mm256_add_ps(_mm256_mul_ps(y0, y0), _mm256_mul_ps(z0, z0)));
+
+			for (int l = 0; ; l++)
+			{
+				value = _mm256_add_ps(value, MaskedAvx2(_mm256_cmp_ps(a, zero, _CMP_GT_OQ), a,
+				                                      GradCoordAvx2(seedV, i, j, k, x0, y0, z0)));
+
+				// Step along the axis with the largest offset (ties pick x, then y).
+				const __m256 pickX = _mm256_and_ps(_mm256_cmp_ps(ax0, ay0, _CMP_GE_OQ), _mm256_cmp_ps(ax0, az0, _CMP_GE_OQ));
+				const __m256 pickY = _mm256_andnot_ps(pickX, _mm256_and_ps(_mm256_cmp_ps(ay0, ax0, _CMP_GT_OQ), _mm256_cmp_ps(ay0, az0, _CMP_GE_OQ)));
+				const __m256 pickZ = _mm256_andnot_ps(_mm256_or_ps(pickX, pickY), _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+
+				const __m256 x1 = _mm256_add_ps(x0, _mm256_and_ps(pickX, ToFloatAvx2(xNSign)));
+				const __m256 y1 = _mm256_add_ps(y0, _mm256_and_ps(pickY, ToFloatAvx2(yNSign)));
+				const __m256 z1 = _mm256_add_ps(z0, _mm256_and_ps(pickZ, ToFloatAvx2(zNSign)));
+				__m256 b = _mm256_add_ps(a, _mm256_set1_ps(1.0f));
+				b = _mm256_sub_ps(b, _mm256_and_ps(pickX, _mm256_mul_ps(ToFloatAvx2(_mm256_slli_epi32(xNSign, 1)), x1)));
+				b = _mm256_sub_ps(b, _mm256_and_ps(pickY, _mm256_mul_ps(ToFloatAvx2(_mm256_slli_epi32(yNSign, 1)), y1)));
+				b = _mm256_sub_ps(b, _mm256_and_ps(pickZ, _mm256_mul_ps(ToFloatAvx2(_mm256_slli_epi32(zNSign, 1)), z1)));
+				const __m256i i1 = _mm256_sub_epi32(i, _mm256_and_si256(_mm256_castps_si256(pickX), _mm256_mullo_epi32(xNSign, primeX)));
+				const __m256i j1 = _mm256_sub_epi32(j, _mm256_and_si256(_mm256_castps_si256(pickY), _mm256_mullo_epi32(yNSign, primeY)));
+				const __m256i k1 = _mm256_sub_epi32(k, _mm256_and_si256(_mm256_castps_si256(pickZ), _mm256_mullo_epi32(zNSign, primeZ)));
+
+				value = _mm256_add_ps(value, MaskedAvx2(_mm256_cmp_ps(b, zero, _CMP_GT_OQ), b,
+				                                      GradCoordAvx2(seedV, i1, j1, k1, x1, y1, z1)));
+
+				if (l == 1) break;
+
+				ax0 = _mm256_sub_ps(half, ax0);
+				ay0 = _mm256_sub_ps(half, ay0);
+				az0 = _mm256_sub_ps(half, az0);
+
+				x0 = _mm256_mul_ps(ToFloatAvx2(xNSign), ax0);
+				y0 = _mm256_mul_ps(ToFloatAvx2(yNSign), ay0);
+				z0 = _mm256_mul_ps(ToFloatAvx2(zNSign), az0);
+
+				a = _mm256_add_ps(a, _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(0.75f), ax0), _mm256_add_ps(ay0, az0)));
+
+				i = _mm256_add_epi32(i, _mm256_and_si256(_mm256_srai_epi32(xNSign, 1), primeX));
+				j = _mm256_add_epi32(j, _mm256_and_si256(_mm256_srai_epi32(yNSign, 1), primeY));
+				k = _mm256_add_epi32(k, _mm256_and_si256(_mm256_srai_epi32(zNSign, 1), primeZ));
+
+				xNSign = _mm256_sub_epi32(_mm256_setzero_si256(), xNSign);
+				yNSign = _mm256_sub_epi32(_mm256_setzero_si256(), yNSign);
+				zNSign = _mm256_sub_epi32(_mm256_setzero_si256(), zNSign);
+
+				seedV = _mm256_xor_si256(seedV, _mm256_set1_epi32(-1));
+			}
+
+			_mm256_storeu_ps(out + n, _mm256_mul_ps(value, _mm256_set1_ps(OPEN_SIMPLEX2_SCALE)));
+		}
+		EvaluateTail(reference, x, y, z, n, count, out);
+	}
+
+	// 8-lane copy of OpenSimplex2SSse41.
+	LIR_TARGET_AVX2
+	void OpenSimplex2SAvx2(const FastNoiseLite& reference, const int seed, const float frequency, const float* x,
+	                        const float* y, const float* z, const size_t count, float* out)
+	{
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256i one = _mm256_set1_epi32(1);
+		const __m256i primeX = _mm256_set1_epi32(PRIME_X);
+		const __m256i primeY = _mm256_set1_epi32(PRIME_Y);
+		const __m256i primeZ = _mm256_set1_epi32(PRIME_Z);
+		const __m256i primeX2 = _mm256_set1_epi32(PRIME_X2);
+		const __m256i primeY2 = _mm256_set1_epi32(PRIME_Y2);
+		const __m256i primeZ2 = _mm256_set1_epi32(PRIME_Z2);
+		const __m256i seed1 = _mm256_set1_epi32(seed);
+		const __m256i seed2 = _mm256_set1_epi32(seed + OPEN_SIMPLEX2S_SEED_OFFSET);
+		size_t n = 0;
+		for (; n + 8 <= count; n += 8)
+		{
+			__m256 px, py, pz;
+			TransformAvx2(x + n, y + n, z + n, frequency, px, py, pz);
+
+			// FastFloor (one below for negative inputs, as in FastNoiseLite).
+			__m256i i = _mm256_add_epi32(_mm256_cvttps_epi32(px), _mm256_castps_si256(_mm256_cmp_ps(px, zero, _CMP_LT_OQ)));
+			__m256i j = _mm256_add_epi32(_mm256_cvttps_epi32(py), _mm256_castps_si256(_mm256_cmp_ps(py, zero, _CMP_LT_OQ)));
+			__m256i k = _mm256_add_epi32(_mm256_cvttps_epi32(pz), _mm256_castps_si256(_mm256_cmp_ps(pz, zero, _CMP_LT_OQ)));
+			const __m256 xi = _mm256_sub_ps(px, ToFloatAvx2(i));
+			const __m256 yi = _mm256_sub_ps(py, ToFloatAvx2(j));
+			const __m256 zi = _mm256_sub_ps(pz, ToFloatAvx2(k));
+
+			i = _mm256_mullo_epi32(i, primeX);
+			j = _mm256_mullo_epi32(j, primeY);
+			k = _mm256_mullo_epi32(k, primeZ);
+
+			const __m256 minusHalf = _mm256_set1_ps(-0.5f);
+			const __m256i xNMask = _mm256_cvttps_epi32(_mm256_sub_ps(minusHalf, xi));
+			const __m256i yNMask = _mm256_cvttps_epi32(_mm256_sub_ps(minusHalf, yi));
+			const __m256i zNMask = _mm256_cvttps_epi32(_mm256_sub_ps(minusHalf, zi));
+			// (nMask | 1) as a float: +1 or -1.
+			const __m256 xSign = ToFloatAvx2(_mm256_or_si256(xNMask, one));
+			const __m256 ySign = ToFloatAvx2(_mm256_or_si256(yNMask, one));
+			const __m256 zSign = ToFloatAvx2(_mm256_or_si256(zNMask, one));
+
+			// Lattice offsets: (nMask & prime), (~nMask & prime) and (nMask & 2 * prime).
+			const __m256i iN = _mm256_add_epi32(i, _mm256_and_si256(xNMask, primeX));
+			const __m256i jN = _mm256_add_epi32(j, _mm256_and_si256(yNMask, primeY));
+			const __m256i kN = _mm256_add_epi32(k, _mm256_and_si256(zNMask, primeZ));
+			const __m256i iF = _mm256_add_epi32(i, _mm256_andnot_si256(xNMask, primeX));
+			const __m256i jF = _mm256_add_epi32(j, _mm256_andnot_si256(yNMask, primeY));
+			const __m256i kF = _mm256_add_epi32(k, _mm256_andnot_si256(zNMask, primeZ));
+			const __m256i iP = _mm256_add_epi32(i, primeX);
+			const __m256i jP = _mm256_add_epi32(j, primeY);
+			const __m256i kP = _mm256_add_epi32(k, primeZ);
+			const __m256i iN2 = _mm256_add_epi32(i, _mm256_and_si256(xNMask, primeX2));
+			const __m256i jN2 = _mm256_add_epi32(j, _mm256_and_si256(yNMask, primeY2));
+			const __m256i kN2 = _mm256_add_epi32(k, _mm256_and_si256(zNMask, primeZ2));
+
+			const __m256 x0 = _mm256_add_ps(xi, ToFloatAvx2(xNMask));
+			const __m256 y0 = _mm256_add_ps(yi, ToFloatAvx2(yNMask));
+			const __m256 z0 = _mm256_add_ps(zi, ToFloatAvx2(zNMask));
+			const __m256 a0 = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(0.75f), _mm256_mul_ps(x0, x0)), _mm256_mul_ps(y0, y0)),
+			                             _mm256_mul_ps(z0, z0));
+			__m256 value = _mm256_mul_ps(Pow4Avx2(a0), GradCoordAvx2(seed1, iN, jN, kN, x0, y0, z0));
+
+			const __m256 half = _mm256_set1_ps(0.5f);
+			const __m256 x1 = _mm256_sub_ps(xi, half);
+			const __m256 y1 = _mm256_sub_ps(yi, half);
+			const __m256 z1 = _mm256_sub_ps(zi, half);
+			const __m256 a1 = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(0.75f), _mm256_mul_ps(x1, x1)), _mm256_mul_ps(y1, y1)),
+			                             _mm256_mul_ps(z1, z1));
+			value = _mm256_add_ps(value, _mm256_mul_ps(Pow4Avx2(a1), GradCoordAvx2(seed2, iP, jP, kP, x1, y1, z1)));
+
+			const __m256 xAFlipMask0 = _mm256_mul_ps(ToFloatAvx2(_mm256_slli_epi32(_mm256_or_si256(xNMask, one), 1)), x1);
+			const __m256 yAFlipMask0 = _mm256_mul_ps(ToFloatAvx2(_mm256_slli_epi32(_mm256_or_si256(yNMask, one), 1)), y1);
+			const __m256 zAFlipMask0 = _mm256_mul_ps(ToFloatAvx2(_mm256_slli_epi32(_mm256_or_si256(zNMask, one), 1)), z1);
+			const __m256i minusTwo = _mm256_set1_epi32(-2);
+			const __m256 oneFloat = _mm256_set1_ps(1.0f);
+			const __m256 xAFlipMask1 = _mm256_sub_ps(_mm256_mul_ps(ToFloatAvx2(_mm256_sub_epi32(minusTwo, _mm256_slli_epi32(xNMask, 2))), x1), oneFloat);
+			const __m256 yAFlipMask1 = _mm256_sub_ps(_mm256_mul_ps(ToFloatAvx2(_mm256_sub_epi32(minusTwo, _mm256_slli_epi32(yNMask, 2))), y1), oneFloat);
+			const __m256 zAFlipMask1 = _mm256_sub_ps(_mm256_mul_ps(ToFloatAvx2(_mm256_sub_epi32(minusTwo, _mm256_slli_epi32(zNMask, 2))), z1), oneFloat);
+
+			// Vertices 2, 3, 4 (x flip).
+			const __m256 a2 = _mm256_add_ps(xAFlipMask0, a0);
+			const __m256 take2 = _mm256_cmp_ps(a2, zero, _CMP_GT_OQ);
+			value = _mm256_add_ps(value, MaskedAvx2(take2, a2,
+				GradCoordAvx2(seed1, iF, jN, kN, _mm256_sub_ps(x0, xSign), y0, z0)));
+			const __m256 a3 = _mm256_add_ps(_mm256_add_ps(yAFlipMask0, zAFlipMask0), a0);
+			value = _mm256_add_ps(value, MaskedAvx2(_mm256_andnot_ps(take2, _mm256_cmp_ps(a3, zero, _CMP_GT_OQ)), a3,
+				GradCoordAvx2(seed1, iN, jF, kF, x0, _mm256_sub_ps(y0, ySign), _mm256_sub_ps(z0, zSign))));
+			const __m256 a4 = _mm256_add_ps(xAFlipMask1, a1);
+			const __m256 skip5 = _mm256_andnot_ps(take2, _mm256_cmp_ps(a4, zero, _CMP_GT_OQ));
+			value = _mm256_add_ps(value, MaskedAvx2(skip5, a4,
+				GradCoordAvx2(seed2, iN2, jP, kP, _mm256_add_ps(xSign, x1), y1, z1)));
+
+			// Vertices 6, 7, 8 (y flip).
+			const __m256 a6 = _mm256_add_ps(yAFlipMask0, a0);
+			const __m256 take6 = _mm256_cmp_ps(a6, zero, _CMP_GT_OQ);
+			value = _mm256_add_ps(value, MaskedAvx2(take6, a6,
+				GradCoordAvx2(seed1, iN, jF, kN, x0, _mm256_sub_ps(y0, ySign), z0)));
+			const __m256 a7 = _mm256_add_ps(_mm256_add_ps(xAFlipMask0, zAFlipMask0), a0);
+			value = _mm256_add_ps(value, MaskedAvx2(_mm256_andnot_ps(take6, _mm256_cmp_ps(a7, zero, _CMP_GT_OQ)), a7,
+				GradCoordAvx2(seed1, iF, jN, kF, _mm256_sub_ps(x0, xSign), y0, _mm256_sub_ps(z0, zSign))));
+			const __m256 a8 = _mm256_add_ps(yAFlipMask1, a1);
+			const __m256 skip9 = _mm256_andnot_ps(take6, _mm256_cmp_ps(a8, zero, _CMP_GT_OQ));
+			value = _mm256_add_ps(value, MaskedAvx2(skip9, a8,
+				GradCoordAvx2(seed2, iP, jN2, kP, x1, _mm256_add_ps(ySign, y1), z1)));
+
+			// Vertices A, B, C (z flip).
+			const __m256 aA = _mm256_add_ps(zAFlipMask0, a0);
+			const __m256 takeA = _mm256_cmp_ps(aA, zero, _CMP_GT_OQ);
+			value = _mm256_add_ps(value, MaskedAvx2(takeA, aA,
+				GradCoordAvx2(seed1, iN, jN, kF, x0, y0, _mm256_sub_ps(z0, zSign))));
+			const __m256 aB = _mm256_add_ps(_mm256_add_ps(xAFlipMask0, yAFlipMask0), a0);
+			value = _mm256_add_ps(value, MaskedAvx2(_mm256_andnot_ps(takeA, _mm256_cmp_ps(aB, zero, _CMP_GT_OQ)), aB,
+				GradCoordAvx2(seed1, iF, jF, kN, _mm256_sub_ps(x0, xSign), _mm256_sub_ps(y0, ySign), z0)));
+			const __m256 aC = _mm256_add_ps(zAFlipMask1, a1);
+			const __m256 skipD = _mm256_andnot_ps(takeA, _mm256_cmp_ps(aC, zero, _CMP_GT_OQ));
+			value = _mm256_add_ps(value, MaskedAvx2(skipD, aC,
+				GradCoordAvx2(seed2, iP, jP, kN2, x1, y1, _mm256_add_ps(zSign, z1))));
+
+			// Vertices 5, 9, D, unless their pair above was taken.
+			const __m256 a5 = _mm256_add_ps(_mm256_add_ps(yAFlipMask1, zAFlipMask1), a1);
+			value = _mm256_add_ps(value, MaskedAvx2(_mm256_andnot_ps(skip5, _mm256_cmp_ps(a5, zero, _CMP_GT_OQ)), a5,
+				GradCoordAvx2(seed2, iP, jN2, kN2, x1, _mm256_add_ps(ySign, y1), _mm256_add_ps(zSign, z1))));
+			const __m256 a9 = _mm256_add_ps(_mm256_add_ps(xAFlipMask1, zAFlipMask1), a1);
+			value = _mm256_add_ps(value, MaskedAvx2(_mm256_andnot_ps(skip9, _mm256_cmp_ps(a9, zero, _CMP_GT_OQ)), a9,
+				GradCoordAvx2(seed2, iN2, jP, kN2, _mm256_add_ps(xSign, x1), y1, _mm256_add_ps(zSign, z1))));
+			const __m256 aD = _mm256_add_ps(_mm256_add_ps(xAFlipMask1, yAFlipMask1), a1);
+			value = _mm256_add_ps(value, MaskedAvx2(_mm256_andnot_ps(skipD, _mm256_cmp_ps(aD, zero, _CMP_GT_OQ)), aD,
+				GradCoordAvx2(seed2, iN2, jN2, kP, _mm256_add_ps(xSign, x1), _mm256_add_ps(ySign, y1), z1)));
+
+			_mm256_storeu_ps(out + n, _mm256_mul_ps(value, _mm256_set1_ps(OPEN_SIMPLEX2S_SCALE)));
+		}
+		EvaluateTail(reference, x, y, z, n, count, out);
+	}
+#endif
+
+	BatchFn SelectBatchFn(const SimdLevel level, const NoiseKernel::NoiseType type)
+	{
+		const bool smooth = type == NoiseKernel::NoiseType::OpenSimplex2S;
+		switch (level)
+		{
+#if defined(LIR_ARCH_X86)
+		case SimdLevel::Avx2: return smooth ? OpenSimplex2SAvx2 : OpenSimplex2Avx2;
+		case SimdLevel::Sse41: return smooth ? OpenSimplex2SSse41 : OpenSimplex2Sse41;
+#endif
+		default: return EvaluateScalar;
+		}
+	}
+}
+
+void NoiseKernel::Evaluate(const Params& params, const float* x, const float* y, const float* z, const size_t count,
+                           float* out)
+{
+	Evaluate(CpuFeatures::GetSimdLevel(), params, x, y, z, count, out);
+}
+
+void NoiseKernel::Evaluate(const SimdLevel level, const Params& params, const float* x, const float* y,
+                           const float* z, const size_t count, float* out)
+{
+	FastNoiseLite reference;
+	Configure(reference, params);
+	SelectBatchFn(level, params.Type)(reference, params.Seed, params.Frequency, x, y, z, count, out);
+}
+
+void NoiseKernel::Configure(FastNoiseLite& noise, const Params& params)
+{
+	noise.SetNoiseType(params.Type == NoiseType::OpenSimplex2S
+		                   ? FastNoiseLite::NoiseType_OpenSimplex2S
+		                   : FastNoiseLite::NoiseType_OpenSimplex2);
+	noise.SetSeed(params.Seed);
+	noise.SetFrequency(params.Frequency);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+
+#include "CpuFeatures.h"
+
+class FastNoiseLite;
+
+// Batched 3D noise: evaluates FastNoiseLite's OpenSimplex2 / OpenSimplex2S
+// (no fractal, default domain rotation) for arrays of points, 4 (SSE4.1) or 8
+// (AVX2) points per step. Callers gather their points and make one call
+// instead of one GetNoise per point.
+//
+// The vector paths repeat the scalar operations lane by lane in the same
+// order (a separate multiply and add, no FMA), and a skipped contribution is
+// added as 0, so they match FastNoiseLite::GetNoise within MAX_ERROR
+// (bit-identical on x86 builds that do not contract the scalar code into
+// FMAs). Other levels, and tails shorter than a vector, use FastNoiseLite itself.
+class NoiseKernel
+{
+public:
+	enum class NoiseType
+	{
+		OpenSimplex2,
+		OpenSimplex2S
+	};
+
+	// The FastNoiseLite settings the batch paths reproduce (defaults match a
+	// default-constructed FastNoiseLite).
+	struct Params
+	{
+		NoiseType Type = NoiseType::OpenSimplex2;
+		int Seed = 1337;
+		float Frequency = 0.01f;
+	};
+
+	// out[i] = noise(x[i], y[i], z[i]) for i < count.
+	static void Evaluate(const Params& params, const float* x, const float* y, const float* z, size_t count,
+	                     float* out);
+
+	// Same, with an explicit instruction set (must be supported by this CPU).
+	static void Evaluate(SimdLevel level, const Params& params, const float* x, const float* y, const float* z,
+	                     size_t count, float* out);
+
+	// Set up `noise` as the scalar reference for `params`.
+	static void Configure(FastNoiseLite& noise, const Params& params);
+
+	// Largest difference from FastNoiseLite::GetNoise on any level (noise range is -1 to 1).
+	static constexpr float MAX_ERROR = 1e-6f;
+};
@@ -0,0 +1,45 @@
+#include "PowerPolicy.h"
+
+PowerPolicy::PowerPolicy(PowerSource& source) :
+	Source(source)
+{
+}
+
+bool PowerPolicy::Update(const double nowSeconds)
+{
+	if (HasPolled && nowSeconds - LastPollTime < POLL_SECONDS) return false;
+
+	const Reason before = HasPolled ? GetReason() : Reason::None;
+	LastState = Source.Read();
+	LastPollTime = nowSeconds;
+	HasPolled = true;
+
+	// Unknown load counts as low. LoadThrottled flips only after an unbroken
+	// run of polls beyond the far edge of the band (HIGH_LOAD going up,
+	// LOW_LOAD coming down).
+	const float load = LastState.OtherCpuLoad;
+	const bool pastBand = LoadThrottled ? load < LOW_LOAD : load >= HIGH_LOAD;
+	if (!pastBand)
+	{
+		LoadRunStart = -1.0;
+	}
+	else
+	{
+		if (LoadRunStart < 0.0) LoadRunStart = nowSeconds;
+		if (nowSeconds - LoadRunStart >= (LoadThrottled ? LOW_LOAD_SECONDS : HIGH_LOAD_SECONDS))
+		{
+			LoadThrottled = !LoadThrottled;
+			LoadRunStart = -1.0;
+		}
+	}
+
+	return GetReason() != before;
+}
+
+PowerPolicy::Reason PowerPolicy::GetReason() const
+{
+	if (LastState.BatterySaver) return Reason::BatterySaver;
+	if (LastState.OnBattery) return Reason::Battery;
+	if (LoadThrottled) return Reason::SystemLoad;
+	return Reason::None;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "PowerSource.h"
+
+// PowerPolicy Class
+// Decides how hard the app may run from its PowerSource: full speed normally;
+// a lower frame rate, fewer particles and slower settling while on battery,
+// in battery saver, or while other processes keep the CPU busy. Power-state
+// changes apply at the next poll; load has to stay high (or low) for a while
+// first, so a short burst in another program does not make it flap. Pure
+// logic: the caller passes the time, so a trace replays exactly.
+class PowerPolicy
+{
+public:
+	struct Limits
+	{
+		float MaxFrameRate;  // frames per second, 0 = the monitor's refresh rate
+		float ParticleScale; // share of MaxParticles simulated
+		int SettleInterval;  // settle / smooth the heap every this many updates
+	};
+
+	// Why the limits are lowered (the first that applies), or None.
+	enum class Reason
+	{
+		None,
+		Battery,
+		BatterySaver,
+		SystemLoad
+	};
+
+	explicit PowerPolicy(PowerSource& source);
+
+	// Poll the source if POLL_SECONDS have passed since the last poll (the
+	// first call always polls). Returns true if the limits or their reason changed.
+	bool Update(double nowSeconds);
+
+	const Limits& GetLimits() const { return GetReason() == Reason::None ? FULL : THROTTLED; }
+	Reason GetReason() const;
+
+	static constexpr Limits FULL = { 0.0f, 1.0f, 1 };
+	// ↑ any of them: less saving; ↓ longer battery life, less lively scene.
+	static constexpr Limits THROTTLED = { 30.0f, 0.6f, 2 };
+
+	// Seconds between polls of the source. ↑ cheaper; ↓ reacts sooner.
+	static constexpr double POLL_SECONDS = 1.0;
+	// Other processes' CPU load that counts as high, and how long it must last
+	// before throttling. ↑ throttles only under heavier / longer load.
+	static constexpr float HIGH_LOAD = 0.85f;
+	static constexpr double HIGH_LOAD_SECONDS = 3.0;
+	// Load under which, held this long, throttling for load ends. Keep well
+	// below HIGH_LOAD (hysteresis). ↑ restores sooner; ↓ stays throttled longer.
+	static constexpr float LOW_LOAD = 0.6f;
+	static constexpr double LOW_LOAD_SECONDS = 10.0;
+
+private:
+	PowerSource& Source;
+	PowerSource::State LastState;
+	bool HasPolled = false;
+	double LastPollTime = 0.0;
+	bool LoadThrottled = false;
+	// Start of the current run of high (or, while throttled, low) load; < 0: none.
+	double LoadRunStart = -1.0;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+// PowerSource Class
+// Where a PowerPolicy reads the machine's power and load state from. The
+// Windows app reads the system (WindowsPowerSource); FixedPowerSource reports
+// whatever it was given, for headless runs and synthetic traces.
+class PowerSource
+{
+public:
+	struct State
+	{
+		bool OnBattery = false;    // running on battery power
+		bool BatterySaver = false; // the system's battery saver is on
+		// Share of the machine's CPU time (0-1) used by other processes since the
+		// previous Read; negative when unknown.
+		float OtherCpuLoad = -1.0f;
+	};
+
+	virtual ~PowerSource() = default;
+	virtual State Read() = 0;
+};
+
+class FixedPowerSource final : public PowerSource
+{
+public:
+	State Read() override { return Current; }
+	void Set(const State& state) { Current = state; }
+
+private:
+	State Current;
+};
@@ -0,0 +1,93 @@
+#include "QualityGovernor.h"
+
+#include <algorithm>
+
+namespace
+{
+	// Cheapest last. Particle count goes first (it scales both simulation and
+	// drawing), the snow-only knobs follow.
+	const QualityGovernor::Knobs LEVEL_KNOBS[QualityGovernor::LEVEL_COUNT] = {
+		{ 1.00f, 1.00f, 1, true },
+		{ 0.80f, 1.00f, 1, true },
+		{ 0.65f, 0.75f, 2, true },
+		{ 0.50f, 0.50f, 2, false },
+		{ 0.35f, 0.50f, 3, false },
+	};
+}
+
+QualityGovernor::QualityGovernor(const float frameSeconds) :
+	BudgetSeconds(frameSeconds * BUDGET_SHARE)
+{
+}
+
+void QualityGovernor::SetFramePeriod(const float frameSeconds)
+{
+	BudgetSeconds = frameSeconds * BUDGET_SHARE;
+	OverBudgetFrames = 0;
+	UnderBudgetFrames = 0;
+}
+
+void QualityGovernor::Reset()
+{
+	SmoothedSeconds = 0.0f;
+	HasSample = false;
+	Level = 0;
+	OverBudgetFrames = 0;
+	UnderBudgetFrames = 0;
+	CooldownFrames = 0;
+	UpgradeWaitFrames = UPGRADE_FRAMES;
+	FramesSinceUpgrade = -1;
+}
+
+const QualityGovernor::Knobs& QualityGovernor::KnobsForLevel(const int level)
+{
+	return LEVEL_KNOBS[std::clamp(level, 0, LEVEL_COUNT - 1)];
+}
+
+bool QualityGovernor::AddSample(const float simulateSeconds, const float drawSeconds)
+{
+	const float cost = (std::min)(simulateSeconds + drawSeconds, BudgetSeconds * SPIKE_CAP);
+	SmoothedSeconds = HasSample ? SmoothedSeconds + (cost - SmoothedSeconds) * SMOOTHING : cost;
+	HasSample = true;
+
+	if (FramesSinceUpgrade >= 0 && ++FramesSinceUpgrade > UpgradeWaitFrames)
+	{
+		// The last rise held: later ones need not wait longer.
+		FramesSinceUpgrade = -1;
+	}
+	if (CooldownFrames > 0)
+	{
+		--CooldownFrames;
+		return false;
+	}
+
+	OverBudgetFrames = SmoothedSeconds > BudgetSeconds ? OverBudgetFrames + 1 : 0;
+	UnderBudgetFrames = SmoothedSeconds < BudgetSeconds * UPGRADE_SHARE ? UnderBudgetFrames + 1 : 0;
+
+	if (OverBudgetFrames >= DOWNGRADE_FRAMES && Level < LEVEL_COUNT - 1)
+	{
+		if (FramesSinceUpgrade >= 0)
+		{
+			// The last rise was taken back: wait longer before the next one.
+			UpgradeWaitFrames = (std::min)(UpgradeWaitFrames * 2, MAX_UPGRADE_FRAMES);
+		}
+		FramesSinceUpgrade = -1;
+		ChangeLevel(Level + 1);
+		return true;
+	}
+	if (UnderBudgetFrames >= UpgradeWaitFrames && Level > 0)
+	{
+		FramesSinceUpgrade = 0;
+		ChangeLevel(Level - 1);
+		return true;
+	}
+	return false;
+}
+
+void QualityGovernor::ChangeLevel(const int level)
+{
+	Level = level;
+	OverBudgetFrames = 0;
+	UnderBudgetFrames = 0;
+	CooldownFrames = COOLDOWN_FRAMES;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+// QualityGovernor Class
+// Keeps one display's per-frame cost inside its frame budget by trading
+// detail for time. It is fed one timing sample per drawn frame (seconds spent
+// simulating and drawing it) and answers with a quality level: 0 is full
+// detail, each level above it is cheaper (see Knobs). The level drops as soon
+// as the smoothed cost stays over budget, and rises again only after the cost
+// has stayed well under budget for a while, waiting longer each time a rise
+// had to be taken back, so it settles instead of oscillating. Pure logic with
+// no clock of its own: the same trace of samples always gives the same levels.
+class QualityGovernor
+{
+public:
+	// What a level costs, for the simulation and the renderers to apply.
+	struct Knobs
+	{
+		float ParticleScale;     // share of MaxParticles actually simulated
+		float NoiseRefreshScale; // share of the nominal snow-noise refresh rate
+		int SettleInterval;      // settle / smooth the heap every this many updates
+		bool SmoothTrails;       // antialiased rain trails (aliased are cheaper)
+	};
+
+	static constexpr int LEVEL_COUNT = 5;
+
+	// frameSeconds: the display's refresh period (see SetFramePeriod).
+	explicit QualityGovernor(float frameSeconds = 1.0f / 60.0f);
+
+	// The refresh period the budget is a share of. Keeps the level.
+	void SetFramePeriod(float frameSeconds);
+	// Back to full detail with no history (e.g. after a device or scene reset).
+	void Reset();
+
+	// One drawn frame's cost. Returns true if the level changed.
+	bool AddSample(float simulateSeconds, float drawSeconds);
+
+	int GetLevel() const { return Level; }
+	const Knobs& GetKnobs() const { return KnobsForLevel(Level); }
+	static const Knobs& KnobsForLevel(int level);
+	float GetBudgetSeconds() const { return BudgetSeconds; }
+	float GetSmoothedSeconds() const { return SmoothedSeconds; }
+
+	// Share of the refresh period the simulation and drawing may take; the rest
+	// is left to composition, other displays and the system.
+	// ↑ holds full detail longer; ↓ sheds detail sooner, more headroom.
+	static constexpr float BUDGET_SHARE = 0.75f;
+	// Weight of the newest sample in the smoothed cost (exponential average).
+	// ↑ reacts to spikes faster; ↓ steadier, slower to react.
+	static constexpr float SMOOTHING = 0.1f;
+	// Samples are capped at this many budgets first, so a lone hitch (a page
+	// fault, a window switch) cannot drag the average over budget by itself.
+	// ↑ trusts single slow frames more; ↓ needs a longer overload to react.
+	static constexpr float SPIKE_CAP = 2.0f;
+	// Consecutive frames over budget before dropping a level.
+	// ↑ rides out longer spikes; ↓ sheds detail sooner.
+	static constexpr int DOWNGRADE_FRAMES = 15;
+	// The smoothed cost must stay under this share of the budget to raise the
+	// level: the gap to 1 is the hysteresis. ↑ recovers detail sooner but may
+	// bounce; ↓ recovers only with ample headroom.
+	static constexpr float UPGRADE_SHARE = 0.6f;
+	// Consecutive frames under UPGRADE_SHARE before raising a level, doubled
+	// (up to MAX_UPGRADE_FRAMES) whenever a raised level is dropped again
+	// within that many frames. ↑ more cautious recovery; ↓ faster recovery.
+	static constexpr int UPGRADE_FRAMES = 120;
+	static constexpr int MAX_UPGRADE_FRAMES = 1920;
+	// Frames ignored after a level change while the smoothed cost catches up
+	// with the new level. ↑ fewer double steps; ↓ quicker follow-up steps.
+	static constexpr int COOLDOWN_FRAMES = 30;
+
+private:
+	float BudgetSeconds;
+	float SmoothedSeconds = 0.0f;
+	bool HasSample = false;
+	int Level = 0;
+	int OverBudgetFrames = 0;
+	int UnderBudgetFrames = 0;
+	int CooldownFrames = 0;
+	int UpgradeWaitFrames = UPGRADE_FRAMES;
+	int FramesSinceUpgrade = -1; // -1: the last change was not a rise
+
+	void ChangeLevel(int level);
+};
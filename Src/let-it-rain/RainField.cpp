@@ -0,0 +1,257 @@
+#include "RainField.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "BitUtil.h"
+#include "MathUtil.h"
+#include "RainKernel.h"
+#include "RandomGenerator.h"
+#include "WorkerPool.h"
+
+void RainField::Spawn(const int count, const int windDirectionFactor, SimulationData* pSimData)
+{
+	if (count <= 0) return;
+
+	const size_t first = State.size();
+	Resize(first + static_cast<size_t>(count));
+
+	// Velocity depends only on the current wind and DPI, so it (and the unit
+	// trail direction derived from it) is the same for every drop of this batch.
+	const float velX = WIND_MULTIPLIER * windDirectionFactor * pSimData->ScaleFactor;
+	const float velY = TERMINAL_VELOCITY_Y * pSimData->ScaleFactor;
+	const float velMag = std::sqrt(velX * velX + velY * velY);
+
+	const int xWidenToAccountForSlant = pSimData->Width / 3;
+	const float trailDirX = velX / velMag;
+	const float trailDirY = velY / velMag;
+	for (size_t i = first; i < State.size(); ++i)
+	{
+		VelX[i] = velX;
+		VelY[i] = velY;
+		TrailDirX[i] = trailDirX;
+		TrailDirY[i] = trailDirY;
+		State[i] = Falling;
+	}
+
+	// Random attributes are drawn a column at a time into one scratch array.
+	RandomGenerator& rng = pSimData->RainRng;
+	RandomScratch.resize(static_cast<size_t>(count));
+	int* const roll = RandomScratch.data();
+
+	// Randomize x position
+	rng.FillInt(roll, count, pSimData->SceneRect.left - xWidenToAccountForSlant,
+	            pSimData->SceneRect.right + xWidenToAccountForSlant);
+	for (int k = 0; k < count; ++k) PosX[first + k] = static_cast<float>(roll[k]);
+
+	// Randomize y position
+	rng.FillInt(roll, count, pSimData->SceneRect.top - pSimData->Height / 2, pSimData->SceneRect.top);
+	for (int k = 0; k < count; ++k) PosY[first + k] = static_cast<float>((roll[k] / 10) * 10);
+	std::copy(PosX.begin() + first, PosX.end(), PrevPosX.begin() + first);
+	std::copy(PosY.begin() + first, PosY.end(), PrevPosY.begin() + first);
+
+	// Create drop with radius ranging from 0.2 to 0.7 pixels
+	rng.FillInt(roll, count, 2, 7);
+	for (int k = 0; k < count; ++k)
+	{
+		Radius[first + k] = (roll[k] / 10.0f) * pSimData->ScaleFactor;
+		ProbeOffsetY[first + k] = Radius[first + k];
+	}
+
+	// Initialize length of the rain drop trail
+	rng.FillInt(roll, count, 30, 100);
+	for (int k = 0; k < count; ++k) TrailLength[first + k] = roll[k] * pSimData->ScaleFactor;
+}
+
+void RainField::UpdatePositions(const float deltaSeconds, SimulationData* pSimData)
+{
+	// Splatters first, so the bursts created by this frame's landings start
+	// moving on the next frame (as they did when each drop owned its burst).
+	pSimData->Splatters.Update(deltaSeconds, pSimData);
+
+	// Integrate every drop in one batched pass; it also flags the drops whose
+	// probe point crossed the ground this frame. Large fields are split into
+	// chunks on the WorkerPool; chunks cover whole mask words, so none share one.
+	const float bottom = static_cast<float>(pSimData->SceneRect.bottom);
+	const size_t count = State.size();
+	GroundMask.resize((count + 63) / 64);
+	const auto integrateRange = [&](const size_t begin, const size_t end)
+	{
+		std::copy(PosX.begin() + begin, PosX.begin() + end, PrevPosX.begin() + begin);
+		std::copy(PosY.begin() + begin, PosY.begin() + end, PrevPosY.begin() + begin);
+		RainKernel::IntegrateDrops(PosX.data() + begin, PosY.data() + begin, VelX.data() + begin,
+		                           VelY.data() + begin, ProbeOffsetY.data() + begin, end - begin, deltaSeconds,
+		                           bottom, GroundMask.data() + begin / 64);
+	};
+	const size_t chunks = (count + PARALLEL_CHUNK_DROPS - 1) / PARALLEL_CHUNK_DROPS;
+	if (pSimData->ParallelUpdate && chunks > 1)
+	{
+		pSimData->GetWorkers().ParallelFor(chunks, [&](const size_t c)
+		{
+			const size_t begin = c * PARALLEL_CHUNK_DROPS;
+			integrateRange(begin, (std::min)(begin + PARALLEL_CHUNK_DROPS, count));
+		});
+	}
+	else
+	{
+		integrateRange(0, count);
+	}
+
+	// Only the flagged drops change state.
+	Landings.clear();
+	for (size_t word = 0; word < GroundMask.size(); ++word)
+	{
+		for (uint64_t bits = GroundMask[word]; bits != 0; bits &= bits - 1)
+		{
+			const size_t i = word * 64 + static_cast<size_t>(BitUtil::CountTrailingZeros(bits));
+			if (State[i] == Falling)
+			{
+				PosY[i] = bottom;
+				const Vector2 landingPos(PosX[i], PosY[i]);
+				if (MathUtil::IsPointInRect(pSimData->SceneRect, landingPos))
+				{
+					// if the rain touched ground inside bounds, create splatter.
+					State[i] = Landed;
+					ProbeOffsetY[i] = -TrailLength[i] * TrailDirY[i];
+					Landings.push_back(landingPos);
+				}
+				else
+				{
+					State[i] = Dead;
+				}
+			}
+			else
+			{
+				// The whole trail has sunk below the ground, so nothing is left to draw.
+				State[i] = Dead;
+			}
+		}
+	}
+	// Splatters for all of this frame's landings, in landing order.
+	CreateSplatters(pSimData);
+}
+
+void RainField::CreateSplatters(SimulationData* pSimData)
+{
+	if (Landings.empty()) return;
+
+	// Draw every splatter's angle and size for this frame's landings in two bulk fills.
+	const size_t count = Landings.size() * MAX_SPLATTER_PER_RAINDROP_;
+	RandomScratch.resize(count * 2);
+	int* const angles = RandomScratch.data();
+	int* const sizes = angles + count;
+	pSimData->SplatterRng.FillInt(angles, count, 20, 70, 110, 160);
+	pSimData->SplatterRng.FillInt(sizes, count, 15, 25);
+
+	size_t k = 0;
+	for (const Vector2& landingPos : Landings)
+	{
+		for (int i = 0; i < MAX_SPLATTER_PER_RAINDROP_; i++, k++)
+		{
+			const float angleBounceRadians = angles[k] * (3.14f / 180.0f);
+
+			// Calculate velocity components
+			const Vector2 velSplatter(SPLATTER_STARTING_VELOCITY * std::cos(angleBounceRadians) * pSimData->ScaleFactor,
+			                          -SPLATTER_STARTING_VELOCITY * std::sin(angleBounceRadians) * pSimData->ScaleFactor);
+
+			// Create splatters with radius ranging from 1.0 to 2.0 pixels
+			const float radius = (sizes[k] / 10.0f) * pSimData->ScaleFactor;
+
+			pSimData->Splatters.Emit(landingPos, velSplatter, radius);
+		}
+	}
+}
+
+int RainField::RemoveDead()
+{
+	// Remove expired raindrops (swap-and-pop) and, in the same pass, count the
+	// still-falling survivors. A kept element passes through the else-branch
+	// exactly once, so the tally is exact.
+	int countOfFallingDrops = 0;
+	size_t count = State.size();
+	for (size_t i = 0; i < count; )
+	{
+		if (State[i] == Dead)
+		{
+			// Move last element into position i; do not increment i so the
+			// moved element is re-evaluated.
+			--count;
+			if (i != count)
+			{
+				MoveDrop(count, i);
+			}
+		}
+		else
+		{
+			if (State[i] == Falling)
+			{
+				countOfFallingDrops++;
+			}
+			++i;
+		}
+	}
+	Resize(count);
+	return countOfFallingDrops;
+}
+
+void RainField::Truncate(const size_t count)
+{
+	if (count < State.size())
+	{
+		Resize(count);
+	}
+}
+
+void RainField::Clear()
+{
+	Resize(0);
+}
+
+void RainField::Reserve(const size_t count)
+{
+	PosX.reserve(count);
+	PosY.reserve(count);
+	VelX.reserve(count);
+	VelY.reserve(count);
+	Radius.reserve(count);
+	State.reserve(count);
+	ProbeOffsetY.reserve(count);
+	GroundMask.reserve((count + 63) / 64);
+	TrailLength.reserve(count);
+	TrailDirX.reserve(count);
+	TrailDirY.reserve(count);
+	PrevPosX.reserve(count);
+	PrevPosY.reserve(count);
+}
+
+void RainField::MoveDrop(const size_t from, const size_t to)
+{
+	PosX[to] = PosX[from];
+	PosY[to] = PosY[from];
+	VelX[to] = VelX[from];
+	VelY[to] = VelY[from];
+	Radius[to] = Radius[from];
+	State[to] = State[from];
+	ProbeOffsetY[to] = ProbeOffsetY[from];
+	TrailLength[to] = TrailLength[from];
+	TrailDirX[to] = TrailDirX[from];
+	TrailDirY[to] = TrailDirY[from];
+	PrevPosX[to] = PrevPosX[from];
+	PrevPosY[to] = PrevPosY[from];
+}
+
+void RainField::Resize(const size_t count)
+{
+	PosX.resize(count);
+	PosY.resize(count);
+	VelX.resize(count);
+	VelY.resize(count);
+	Radius.resize(count);
+	State.resize(count);
+	ProbeOffsetY.resize(count);
+	TrailLength.resize(count);
+	TrailDirX.resize(count);
+	TrailDirY.resize(count);
+	PrevPosX.resize(count);
+	PrevPosY.resize(count);
+}
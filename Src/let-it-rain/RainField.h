@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "SimulationData.h"
+#include "Vector2.h"
+
+// RainField Class
+// All raindrops of one display, stored as a structure of arrays: each per-drop
+// attribute lives in its own contiguous column, so the per-frame update is a
+// linear streaming pass over a few float arrays with no per-drop objects,
+// back-pointers or inner vectors. Landing drops emit their splatters into the
+// display's shared SplatterPool.
+class RainField
+{
+public:
+	RainField() = default;
+
+	// Movable but not copyable (a field is owned by exactly one display)
+	RainField(RainField&&) noexcept = default;
+	RainField& operator=(RainField&&) noexcept = default;
+	RainField(const RainField&) = delete;
+	RainField& operator=(const RainField&) = delete;
+
+	// Append `count` fresh drops above the scene.
+	void Spawn(int count, int windDirectionFactor, SimulationData* pSimData);
+	// Integrate every drop and splatter by deltaSeconds; landing drops emit
+	// splatters into pSimData->Splatters (all at once, after the integration).
+	void UpdatePositions(float deltaSeconds, SimulationData* pSimData);
+	// Swap-and-pop every dead drop and return how many of the survivors are
+	// still falling (landed drops no longer count toward the target density).
+	int RemoveDead();
+	// Pop drops from the back until at most `count` remain.
+	void Truncate(size_t count);
+	void Clear();
+	void Reserve(size_t count);
+	size_t Size() const { return State.size(); }
+
+	// Splatter-pool slots that let every one of `dropCount` drops have a live
+	// burst at once. A drop's fall takes well over a burst's lifetime, so this
+	// leaves ample headroom; past it the pool recycles the oldest bursts.
+	static size_t SplatterCapacity(const size_t dropCount) { return dropCount * MAX_SPLATTER_PER_RAINDROP_; }
+
+	// Read-only view for the renderers. The trail runs from GetTrailStart(i) to
+	// GetPosition(i) (the drop head), stroked GetRadius(i) wide.
+	Vector2 GetPosition(const size_t i) const { return Vector2(PosX[i], PosY[i]); }
+	// The head before the last UpdatePositions (GetPosition for a new drop).
+	Vector2 GetPreviousPosition(const size_t i) const { return Vector2(PrevPosX[i], PrevPosY[i]); }
+	Vector2 GetTrailStart(const size_t i) const
+	{
+		return Vector2(PosX[i] - TrailLength[i] * TrailDirX[i], PosY[i] - TrailLength[i] * TrailDirY[i]);
+	}
+	float GetRadius(const size_t i) const { return Radius[i]; }
+
+	// Raindrop count per Intensity unit. Public because
+	// DisplayWindow::UpdateRainDrops uses it to size the drop pool.
+	// ↑ denser rain per intensity step (more drops, more CPU/GPU); ↓ sparser.
+	static constexpr int RAIN_DROP_MULTIPLIER = 3;
+
+private:
+	enum DropState : uint8_t
+	{
+		Falling, // still in the air
+		Landed,  // hit the ground; trail is sinking out of view
+		Dead     // ready for erase
+	};
+
+	// Droplets thrown up per landing. ↑ bushier splash; ↓ sparser.
+	static constexpr int MAX_SPLATTER_PER_RAINDROP_ = 3;
+
+	// Drop fall speed (px/s). ↑ faster, straighter rain; ↓ slower, more wind-blown.
+	static constexpr float TERMINAL_VELOCITY_Y = 1000;
+	// Horizontal wind velocity per wind-direction unit (px/s).
+	// ↑ stronger slant at the slider extremes; ↓ gentler.
+	static constexpr float WIND_MULTIPLIER = 75;
+
+	// Drops per task of the parallel integration (SimulationData::ParallelUpdate);
+	// a multiple of 64 so chunks own whole GroundMask words.
+	// ↑ less scheduling overhead; ↓ better balance.
+	static constexpr size_t PARALLEL_CHUNK_DROPS = 4096;
+	static_assert(PARALLEL_CHUNK_DROPS % 64 == 0, "chunks must cover whole mask words");
+
+	// Splatter launch speed (px/s). ↑ higher & wider splash; ↓ smaller pop.
+	static constexpr float SPLATTER_STARTING_VELOCITY = 200.0f;
+
+	// Hot columns, touched by every update.
+	std::vector<float> PosX;
+	std::vector<float> PosY;
+	std::vector<float> VelX;
+	std::vector<float> VelY;
+	std::vector<float> Radius;
+	std::vector<uint8_t> State;
+	// Offset from PosY to the point whose crossing of the ground line triggers the
+	// drop's next state change: +Radius while falling (landing), and minus the
+	// trail's vertical extent once landed (trail fully sunk). Lets one batched
+	// ground test cover both transitions.
+	std::vector<float> ProbeOffsetY;
+
+	// Draw-only columns. TrailDir is the unit travel direction, cached at spawn
+	// because velocity is constant for a drop's lifetime (no per-frame sqrt).
+	std::vector<float> TrailLength;
+	std::vector<float> TrailDirX;
+	std::vector<float> TrailDirY;
+	// Head before the last integration, for drawing in between two updates.
+	std::vector<float> PrevPosX;
+	std::vector<float> PrevPosY;
+
+	// Per-frame scratch: one bit per drop whose probe crossed the ground.
+	std::vector<uint64_t> GroundMask;
+	// Per-frame scratch: where this frame's drops landed, and bulk random draws
+	// for spawns and splatters. Capacity is kept between frames.
+	std::vector<Vector2> Landings;
+	std::vector<int> RandomScratch;
+
+	void CreateSplatters(SimulationData* pSimData);
+	void MoveDrop(size_t from, size_t to);
+	void Resize(size_t count);
+};
@@ -0,0 +1,140 @@
+#include "RainKernel.h"
+
+#if defined(LIR_ARCH_X86)
+#include <immintrin.h>
+#elif defined(LIR_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+	// Every implementation integrates one 64-drop block and returns its mask word.
+	using BlockFn = uint64_t (*)(float* posX, float* posY, const float* velX, const float* velY,
+	                             const float* probeOffsetY, size_t n, float dt, float groundY);
+
+	uint64_t IntegrateTail(float* posX, float* posY, const float* velX, const float* velY,
+	                       const float* probeOffsetY, const size_t begin, const size_t n, const float dt,
+	                       const float groundY)
+	{
+		uint64_t bits = 0;
+		for (size_t i = begin; i < n; ++i)
+		{
+			posX[i] = posX[i] + velX[i] * dt;
+			posY[i] = posY[i] + velY[i] * dt;
+			if (posY[i] + probeOffsetY[i] >= groundY)
+			{
+				bits |= uint64_t{1} << i;
+			}
+		}
+		return bits;
+	}
+
+	uint64_t IntegrateBlockScalar(float* posX, float* posY, const float* velX, const float* velY,
+	                              const float* probeOffsetY, const size_t n, const float dt, const float groundY)
+	{
+		return IntegrateTail(posX, posY, velX, velY, probeOffsetY, 0, n, dt, groundY);
+	}
+
+#if defined(LIR_ARCH_X86)
+	LIR_TARGET_SSE2
+	uint64_t IntegrateBlockSse2(float* posX, float* posY, const float* velX, const float* velY,
+	                            const float* probeOffsetY, const size_t n, const float dt, const float groundY)
+	{
+		const __m128 vdt = _mm_set1_ps(dt);
+		const __m128 vground = _mm_set1_ps(groundY);
+		uint64_t bits = 0;
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const __m128 px = _mm_add_ps(_mm_loadu_ps(posX + i), _mm_mul_ps(_mm_loadu_ps(velX + i), vdt));
+			const __m128 py = _mm_add_ps(_mm_loadu_ps(posY + i), _mm_mul_ps(_mm_loadu_ps(velY + i), vdt));
+			_mm_storeu_ps(posX + i, px);
+			_mm_storeu_ps(posY + i, py);
+			const __m128 probe = _mm_add_ps(py, _mm_loadu_ps(probeOffsetY + i));
+			bits |= static_cast<uint64_t>(_mm_movemask_ps(_mm_cmpge_ps(probe, vground))) << i;
+		}
+		return bits | IntegrateTail(posX, posY, velX, velY, probeOffsetY, i, n, dt, groundY);
+	}
+
+	LIR_TARGET_AVX2
+	uint64_t IntegrateBlockAvx2(float* posX, float* posY, const float* velX, const float* velY,
+	                            const float* probeOffsetY, const size_t n, const float dt, const float groundY)
+	{
+		const __m256 vdt = _mm256_set1_ps(dt);
+		const __m256 vground = _mm256_set1_ps(groundY);
+		uint64_t bits = 0;
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256 px = _mm256_add_ps(_mm256_loadu_ps(posX + i), _mm256_mul_ps(_mm256_loadu_ps(velX + i), vdt));
+			const __m256 py = _mm256_add_ps(_mm256_loadu_ps(posY + i), _mm256_mul_ps(_mm256_loadu_ps(velY + i), vdt));
+			_mm256_storeu_ps(posX + i, px);
+			_mm256_storeu_ps(posY + i, py);
+			const __m256 probe = _mm256_add_ps(py, _mm256_loadu_ps(probeOffsetY + i));
+			bits |= static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(probe, vground, _CMP_GE_OQ))) << i;
+		}
+		return bits | IntegrateTail(posX, posY, velX, velY, probeOffsetY, i, n, dt, groundY);
+	}
+#endif
+
+#if defined(LIR_ARCH_ARM64)
+	uint64_t IntegrateBlockNeon(float* posX, float* posY, const float* velX, const float* velY,
+	                            const float* probeOffsetY, const size_t n, const float dt, const float groundY)
+	{
+		const float32x4_t vdt = vdupq_n_f32(dt);
+		const float32x4_t vground = vdupq_n_f32(groundY);
+		static const uint32_t laneBitsInit[4] = { 1, 2, 4, 8 };
+		const uint32x4_t laneBits = vld1q_u32(laneBitsInit);
+		uint64_t bits = 0;
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const float32x4_t px = vaddq_f32(vld1q_f32(posX + i), vmulq_f32(vld1q_f32(velX + i), vdt));
+			const float32x4_t py = vaddq_f32(vld1q_f32(posY + i), vmulq_f32(vld1q_f32(velY + i), vdt));
+			vst1q_f32(posX + i, px);
+			vst1q_f32(posY + i, py);
+			const float32x4_t probe = vaddq_f32(py, vld1q_f32(probeOffsetY + i));
+			const uint32x4_t hit = vandq_u32(vcgeq_f32(probe, vground), laneBits);
+			bits |= static_cast<uint64_t>(vaddvq_u32(hit)) << i;
+		}
+		return bits | IntegrateTail(posX, posY, velX, velY, probeOffsetY, i, n, dt, groundY);
+	}
+#endif
+
+	BlockFn SelectBlockFn(const SimdLevel level)
+	{
+		switch (level)
+		{
+#if defined(LIR_ARCH_X86)
+		case SimdLevel::Avx2: return IntegrateBlockAvx2;
+		case SimdLevel::Sse41:
+		case SimdLevel::Sse2: return IntegrateBlockSse2;
+#endif
+#if defined(LIR_ARCH_ARM64)
+		case SimdLevel::Neon: return IntegrateBlockNeon;
+#endif
+		default: return IntegrateBlockScalar;
+		}
+	}
+}
+
+void RainKernel::IntegrateDrops(float* posX, float* posY, const float* velX, const float* velY,
+                                const float* probeOffsetY, const size_t count, const float deltaSeconds,
+                                const float groundY, uint64_t* groundMask)
+{
+	IntegrateDrops(CpuFeatures::GetSimdLevel(), posX, posY, velX, velY, probeOffsetY, count, deltaSeconds,
+	               groundY, groundMask);
+}
+
+void RainKernel::IntegrateDrops(const SimdLevel level, float* posX, float* posY, const float* velX,
+                                const float* velY, const float* probeOffsetY, const size_t count,
+                                const float deltaSeconds, const float groundY, uint64_t* groundMask)
+{
+	const BlockFn block = SelectBlockFn(level);
+	for (size_t base = 0, word = 0; base < count; base += 64, ++word)
+	{
+		const size_t n = (count - base < 64) ? count - base : 64;
+		groundMask[word] = block(posX + base, posY + base, velX + base, velY + base, probeOffsetY + base, n,
+		                         deltaSeconds, groundY);
+	}
+}
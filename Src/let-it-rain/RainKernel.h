@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CpuFeatures.h"
+
+// Batched rain integration: advances N drops (Pos += Vel * dt) over the
+// RainField columns and, in the same pass, tests each drop's probe point
+// (PosY + probeOffsetY) against the ground line. The result is a bit mask,
+// one bit per drop in 64-drop words, so the follow-up landing pass only
+// visits the few drops whose bit is set.
+//
+// The AVX2 / SSE2 / NEON paths perform the scalar operations lane by lane (a
+// separate multiply and add per component, no FMA), so every level produces
+// the same positions and masks (bit-identical wherever the compiler does not
+// contract the scalar expression into an FMA, e.g. all x86 builds).
+class RainKernel
+{
+public:
+	// groundMask must hold (count + 63) / 64 words.
+	static void IntegrateDrops(float* posX, float* posY, const float* velX, const float* velY,
+	                           const float* probeOffsetY, size_t count, float deltaSeconds, float groundY,
+	                           uint64_t* groundMask);
+
+	// Same, with an explicit instruction set (must be supported by this CPU).
+	static void IntegrateDrops(SimdLevel level, float* posX, float* posY, const float* velX, const float* velY,
+	                           const float* probeOffsetY, size_t count, float deltaSeconds, float groundY,
+	                           uint64_t* groundMask);
+};
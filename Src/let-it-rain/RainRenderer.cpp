@@ -0,0 +1,163 @@
+#include "RainRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+void RainRenderer::Draw(RenderBackend& backend, const FrameGeometry& frame, const RenderBackend::Color& color,
+                        const bool smoothTrails)
+{
+	if (smoothTrails)
+	{
+		DrawStreaks(backend, frame.Trails, color);
+	}
+	else
+	{
+		backend.SetAntialiasing(false);
+		DrawTrails(backend, frame.Trails, color);
+		backend.SetAntialiasing(true);
+	}
+
+	DrawSplatters(backend, frame.Splatters, color);
+}
+
+void RainRenderer::DrawTrails(RenderBackend& backend, const std::vector<FrameGeometry::Trail>& trails,
+                              const RenderBackend::Color& color)
+{
+	if (trails.empty()) return;
+
+	// A trail is a line with flat ends: the quad spanned by its ends pushed half
+	// its width out to either side. Drawn on the render thread only, so the
+	// corners keep their capacity between frames.
+	static thread_local std::vector<Vector2> corners;
+	corners.clear();
+	for (const FrameGeometry::Trail& trail : trails)
+	{
+		const float dx = trail.End.x - trail.Start.x;
+		const float dy = trail.End.y - trail.Start.y;
+		const float length = std::sqrt(dx * dx + dy * dy);
+		if (length <= 0.0f) continue;
+
+		const float scale = trail.Width * 0.5f / length;
+		const float nx = -dy * scale;
+		const float ny = dx * scale;
+		corners.emplace_back(trail.Start.x + nx, trail.Start.y + ny);
+		corners.emplace_back(trail.End.x + nx, trail.End.y + ny);
+		corners.emplace_back(trail.End.x - nx, trail.End.y - ny);
+		corners.emplace_back(trail.Start.x - nx, trail.Start.y - ny);
+	}
+	backend.FillQuads(corners.data(), corners.size() / 4, color);
+}
+
+void RainRenderer::DrawStreaks(RenderBackend& backend, const std::vector<FrameGeometry::Trail>& trails,
+                               const RenderBackend::Color& color)
+{
+	if (trails.empty()) return;
+
+	constexpr RenderBackend::SpriteSheet sheet = RenderBackend::SpriteSheet::Streaks;
+	if (!backend.HasSpriteSheet(sheet))
+	{
+		backend.BuildSpriteSheet(sheet, STREAK_CELL_SIZE * STREAK_COUNT, STREAK_CELL_SIZE, [&color](RenderBackend& streaks)
+		{
+			for (int k = 0; k < STREAK_COUNT; ++k)
+			{
+				const float center = STREAK_CELL_SIZE * (static_cast<float>(k) + 0.5f);
+				const float half = STREAK_WIDTHS[k] * 0.5f;
+				const Vector2 bar[4] = { Vector2(center - half, 0.0f), Vector2(center + half, 0.0f),
+				                         Vector2(center + half, STREAK_CELL_SIZE), Vector2(center - half, STREAK_CELL_SIZE) };
+				streaks.FillPolygon(bar, 4, color);
+			}
+		});
+		if (!backend.HasSpriteSheet(sheet)) return;
+	}
+
+	// One run per streak width. A sprite's rectangle is the cell around the
+	// trail's axis (x across, y along, from 0 at Start to its length), scaled
+	// across so the bar gets the trail's width; the transform turns y onto the
+	// trail and moves 0 to Start. Scratch keeps its capacity (render thread only).
+	struct StreakRun
+	{
+		std::vector<RenderBackend::SpriteRect> Dests;
+		std::vector<RenderBackend::SpriteTransform> Transforms;
+		std::vector<float> Alphas;
+	};
+	static thread_local StreakRun runs[STREAK_COUNT];
+	for (StreakRun& run : runs)
+	{
+		run.Dests.clear();
+		run.Transforms.clear();
+		run.Alphas.clear();
+	}
+	for (const FrameGeometry::Trail& trail : trails)
+	{
+		const float dx = trail.End.x - trail.Start.x;
+		const float dy = trail.End.y - trail.Start.y;
+		const float length = std::sqrt(dx * dx + dy * dy);
+		if (length <= 0.0f || trail.Width <= 0.0f) continue;
+
+		const int k = StreakFor(trail.Width);
+		const float width = (std::max)(trail.Width, STREAK_WIDTHS[0]);
+		const float half = STREAK_CELL_SIZE * 0.5f * width / STREAK_WIDTHS[k];
+		const float ux = dx / length;
+		const float uy = dy / length;
+
+		StreakRun& run = runs[k];
+		run.Dests.push_back({ -half, 0.0f, half, length });
+		run.Transforms.push_back({ uy, -ux, ux, uy, trail.Start.x, trail.Start.y });
+		run.Alphas.push_back(trail.Width / width);
+	}
+
+	backend.BeginSprites(sheet);
+	constexpr float cellShare = 1.0f / STREAK_COUNT;
+	for (int k = 0; k < STREAK_COUNT; ++k)
+	{
+		const StreakRun& run = runs[k];
+		if (run.Dests.empty()) continue;
+		const float left = static_cast<float>(k) * cellShare;
+		backend.AddSprites({ left, 0.0f, left + cellShare, 1.0f }, run.Dests.data(), run.Transforms.data(),
+		                   run.Alphas.data(), run.Dests.size());
+	}
+	backend.EndSprites();
+}
+
+int RainRenderer::StreakFor(const float width)
+{
+	// Nearest width on a log scale: move up while past the geometric midpoint.
+	int k = 0;
+	while (k + 1 < STREAK_COUNT && width * width > STREAK_WIDTHS[k] * STREAK_WIDTHS[k + 1]) ++k;
+	return k;
+}
+
+void RainRenderer::DrawSplatters(RenderBackend& backend, const std::vector<FrameGeometry::Splat>& splatters,
+                                 const RenderBackend::Color& color)
+{
+	if (splatters.empty()) return;
+
+	constexpr RenderBackend::SpriteSheet sheet = RenderBackend::SpriteSheet::Splatter;
+	if (!backend.HasSpriteSheet(sheet))
+	{
+		const float center = SPLATTER_SPRITE_SIZE * 0.5f;
+		backend.BuildSpriteSheet(sheet, SPLATTER_SPRITE_SIZE, SPLATTER_SPRITE_SIZE, [&color, center](RenderBackend& disc)
+		{
+			disc.FillEllipse(Vector2(center, center), SPLATTER_DISC_RADIUS, SPLATTER_DISC_RADIUS, color);
+		});
+		if (!backend.HasSpriteSheet(sheet)) return;
+	}
+
+	// Each splatter's disc, sized so the drawn disc keeps the splatter's radius,
+	// faded by its opacity. Scratch keeps its capacity (render thread only).
+	static thread_local std::vector<RenderBackend::SpriteRect> dests;
+	static thread_local std::vector<float> alphas;
+	dests.clear();
+	alphas.clear();
+	constexpr float halfSizePerRadius = SPLATTER_SPRITE_SIZE * 0.5f / SPLATTER_DISC_RADIUS;
+	for (const FrameGeometry::Splat& splatter : splatters)
+	{
+		const float half = splatter.Radius * halfSizePerRadius;
+		dests.push_back({ splatter.Pos.x - half, splatter.Pos.y - half, splatter.Pos.x + half, splatter.Pos.y + half });
+		alphas.push_back(splatter.Alpha);
+	}
+
+	backend.BeginSprites(sheet);
+	backend.AddSprites({ 0.0f, 0.0f, 1.0f, 1.0f }, dests.data(), nullptr, alphas.data(), dests.size());
+	backend.EndSprites();
+}
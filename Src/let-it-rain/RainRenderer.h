@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "FrameGeometry.h"
+#include "RenderBackend.h"
+
+// RainRenderer Class
+// Drawing for a display's rain: drop trails and splatter bursts from a
+// FrameGeometry (already clipped to the scene, see FrameSnapshot::Interpolate),
+// through a RenderBackend. Each is one batched call: every trail a rotated,
+// stretched sprite of a pre-filtered streak (or an aliased quad of one
+// FillQuads), every splatter a faded sprite of a pre-colored disc. The
+// simulation types carry no drawing code, and neither does this, so both build
+// without Direct2D.
+class RainRenderer
+{
+public:
+	// smoothTrails: trails as streak sprites with filtered edges; otherwise as
+	// aliased quads (QualityGovernor).
+	static void Draw(RenderBackend& backend, const FrameGeometry& frame, const RenderBackend::Color& color,
+	                 bool smoothTrails);
+
+private:
+	// Disc sprite resolution (DIPs); the disc leaves a border for its antialiased edge.
+	// ↑ smoother large splatters, bigger sheet; ↓ blurrier.
+	static constexpr float SPLATTER_SPRITE_SIZE = 8.0f;
+	static constexpr float SPLATTER_DISC_RADIUS = 3.5f;
+
+	// Streak sheet: one STREAK_CELL_SIZE square cell per width, each a vertical
+	// antialiased bar spanning the cell's height, stretched along the trail when
+	// drawn. A trail samples the cell closest to its width, so the filtered
+	// edge is barely rescaled; trails thinner than the first are drawn at its
+	// width, faded by the ratio (same coverage).
+	// ↑ more widths: closer matches, bigger sheet; ↓ fewer: more rescaling.
+	static constexpr int STREAK_COUNT = 4;
+	static constexpr float STREAK_WIDTHS[STREAK_COUNT] = { 0.5f, 1.0f, 2.0f, 4.0f };
+	static constexpr float STREAK_CELL_SIZE = 8.0f;
+
+	static void DrawTrails(RenderBackend& backend, const std::vector<FrameGeometry::Trail>& trails,
+	                       const RenderBackend::Color& color);
+	static void DrawStreaks(RenderBackend& backend, const std::vector<FrameGeometry::Trail>& trails,
+	                        const RenderBackend::Color& color);
+	// Index of the streak drawn for a trail `width` wide.
+	static int StreakFor(float width);
+	static void DrawSplatters(RenderBackend& backend, const std::vector<FrameGeometry::Splat>& splatters,
+	                          const RenderBackend::Color& color);
+};
@@ -1,24 +1,87 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <random>
 
+// Independent random streams kept by every display, one per particle system.
+// Systems never share generator state, so one system's draws cannot shift
+// another's sequence, and each stream can be driven from its own thread.
+enum class RandomStream : uint32_t
+{
+	Rain,       // drop spawns
+	Splatter,   // splatter launch angles and sizes
+	Snow,       // flake spawns
+	SnowSettle  // per-pixel settled-snow flow
+};
+
+// RandomGenerator Class
+// Small seedable PRNG stream (xoshiro256**): 32 bytes of state, a handful of
+// integer ops per draw, and no distribution objects. A given seed always
+// reproduces the same sequence on every platform and compiler, which
+// std::mt19937 + std::uniform_*_distribution does not guarantee.
 class RandomGenerator
 {
 public:
-	// Delete copy constructor and assignment operator to prevent copying
-	RandomGenerator(const RandomGenerator&) = delete;
-	RandomGenerator& operator=(const RandomGenerator&) = delete;
+	RandomGenerator() { Seed(0); }
+	explicit RandomGenerator(const uint64_t seed) { Seed(seed); }
+
+	void Seed(uint64_t seed)
+	{
+		// Expand the 64-bit seed with SplitMix64, as recommended for xoshiro:
+		// never produces the all-zero state, and nearby seeds give unrelated streams.
+		for (uint64_t& word : State)
+		{
+			word = SplitMix64(seed);
+		}
+	}
+
+	// Seed of one display's stream. globalSeed 0 means "not reproducible":
+	// callers substitute MakeRandomSeed() before deriving streams from it.
+	static uint64_t StreamSeed(const uint64_t globalSeed, const uint32_t displayIndex, const RandomStream stream)
+	{
+		return MixSeed(globalSeed, static_cast<uint64_t>(displayIndex) << 32 | static_cast<uint32_t>(stream));
+	}
+
+	// Seed of sub-stream `key` of `seed` (e.g. one work tile of one frame), so
+	// parallel work draws the same numbers however it is scheduled.
+	static uint64_t MixSeed(const uint64_t seed, const uint64_t key)
+	{
+		uint64_t x = seed;
+		uint64_t mixed = SplitMix64(x) ^ key * 0xD6E8FEB86659FD93ull;
+		return SplitMix64(mixed);
+	}
+
+	// Fresh nondeterministic seed (never 0).
+	static uint64_t MakeRandomSeed()
+	{
+		std::random_device rd;
+		const uint64_t seed = static_cast<uint64_t>(rd()) << 32 | rd();
+		return seed != 0 ? seed : 1;
+	}
 
-	// Static method to get the singleton instance
-	static RandomGenerator& GetInstance()
+	uint64_t NextU64()
 	{
-		static RandomGenerator instance;
-		return instance;
+		const uint64_t result = RotateLeft(State[1] * 5, 7) * 9;
+		const uint64_t t = State[1] << 17;
+		State[2] ^= State[0];
+		State[3] ^= State[1];
+		State[1] ^= State[2];
+		State[0] ^= State[3];
+		State[2] ^= t;
+		State[3] = RotateLeft(State[3], 45);
+		return result;
 	}
 
+	uint32_t NextU32() { return static_cast<uint32_t>(NextU64() >> 32); }
+
+	// Uniform integer in [min, max] (both inclusive).
 	int GenerateInt(const int min, const int max)
 	{
-		return std::uniform_int_distribution<>(min, max)(gen);
+		// Multiply-shift range reduction: bias is at most range / 2^32, far below
+		// anything visible, and it needs no division or retry loop.
+		const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+		return static_cast<int>(min + static_cast<int64_t>((NextU32() * range) >> 32));
 	}
 
 	int GenerateInt(const int range1Min, const int range1Max, const int range2Min, const int range2Max)
@@ -26,25 +89,130 @@ public:
 		const int range1Size = range1Max - range1Min;
 		const int range2Size = range2Max - range2Min;
 		const int totalRangeSize = range1Size + range2Size;
-		const int choice = std::uniform_int_distribution<>(0, totalRangeSize)(gen);
+		const int choice = GenerateInt(0, totalRangeSize);
 		if (choice <= range1Size)
 		{
-			return std::uniform_int_distribution<>(range1Min, range1Max)(gen);
+			return GenerateInt(range1Min, range1Max);
 		}
-		return std::uniform_int_distribution<>(range2Min, range2Max)(gen);
+		return GenerateInt(range2Min, range2Max);
 	}
 
 	// Generate a floating point number in [min, max)
 	float GenerateFloat(const float min, const float max)
 	{
-		return std::uniform_real_distribution<float>(min, max)(gen);
+		// Top 24 bits -> [0, 1) with full float mantissa precision.
+		const float unit = static_cast<float>(NextU64() >> 40) * (1.0f / 16777216.0f);
+		return min + (max - min) * unit;
+	}
+
+	// Bulk versions of the above for spawn and settle loops. Raw bits are drawn
+	// a block at a time, then mapped to the range in a separate branch-free loop
+	// the compiler can vectorize; nothing is allocated.
+	void FillInt(int* out, const size_t count, const int min, const int max)
+	{
+		const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+		uint32_t raw[FILL_BLOCK];
+		for (size_t base = 0; base < count; base += FILL_BLOCK)
+		{
+			const size_t n = (count - base < FILL_BLOCK) ? count - base : FILL_BLOCK;
+			for (size_t i = 0; i < n; ++i) raw[i] = NextU32();
+			for (size_t i = 0; i < n; ++i)
+			{
+				out[base + i] = static_cast<int>(min + static_cast<int64_t>((raw[i] * range) >> 32));
+			}
+		}
+	}
+
+	// Uniform over the union of [range1Min, range1Max] and [range2Min, range2Max]
+	// (each value equally likely; one draw per element).
+	void FillInt(int* out, const size_t count, const int range1Min, const int range1Max, const int range2Min,
+	             const int range2Max)
+	{
+		const int range1Count = range1Max - range1Min + 1;
+		FillInt(out, count, 0, range1Count + (range2Max - range2Min));
+		const int range2Offset = range2Min - range1Count;
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] += out[i] < range1Count ? range1Min : range2Offset;
+		}
+	}
+
+	void FillFloat(float* out, const size_t count, const float min, const float max)
+	{
+		const float scale = (max - min) * (1.0f / 16777216.0f);
+		uint32_t raw[FILL_BLOCK];
+		for (size_t base = 0; base < count; base += FILL_BLOCK)
+		{
+			const size_t n = (count - base < FILL_BLOCK) ? count - base : FILL_BLOCK;
+			for (size_t i = 0; i < n; ++i) raw[i] = NextU32();
+			for (size_t i = 0; i < n; ++i)
+			{
+				out[base + i] = min + static_cast<float>(raw[i] >> 8) * scale;
+			}
+		}
 	}
 
 private:
-	RandomGenerator() : gen(rd())
+	static constexpr size_t FILL_BLOCK = 64;
+
+	uint64_t State[4];
+
+	static uint64_t RotateLeft(const uint64_t x, const int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+	static uint64_t SplitMix64(uint64_t& x)
+	{
+		uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+};
+
+// RandomBatch Class
+// A RandomGenerator that draws its numbers 256 at a time with FillFloat and
+// hands them out one by one. For call sites that need one number at a time
+// at irregular points (a flake respawning, a settled pixel deciding to flow)
+// but sit in hot loops: each call is an array read instead of a generator step.
+class RandomBatch
+{
+public:
+	void Seed(const uint64_t seed)
+	{
+		Rng.Seed(seed);
+		Next = BATCH_SIZE;
+	}
+
+	// Uniform in [0, 1).
+	float NextUnit()
+	{
+		if (Next == BATCH_SIZE)
+		{
+			Rng.FillFloat(Units, BATCH_SIZE, 0.0f, 1.0f);
+			Next = 0;
+		}
+		return Units[Next++];
+	}
+
+	// Uniform integer in [min, max] (both inclusive).
+	int GenerateInt(const int min, const int max)
 	{
+		const int value = min + static_cast<int>(NextUnit() * static_cast<float>(max - min + 1));
+		return value <= max ? value : max;
 	}
 
-	std::random_device rd;
-	std::mt19937 gen;
+	// Generate a floating point number in [min, max)
+	float GenerateFloat(const float min, const float max)
+	{
+		return min + (max - min) * NextUnit();
+	}
+
+private:
+	static constexpr size_t BATCH_SIZE = 256;
+
+	RandomGenerator Rng;
+	float Units[BATCH_SIZE];
+	size_t Next = BATCH_SIZE;
 };
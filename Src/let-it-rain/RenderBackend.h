@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "SnowField.h"
+#include "SnowRaster.h"
+#include "Vector2.h"
+
+// RenderBackend Class
+// The drawing primitives the particle renderers (RainRenderer, SnowRenderer)
+// are written against. D2DRenderBackend maps them onto a Direct2D target;
+// SoftwareRenderBackend rasterizes them on the CPU into a premultiplied BGRA
+// buffer, so every draw path also runs headless (golden images, benchmarks).
+// Coordinates are target pixels (DIPs on Direct2D).
+class RenderBackend
+{
+public:
+	// Straight (not premultiplied) 0-1 channels.
+	struct Color
+	{
+		float R, G, B, A;
+	};
+
+	virtual ~RenderBackend() = default;
+
+	// Antialiased edges for the lines, ellipses, polygons and quads drawn after this
+	// call; aliased edges are cheaper. On by default.
+	virtual void SetAntialiasing(bool enabled) = 0;
+	// Restrict drawing to an axis-aligned rectangle until the matching PopClip.
+	virtual void PushClip(float left, float top, float right, float bottom) = 0;
+	virtual void PopClip() = 0;
+
+	// A line `width` wide with flat ends.
+	virtual void DrawLine(Vector2 start, Vector2 end, float width, const Color& color) = 0;
+	virtual void FillEllipse(Vector2 center, float radiusX, float radiusY, const Color& color) = 0;
+	// A closed polygon (last point joins the first), filled even-odd.
+	virtual void FillPolygon(const Vector2* points, size_t count, const Color& color) = 0;
+
+	// Many same-colored quads (4 corners each, in order) filled in one call, as
+	// one shape with nonzero winding: where quads overlap, the color is applied
+	// once (also when translucent).
+	virtual void FillQuads(const Vector2* corners, size_t quadCount, const Color& color) = 0;
+
+	// Sprites come from sheets: images the renderers draw once, pre-colored,
+	// through the backend BuildSpriteSheet hands them (a transparent target of
+	// width x height), kept until ReleaseSpriteSheets (e.g. on a color change).
+	// Between BeginSprites and EndSprites, AddSprites queues sprites cut from
+	// `source` (in fractions of the sheet) and stretched to their destination
+	// rectangles, each optionally transformed (null: identity) and faded by its
+	// alpha (null: opaque); EndSprites draws them all in one batch.
+	using SpriteRect = SnowField::SpriteRect;
+	using SpriteTransform = SnowField::SpriteTransform;
+	enum class SpriteSheet
+	{
+		Flakes,   // 2x2 cells of the flake shapes (see SnowRenderer)
+		Splatter, // one disc (see RainRenderer)
+		Streaks,  // rain trail streaks at a few widths (see RainRenderer)
+	};
+	static constexpr int SPRITE_SHEET_COUNT = 3;
+
+	virtual bool HasSpriteSheet(SpriteSheet sheet) const = 0;
+	virtual void BuildSpriteSheet(SpriteSheet sheet, float width, float height,
+	                              const std::function<void(RenderBackend&)>& draw) = 0;
+	virtual void ReleaseSpriteSheets() = 0;
+	virtual void BeginSprites(SpriteSheet sheet) = 0;
+	virtual void AddSprites(const SpriteRect& source, const SpriteRect* dests, const SpriteTransform* transforms,
+	                        const float* alphas, size_t count) = 0;
+	virtual void EndSprites() = 0;
+
+	// The settled-snow image: the backend's persistent copy of a SnowRaster.
+	// ResizeImage returns true when the copy was (re)created or lost, so the
+	// caller has the raster redraw every row; UploadImageRows copies the rows of
+	// the raster's dirty spans. DrawImage draws the copy with its top-left
+	// corner at (left, top), one pixel per raster pixel.
+	virtual bool ResizeImage(int width, int height) = 0;
+	virtual void UploadImageRows(const SnowRaster& raster) = 0;
+	virtual void DrawImage(float left, float top) = 0;
+};
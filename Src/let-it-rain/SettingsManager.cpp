@@ -44,6 +44,14 @@ void SettingsManager::CreateINIFile() const
 		iniFilePath.c_str());
 	WritePrivateProfileString(L"Settings", L"SimpleSnowHeap", std::to_wstring(defaultSetting.SimpleSnowHeap).c_str(),
 		iniFilePath.c_str());
+	WritePrivateProfileString(L"Settings", L"RandomSeed", std::to_wstring(defaultSetting.RandomSeed).c_str(),
+		iniFilePath.c_str());
+	WritePrivateProfileString(L"Settings", L"SimulationRate", std::to_wstring(defaultSetting.SimulationRate).c_str(),
+		iniFilePath.c_str());
+	WritePrivateProfileString(L"Settings", L"AdaptiveQuality", std::to_wstring(defaultSetting.AdaptiveQuality).c_str(),
+		iniFilePath.c_str());
+	WritePrivateProfileString(L"Settings", L"ParallelUpdate", std::to_wstring(defaultSetting.ParallelUpdate).c_str(),
+		iniFilePath.c_str());
 }
 
 SettingsManager* SettingsManager::GetInstance()
@@ -83,6 +91,15 @@ void SettingsManager::ReadSettings(Setting& setting) const
 	setting.SimpleSnowHeap = GetPrivateProfileInt(L"Settings", L"SimpleSnowHeap", defaultSetting.SimpleSnowHeap,
 	                                              iniFilePath.c_str()) != 0;
 
+	setting.RandomSeed = GetPrivateProfileInt(L"Settings", L"RandomSeed", defaultSetting.RandomSeed,
+	                                          iniFilePath.c_str());
+	setting.SimulationRate = GetPrivateProfileInt(L"Settings", L"SimulationRate", defaultSetting.SimulationRate,
+	                                              iniFilePath.c_str());
+	setting.AdaptiveQuality = GetPrivateProfileInt(L"Settings", L"AdaptiveQuality", defaultSetting.AdaptiveQuality,
+	                                               iniFilePath.c_str()) != 0;
+	setting.ParallelUpdate = GetPrivateProfileInt(L"Settings", L"ParallelUpdate", defaultSetting.ParallelUpdate,
+	                                              iniFilePath.c_str()) != 0;
+
 	// Update missing values in INI file
 	WriteSettings(setting);
 }
@@ -102,6 +119,14 @@ void SettingsManager::WriteSettings(const Setting& setting) const
 		iniFilePath.c_str());
 	WritePrivateProfileString(L"Settings", L"SimpleSnowHeap", std::to_wstring(setting.SimpleSnowHeap).c_str(),
 		iniFilePath.c_str());
+	WritePrivateProfileString(L"Settings", L"RandomSeed", std::to_wstring(setting.RandomSeed).c_str(),
+		iniFilePath.c_str());
+	WritePrivateProfileString(L"Settings", L"SimulationRate", std::to_wstring(setting.SimulationRate).c_str(),
+		iniFilePath.c_str());
+	WritePrivateProfileString(L"Settings", L"AdaptiveQuality", std::to_wstring(setting.AdaptiveQuality).c_str(),
+		iniFilePath.c_str());
+	WritePrivateProfileString(L"Settings", L"ParallelUpdate", std::to_wstring(setting.ParallelUpdate).c_str(),
+		iniFilePath.c_str());
 }
 
 bool SettingsManager::IsStartupEnabled()
@@ -20,6 +20,19 @@ public:
 	bool StartWithWindows;
 	bool AllowHide;
 	bool SimpleSnowHeap;
+	// Global simulation seed (INI only). 0 = different every run; any other value
+	// makes every display's rain and snow reproducible from launch.
+	unsigned int RandomSeed = 0;
+	// Physics ticks per second (INI only), independent of the refresh rate;
+	// frames in between are drawn interpolated. 0 = one variable step per
+	// frame. ↑ finer physics, more CPU; ↓ less CPU on high-refresh monitors.
+	unsigned int SimulationRate = 60;
+	// Shed detail (particle count, snow noise and settling, trail smoothing)
+	// while a display misses its frame budget (INI only; see QualityGovernor).
+	bool AdaptiveQuality = true;
+	// Split large rain and snow updates over the cores (INI only; see
+	// SimulationData::ParallelUpdate). Off keeps each display's step on one core.
+	bool ParallelUpdate = true;
 
 	explicit Setting(const int maxParticles = 10,
 		const int windSpeed = 3,
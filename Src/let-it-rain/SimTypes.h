@@ -0,0 +1,28 @@
+#pragma once
+
+// Basic types shared by the platform-neutral simulation core (physics, heaps,
+// noise, RNG). On Windows they are the Win32 types themselves, so core and
+// Direct2D code exchange rectangles without conversion; elsewhere a layout-
+// compatible stand-in lets the core build headless (Linux CI, benchmarks).
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+struct RECT
+{
+	long left;
+	long top;
+	long right;
+	long bottom;
+};
+
+inline bool operator==(const RECT& l, const RECT& r)
+{
+	return l.left == r.left && l.top == r.top && l.right == r.right && l.bottom == r.bottom;
+}
+
+inline bool operator!=(const RECT& l, const RECT& r)
+{
+	return !(l == r);
+}
+#endif
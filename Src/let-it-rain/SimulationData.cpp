@@ -0,0 +1,105 @@
+#include "SimulationData.h"
+#include "SnowField.h"
+#include "WorkerPool.h"
+#include <algorithm>
+
+SimulationData::SimulationData()
+{
+	SeedRandomStreams(0, 0);
+}
+
+SimulationData::~SimulationData()
+{
+	// Members clean up automatically
+}
+
+WorkerPool& SimulationData::GetWorkers() const
+{
+	return Workers != nullptr ? *Workers : WorkerPool::GetInstance();
+}
+
+void SimulationData::SetSceneBounds(const RECT sceneRect, const float scaleFactor)
+{
+	const bool boundsChanged = !IsSame(SceneRect, sceneRect);
+
+	SceneRect = sceneRect;
+	ScaleFactor = scaleFactor;
+
+	SceneRectNorm.top = 0;
+	SceneRectNorm.left = 0;
+	SceneRectNorm.bottom = SceneRect.bottom - SceneRect.top;
+	SceneRectNorm.right = SceneRect.right - SceneRect.left;
+
+	Width = SceneRect.right - SceneRect.left;
+	Height = SceneRect.bottom - SceneRect.top;
+
+	// Per-column heightmap (simple mode): tiny, sized for every mode. Coarse
+	// columns (DPI-scaled) so each settled flake makes a discernible bump.
+	if (boundsChanged || ColumnHeights.empty())
+	{
+		SnowColumnWidth = (std::max)(1, static_cast<int>(SnowField::SNOW_COLUMN_WIDTH_BASE * ScaleFactor + 0.5f));
+		const int numColumns = (Width + SnowColumnWidth - 1) / SnowColumnWidth;
+		ColumnHeights.assign(numColumns, 0.0f);
+	}
+
+	// Per-pixel buffer: allocated only in per-pixel mode, freed in simple mode.
+	AllocateOrFreeScenePixels(boundsChanged);
+}
+
+void SimulationData::AllocateOrFreeScenePixels(const bool forceRealloc)
+{
+	if (SimpleSnowHeap)
+	{
+		// Simple (heightmap) mode never touches the per-pixel buffer — release it.
+		if (!ScenePixels.Empty())
+		{
+			ScenePixels.Release();
+		}
+		return;
+	}
+
+	// Per-pixel mode: (re)allocate a zeroed buffer on first use or bounds change.
+	if (forceRealloc || ScenePixels.Empty())
+	{
+		ScenePixels.Resize(Width, Height); // zero-initialized
+		MaxSnowHeight = Height - 2;
+	}
+}
+
+void SimulationData::ApplySnowHeapMode(const bool simple)
+{
+	SimpleSnowHeap = simple;
+	AllocateOrFreeScenePixels(false); // free (simple) or allocate (per-pixel)
+	ClearSnowAccumulation();          // reset so we never show a half-converted pile
+}
+
+void SimulationData::ClearSnowAccumulation()
+{
+	// Reset both heap representations so switching modes never shows a
+	// half-converted pile.
+	if (!ScenePixels.Empty())
+	{
+		ScenePixels.Clear();
+		MaxSnowHeight = Height - 2;
+	}
+	std::fill(ColumnHeights.begin(), ColumnHeights.end(), 0.0f);
+}
+
+void SimulationData::SeedRandomStreams(uint64_t globalSeed, const uint32_t displayIndex)
+{
+	if (globalSeed == 0)
+	{
+		globalSeed = RandomGenerator::MakeRandomSeed();
+	}
+	RainRng.Seed(RandomGenerator::StreamSeed(globalSeed, displayIndex, RandomStream::Rain));
+	SplatterRng.Seed(RandomGenerator::StreamSeed(globalSeed, displayIndex, RandomStream::Splatter));
+	SnowRng.Seed(RandomGenerator::StreamSeed(globalSeed, displayIndex, RandomStream::Snow));
+	SettleSeed = RandomGenerator::StreamSeed(globalSeed, displayIndex, RandomStream::SnowSettle);
+	SettleFrame = 0;
+}
+
+bool SimulationData::IsSame(const RECT& l, const RECT& r)
+{
+	return l.left == r.left && l.top == r.top &&
+		l.right == r.right && l.bottom == r.bottom;
+}
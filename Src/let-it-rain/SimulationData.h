@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "FlowField.h"
+#include "NoiseKernel.h"
+#include "RandomGenerator.h"
+#include "SimTypes.h"
+#include "SnowGrid.h"
+#include "SplatterPool.h"
+
+class WorkerPool;
+
+// Per-display simulation state: scene geometry, settled-snow heaps, the
+// splatter pool and the noise field. Platform-neutral (no Direct2D), so the
+// physics can be built and exercised headless; the Windows renderer extends it
+// with its device resources in DisplayData.
+class SimulationData
+{
+public:
+	SimulationData();
+	virtual ~SimulationData();
+
+	SimulationData(const SimulationData&) = delete;
+	SimulationData& operator=(const SimulationData&) = delete;
+
+	void SetSceneBounds(RECT sceneRect, float scaleFactor);
+	void ClearSnowAccumulation();
+	// Switch settle representation: frees the per-pixel buffer in simple mode,
+	// (re)allocates it in per-pixel mode, then clears the heap.
+	void ApplySnowHeapMode(bool simple);
+	// Seed every particle system's stream from (globalSeed, displayIndex). The
+	// same pair always reproduces the same simulation; globalSeed 0 picks a
+	// fresh random seed instead.
+	void SeedRandomStreams(uint64_t globalSeed, uint32_t displayIndex);
+
+	int Width = 100;
+	int Height = 100;
+	float ScaleFactor = 1.0f; // FullHD is considered as 1. 4K will be 2(twice height and width change).
+
+	RECT SceneRect = { 0, 0, 100, 100 };
+	RECT SceneRectNorm = { 0, 0, 100, 100 }; // normalized to left top as 0,0
+
+	// Split the per-frame particle updates of large rain and snow fields into
+	// chunks run on the shared WorkerPool (see RainField/SnowField). Results are
+	// identical either way; switchable at any time between frames (the display
+	// sets it from Setting::ParallelUpdate with each step).
+	bool ParallelUpdate = true;
+	// Pool the parallel passes run on; null means WorkerPool::GetInstance().
+	// Set to run with a given thread count (benchmarks).
+	WorkerPool* Workers = nullptr;
+	WorkerPool& GetWorkers() const;
+	// Share of the nominal snow-noise refresh rate (SnowField::RefreshNoise);
+	// lowered by the display's QualityGovernor under load.
+	float NoiseRefreshScale = 1.0f;
+
+	// Splatters from every landed raindrop on this display, in one pre-sized ring.
+	SplatterPool Splatters;
+
+	int MaxSnowHeight = 0;
+	SnowGrid ScenePixels; // per-pixel mode settled snow, one bit per pixel
+
+	// "Simple snow heap" mode: settled snow as a per-column height (pixels)
+	// instead of the per-pixel ScenePixels accumulation — O(Width) memory and
+	// per-frame cost. Selected at runtime via the settings checkbox.
+	bool SimpleSnowHeap = false;
+	std::vector<float> ColumnHeights;
+	int SnowColumnWidth = 1; // width in pixels of each ColumnHeights entry (DPI-scaled)
+
+	// 3D OpenSimplex2 noise driving the snow drift (evaluated in batches).
+	NoiseKernel::Params SnowNoise;
+	// Coarse keyframed copy of SnowNoise that falling flakes sample for drift.
+	FlowField SnowFlow;
+
+	// One independent stream per particle system (see RandomStream). Rain and
+	// splatters fill whole arrays per call; snow spawns draw one number at a
+	// time, so they are served from a bulk-filled batch.
+	RandomGenerator RainRng;
+	RandomGenerator SplatterRng;
+	RandomBatch SnowRng;
+	// The parallel settle pass derives one stream per tile per frame from
+	// SettleSeed and the frame count (see SnowField::SettleSnow).
+	uint64_t SettleSeed = 0;
+	uint64_t SettleFrame = 0;
+	// Settle pass scratch: this frame's active rows (bottom-up) and each tile's
+	// result flags per row. Capacity is kept between frames.
+	std::vector<int> SettleRows;
+	std::vector<uint8_t> SettleRowFlags;
+
+private:
+	// Allocate the per-pixel ScenePixels buffer in per-pixel mode, or free it in
+	// simple mode. forceRealloc re-creates it (e.g. after a scene-bounds change).
+	void AllocateOrFreeScenePixels(bool forceRealloc);
+	static bool IsSame(const RECT& l, const RECT& r);
+};
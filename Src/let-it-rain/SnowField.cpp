@@ -0,0 +1,730 @@
+#include "SnowField.h"
+#include "RandomGenerator.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+
+void SnowField::Spawn(const int count, SimulationData* pSimData)
+{
+	if (count <= 0) return;
+
+	const size_t first = Size();
+	Resize(first + static_cast<size_t>(count));
+	for (size_t i = first; i < Size(); ++i)
+	{
+		SpawnFlake(i, pSimData, false);
+	}
+}
+
+void SnowField::SpawnFlake(const size_t i, SimulationData* pSimData, const bool atTop)
+{
+	RandomBatch& rng = pSimData->SnowRng;
+	PosX[i] = rng.GenerateFloat(-SNOW_EDGE_MARGIN * pSimData->Width, (1.0f + SNOW_EDGE_MARGIN) * pSimData->Width);
+	PosY[i] = atTop ? -5.0f : rng.GenerateFloat(-pSimData->Height / 2.0f, pSimData->Height / 1.0f);
+	VelX[i] = 0.0f;
+	VelY[i] = rng.GenerateFloat(5.0f, 10.0f) * pSimData->ScaleFactor;
+
+	// Visual properties
+	Radius[i] = rng.GenerateFloat(SNOW_MIN_RADIUS, SNOW_MAX_RADIUS);
+	Rotation[i] = rng.GenerateFloat(0.0f, TWO_PI); // Random initial rotation (in radians)
+	RotationSpeed[i] = rng.GenerateFloat(-2.0f, 2.0f); // rad/s; matches macOS rotationSpeed
+	// Randomly choose a snowflake shape
+	const int shapeType = rng.GenerateInt(0, 100);
+	SnowflakeShape shape;
+	if (shapeType < 40) {
+		shape = SnowflakeShape::Simple; // 40% simple shapes
+	}
+	else if (shapeType < 70) {
+		shape = SnowflakeShape::Crystal; // 30% crystals
+	}
+	else if (shapeType < 90) {
+		shape = SnowflakeShape::Hexagon; // 20% hexagons
+	}
+	else {
+		shape = SnowflakeShape::Star; // 10% stars
+	}
+	Shape[i] = static_cast<uint8_t>(shape);
+	NoiseStale[i] = 1; // a respawned flake's old prediction belongs to where it was
+	// Nothing to draw in between: the flake appears where it spawned.
+	PrevPosX[i] = PosX[i];
+	PrevPosY[i] = PosY[i];
+	PrevRotation[i] = Rotation[i];
+}
+
+void SnowField::Truncate(const size_t count)
+{
+	if (count < Size()) Resize(count);
+}
+
+void SnowField::Clear()
+{
+	Resize(0);
+	NoiseCursor = 0;
+	NoiseBudget = 0.0f;
+}
+
+void SnowField::Reserve(const size_t count)
+{
+	PosX.reserve(count);
+	PosY.reserve(count);
+	VelX.reserve(count);
+	VelY.reserve(count);
+	Rotation.reserve(count);
+	RotationSpeed.reserve(count);
+	PrevPosX.reserve(count);
+	PrevPosY.reserve(count);
+	PrevRotation.reserve(count);
+	NoiseValue.reserve(count);
+	NoiseSlope.reserve(count);
+	NoiseAge.reserve(count);
+	NoiseStale.reserve(count);
+	Radius.reserve(count);
+	Shape.reserve(count);
+}
+
+void SnowField::Resize(const size_t count)
+{
+	PosX.resize(count);
+	PosY.resize(count);
+	VelX.resize(count);
+	VelY.resize(count);
+	Rotation.resize(count);
+	RotationSpeed.resize(count);
+	PrevPosX.resize(count);
+	PrevPosY.resize(count);
+	PrevRotation.resize(count);
+	NoiseValue.resize(count);
+	NoiseSlope.resize(count);
+	NoiseAge.resize(count);
+	NoiseStale.resize(count, 1);
+	Radius.resize(count);
+	Shape.resize(count);
+}
+
+float SnowField::ComputeNoiseTime(const double clockTime)
+{
+	return static_cast<float>(clockTime) * NOISE_TIMESCALE * 1000.0f;
+}
+
+void SnowField::AdvanceFlowField(SimulationData* pSimData, const float noiseTime)
+{
+	// The field covers the visible scene only; flakes in the off-screen margins
+	// read its nearest edge, which nobody can see.
+	pSimData->SnowFlow.Configure(0.0f, 0.0f, static_cast<float>(pSimData->Width), static_cast<float>(pSimData->Height),
+	                             FLOW_CELL_SIZE, ComputeNoiseTime(FLOW_KEYFRAME_SECONDS));
+	pSimData->SnowFlow.Advance(pSimData->SnowNoise, noiseTime);
+}
+
+void SnowField::RefreshNoise(const float deltaSeconds, const SimulationData* pSimData)
+{
+	const size_t count = Size();
+	if (count == 0) return;
+
+	// The whole array is due once per NOISE_REFRESH_SECONDS: every flake each
+	// frame at 60 Hz, a quarter of them per frame at 240 Hz.
+	const float refreshSeconds = NOISE_REFRESH_SECONDS / pSimData->NoiseRefreshScale;
+	size_t slice = count;
+	if (deltaSeconds < refreshSeconds)
+	{
+		NoiseBudget += static_cast<float>(count) * deltaSeconds / refreshSeconds;
+		slice = (std::min)(count, static_cast<size_t>(NoiseBudget));
+		NoiseBudget = (std::min)(NoiseBudget - static_cast<float>(slice), static_cast<float>(count));
+	}
+
+	// Flakes start, start + 1, ... wrapping at the end, each at most once.
+	const size_t start = NoiseCursor >= count ? 0 : NoiseCursor;
+	const auto sampleRange = [&](const size_t kBegin, const size_t kEnd)
+	{
+		for (size_t k = kBegin; k < kEnd; ++k)
+		{
+			const size_t i = start + k;
+			SampleNoise(i < count ? i : i - count, pSimData);
+		}
+	};
+	const size_t chunks = (slice + PARALLEL_CHUNK_FLAKES - 1) / PARALLEL_CHUNK_FLAKES;
+	if (pSimData->ParallelUpdate && chunks > 1)
+	{
+		pSimData->GetWorkers().ParallelFor(chunks, [&](const size_t c)
+		{
+			sampleRange(c * PARALLEL_CHUNK_FLAKES, (std::min)((c + 1) * PARALLEL_CHUNK_FLAKES, slice));
+		});
+	}
+	else
+	{
+		sampleRange(0, slice);
+	}
+	if (slice > 0)
+	{
+		NoiseCursor = start + slice > count ? start + slice - count : start + slice;
+	}
+}
+
+void SnowField::SampleNoise(const size_t i, const SimulationData* pSimData)
+{
+	const float sample = pSimData->SnowFlow.Sample(PosX[i], PosY[i]);
+	// The change since the previous sample carries the value forward until the
+	// next refresh; a new flake has no history yet, so it starts flat.
+	if (NoiseStale[i])
+	{
+		NoiseSlope[i] = 0.0f;
+	}
+	else if (NoiseAge[i] > 0.0f)
+	{
+		NoiseSlope[i] = (sample - NoiseValue[i]) / NoiseAge[i];
+	}
+	NoiseValue[i] = sample;
+	NoiseAge[i] = 0.0f;
+	NoiseStale[i] = 0;
+}
+
+void SnowField::UpdatePositions(const float deltaSeconds, SimulationData* pSimData)
+{
+	const size_t chunks = (Size() + PARALLEL_CHUNK_FLAKES - 1) / PARALLEL_CHUNK_FLAKES;
+	const bool parallel = pSimData->ParallelUpdate && chunks > 1;
+	if (pSimData->SimpleSnowHeap)
+	{
+		UpdateOnHeap(deltaSeconds, pSimData, chunks, parallel);
+	}
+	else
+	{
+		UpdateOnGrid(deltaSeconds, pSimData, chunks, parallel);
+	}
+}
+
+void SnowField::UpdateOnHeap(const float deltaSeconds, SimulationData* pSimData, const size_t chunks,
+                             const bool parallel)
+{
+	// Each chunk moves its flakes, adds the deposits of the ones that reached
+	// the heap (as it stood at the start of the frame) to its own per-column
+	// buffer, and lists the flakes to respawn. The buffers are then summed in
+	// chunk order and the cap applied once. Chunks have a fixed size, so the
+	// result is the same serially and for any thread count.
+	const size_t count = Size();
+	const size_t columns = pSimData->ColumnHeights.size();
+	ChunkLandings.resize(chunks);
+	ChunkDeposits.assign(chunks * columns, 0.0f);
+	const auto runChunk = [&](const size_t c)
+	{
+		const size_t begin = c * PARALLEL_CHUNK_FLAKES;
+		const size_t end = (std::min)(begin + PARALLEL_CHUNK_FLAKES, count);
+		MoveFlakes(begin, end, deltaSeconds, pSimData);
+
+		float* const deposits = ChunkDeposits.data() + c * columns;
+		std::vector<size_t>& landings = ChunkLandings[c];
+		landings.clear();
+		for (size_t i = begin; i < end; ++i)
+		{
+			if (LandOnHeap(i, pSimData, deposits)) landings.push_back(i);
+		}
+	};
+	if (parallel)
+	{
+		pSimData->GetWorkers().ParallelFor(chunks, runChunk);
+	}
+	else
+	{
+		for (size_t c = 0; c < chunks; ++c) runChunk(c);
+	}
+
+	const float maxHeight = pSimData->Height * SNOW_MAX_HEIGHT_FRACTION;
+	for (size_t col = 0; col < columns; ++col)
+	{
+		float deposit = 0.0f;
+		for (size_t c = 0; c < chunks; ++c) deposit += ChunkDeposits[c * columns + col];
+		if (deposit > 0.0f)
+		{
+			float& h = pSimData->ColumnHeights[col];
+			h = (std::min)(h + deposit, maxHeight);
+		}
+	}
+
+	// Respawns last, in flake order, so SnowRng is drawn in a fixed order.
+	for (const std::vector<size_t>& landings : ChunkLandings)
+	{
+		for (const size_t i : landings) SpawnFlake(i, pSimData, true);
+	}
+}
+
+void SnowField::UpdateOnGrid(const float deltaSeconds, SimulationData* pSimData, const size_t chunks,
+                             const bool parallel)
+{
+	const size_t count = Size();
+	if (!parallel)
+	{
+		// Motion first, for every flake; then landings, in flake order: each
+		// flake sees the snow settled by the ones before it, and respawns draw
+		// from SnowRng in a fixed order.
+		MoveFlakes(0, count, deltaSeconds, pSimData);
+		for (size_t i = 0; i < count; ++i) LandOnGrid(i, pSimData);
+		return;
+	}
+
+	// Parallel: each chunk moves its flakes and lists the ones that may land
+	// (or leave the scene) against the heap as it stands now. Only those can
+	// change anything, so the landings are then replayed serially for them
+	// alone, in flake order, with the same SnowRng draws as the serial path.
+	const int maxSnowHeight = pSimData->MaxSnowHeight;
+	ChunkLandings.resize(chunks);
+	pSimData->GetWorkers().ParallelFor(chunks, [&](const size_t c)
+	{
+		const size_t begin = c * PARALLEL_CHUNK_FLAKES;
+		const size_t end = (std::min)(begin + PARALLEL_CHUNK_FLAKES, count);
+		MoveFlakes(begin, end, deltaSeconds, pSimData);
+
+		std::vector<size_t>& landings = ChunkLandings[c];
+		landings.clear();
+		for (size_t i = begin; i < end; ++i)
+		{
+			if (MayLandOnGrid(i, pSimData, maxSnowHeight)) landings.push_back(i);
+		}
+	});
+
+	// A landing that raised the pile above the row the chunks tested against
+	// may bring later, unlisted flakes into reach: from there on every flake
+	// is checked, exactly as in the serial loop.
+	size_t resumeAt = count;
+	for (size_t c = 0; c < chunks && resumeAt == count; ++c)
+	{
+		for (const size_t i : ChunkLandings[c])
+		{
+			LandOnGrid(i, pSimData);
+			if (pSimData->MaxSnowHeight < maxSnowHeight)
+			{
+				resumeAt = i + 1;
+				break;
+			}
+		}
+	}
+	for (size_t i = resumeAt; i < count; ++i) LandOnGrid(i, pSimData);
+}
+
+void SnowField::MoveFlakes(const size_t begin, const size_t end, const float deltaSeconds,
+                           const SimulationData* pSimData)
+{
+	// Motion magnitudes are px-based, so DPI-scale them to keep the fall speed and
+	// drift resolution-independent (matches how rain scales its velocity).
+	const float scale = pSimData->ScaleFactor;
+	const float fall = GRAVITY * scale * deltaSeconds;
+	const float maxSpeed = MAX_SPEED * scale;
+
+	// Nothing here reads the heap or the RNG, so ranges are independent.
+	for (size_t i = begin; i < end; ++i)
+	{
+		PrevPosX[i] = PosX[i];
+		PrevPosY[i] = PosY[i];
+		PrevRotation[i] = Rotation[i];
+
+		if (NoiseStale[i])
+		{
+			SampleNoise(i, pSimData);
+		}
+		const float noiseVal = NoiseValue[i] + NoiseSlope[i] * NoiseAge[i];
+		NoiseAge[i] += deltaSeconds;
+		const float angle = noiseVal * TWO_PI + PI * 0.5f;
+
+		float velX = VelX[i] + (std::cos(angle) * NOISE_INTENSITY * scale * deltaSeconds) * 2.0f;
+		float velY = VelY[i] + std::sin(angle) * NOISE_INTENSITY * scale * deltaSeconds;
+		velY += fall;
+
+		const float speedSq = velX * velX + velY * velY;
+		if (speedSq > maxSpeed * maxSpeed)
+		{
+			const float speed = std::sqrt(speedSq);
+			velX = (velX / speed) * maxSpeed;
+			velY = (velY / speed) * maxSpeed;
+		}
+		VelX[i] = velX;
+		VelY[i] = velY;
+
+		Rotation[i] += RotationSpeed[i] * deltaSeconds;
+
+		PosX[i] += velX * deltaSeconds;
+		PosY[i] += velY * deltaSeconds;
+	}
+}
+
+bool SnowField::IsOutOfBounds(const size_t i, const SimulationData* pSimData) const
+{
+	return PosX[i] < -SNOW_EDGE_MARGIN * pSimData->Width || PosX[i] >= (1.0f + SNOW_EDGE_MARGIN) * pSimData->Width ||
+		PosY[i] < -pSimData->Height * 0.5f;
+}
+
+bool SnowField::MayLandOnGrid(const size_t i, const SimulationData* pSimData, const int maxSnowHeight) const
+{
+	// LandOnGrid acts on flakes that left the scene or are within a row of the
+	// highest settled snow.
+	return IsOutOfBounds(i, pSimData) || PosY[i] >= pSimData->Height ||
+		static_cast<int>(PosY[i]) + 1 >= maxSnowHeight;
+}
+
+bool SnowField::LandOnHeap(const size_t i, const SimulationData* pSimData, float* deposits) const
+{
+	// Heightmap settling: deposit into the flake's column when it reaches
+	// that column's surface; otherwise keep falling.
+	const float x = PosX[i];
+	const float y = PosY[i];
+	if (IsOutOfBounds(i, pSimData)) return true;
+
+	const int numCols = static_cast<int>(pSimData->ColumnHeights.size());
+	if (numCols > 0 && x >= 0.0f && x < static_cast<float>(pSimData->Width))
+	{
+		int col = static_cast<int>(x) / pSimData->SnowColumnWidth;
+		if (col >= numCols) col = numCols - 1;
+		const float surfaceY = pSimData->Height - pSimData->ColumnHeights[col];
+		if (y >= surfaceY)
+		{
+			deposits[col] += Radius[i] * SNOW_DEPOSIT_FACTOR * pSimData->ScaleFactor;
+			return true;
+		}
+		return false;
+	}
+	return y >= pSimData->Height; // fell past the bottom in the off-screen side margins
+}
+
+void SnowField::LandOnGrid(const size_t i, SimulationData* pSimData)
+{
+	if (PosX[i] < -SNOW_EDGE_MARGIN * pSimData->Width ||
+		PosX[i] >= (1.0f + SNOW_EDGE_MARGIN) * pSimData->Width ||
+		PosY[i] < -pSimData->Height * 0.5f ||
+		PosY[i] >= pSimData->Height)
+	{
+		if (PosX[i] >= 0 && PosX[i] < pSimData->Width && PosY[i] >= pSimData->Height)
+		{
+			const int x = PosX[i];
+			pSimData->ScenePixels.Set(x, pSimData->Height - 1);
+			pSimData->ScenePixels.MarkRowChanged(pSimData->Height - 1);
+		}
+		SpawnFlake(i, pSimData, true);
+		return; // respawned above the scene, clear of any snow
+	}
+
+	// If any of our neighboring pixels are filled, settle here. Rows above
+	// MaxSnowHeight are always empty (settling only moves snow down), so the
+	// many flakes still high in the air skip the neighbour test.
+	const int x = PosX[i];
+	const int y = PosY[i];
+	if (y + 1 < pSimData->MaxSnowHeight) return;
+
+	if (x >= 0 && x < pSimData->Width && y >= 0 && y < pSimData->Height)
+	{
+		for (int xOff = -1; xOff <= 1; ++xOff)
+		{
+			for (int yOff = -1; yOff <= 1; ++yOff)
+			{
+				if (IsSceneryPixelSet(pSimData, x + xOff, y + yOff))
+				{
+					if (!pSimData->ScenePixels.Get(x, y))
+					{
+						// Only settle if the pixel is empty
+						pSimData->ScenePixels.Set(x, y);
+						pSimData->ScenePixels.MarkRowChanged(y);
+						if (y < pSimData->MaxSnowHeight)
+						{
+							pSimData->MaxSnowHeight = y;
+						}
+					}
+					SpawnFlake(i, pSimData, true);
+					return;
+				}
+			}
+		}
+	}
+}
+
+void SnowField::BuildSprites(const RECT& visible, const float offsetX, const float offsetY,
+                             const float halfSizePerRadius, SpriteList& sprites, SpriteList* previous) const
+{
+	const float left = static_cast<float>(visible.left);
+	const float top = static_cast<float>(visible.top);
+	const float right = static_cast<float>(visible.right);
+	const float bottom = static_cast<float>(visible.bottom);
+	const auto isInside = [&](const float x, const float y)
+	{
+		return x >= left && x <= right && y >= top && y <= bottom;
+	};
+	const auto isVisible = [&](const size_t i)
+	{
+		return isInside(PosX[i], PosY[i]) || (previous != nullptr && isInside(PrevPosX[i], PrevPosY[i]));
+	};
+
+	// Count the visible flakes of each shape, so every group gets its own range.
+	const size_t count = Size();
+	size_t perShape[SHAPE_COUNT] = {};
+	for (size_t i = 0; i < count; ++i)
+	{
+		perShape[Shape[i]] += isVisible(i) ? 1 : 0;
+	}
+	size_t next[SHAPE_COUNT];
+	sprites.ShapeBegin[0] = 0;
+	for (int s = 0; s < SHAPE_COUNT; ++s)
+	{
+		next[s] = sprites.ShapeBegin[s];
+		sprites.ShapeBegin[s + 1] = sprites.ShapeBegin[s] + perShape[s];
+	}
+	sprites.Dests.resize(sprites.Size());
+	sprites.Transforms.resize(sprites.Size());
+	if (previous != nullptr)
+	{
+		std::copy(std::begin(sprites.ShapeBegin), std::end(sprites.ShapeBegin), std::begin(previous->ShapeBegin));
+		previous->Dests.resize(sprites.Size());
+		previous->Transforms.resize(sprites.Size());
+	}
+
+	// A square rotated about its centre c, i.e. p' = R p + (c - R c) in row-vector form.
+	const auto place = [&](SpriteList& list, const size_t k, const float x, const float y, const float rotation,
+	                       const float half)
+	{
+		const float cx = x + offsetX;
+		const float cy = y + offsetY;
+		list.Dests[k] = { cx - half, cy - half, cx + half, cy + half };
+
+		const float c = std::cos(rotation);
+		const float s = std::sin(rotation);
+		list.Transforms[k] = { c, s, -s, c, cx - cx * c + cy * s, cy - cx * s - cy * c };
+	};
+
+	// Place each visible flake at its group's next slot.
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (!isVisible(i)) continue;
+
+		const size_t k = next[Shape[i]]++;
+		const float half = Radius[i] * halfSizePerRadius;
+		place(sprites, k, PosX[i], PosY[i], Rotation[i], half);
+		if (previous != nullptr)
+		{
+			place(*previous, k, PrevPosX[i], PrevPosY[i], PrevRotation[i], half);
+		}
+	}
+}
+
+void SnowField::SmoothSnowHeap(SimulationData* pSimData)
+{
+	std::vector<float>& h = pSimData->ColumnHeights;
+	const int n = static_cast<int>(h.size());
+	if (n < 3) return;
+
+	// Volume-conserving diffusion (matches the macOS SnowSystem::smoothHeightMap):
+	// forward then backward, move a fraction of any adjacent-column excess above the
+	// threshold into the lower neighbour, so the pile relaxes into organic slopes
+	// while total settled snow is preserved (rather than a hard slope clamp).
+	const float threshold = SNOW_SMOOTH_THRESHOLD * pSimData->ScaleFactor;
+	for (int x = 1; x < n - 1; ++x)
+	{
+		const float diff = h[x] - h[x - 1];
+		if (diff > threshold) { const float f = diff * SNOW_SMOOTH_RATE; h[x] -= f; h[x - 1] += f; }
+	}
+	for (int x = n - 2; x >= 1; --x)
+	{
+		const float diff = h[x] - h[x + 1];
+		if (diff > threshold) { const float f = diff * SNOW_SMOOTH_RATE; h[x] -= f; h[x + 1] += f; }
+	}
+}
+
+bool SnowField::IsSceneryPixelSet(const SimulationData* pSimData, const int x, const int y)
+{
+	if (x < 0 || x >= pSimData->Width || y < 0 || y >= pSimData->Height) return false; // Out-of-bounds
+	return pSimData->ScenePixels.Get(x, y);
+}
+
+void SnowField::SettleSnow(SimulationData* pSimData)
+{
+	SnowGrid& grid = pSimData->ScenePixels;
+	const int height = grid.Height();
+
+	// Only rows that changed last frame (or next to one that did), took a
+	// landing flake, or still had a cell free to move are settled again; a pile
+	// that has come to rest costs nothing. Collected bottom-up.
+	std::vector<int>& rows = pSimData->SettleRows;
+	rows.clear();
+	for (int y = height - 2; y >= (std::max)(pSimData->MaxSnowHeight, 0); --y)
+	{
+		if (grid.IsSettleActive(y)) rows.push_back(y);
+	}
+	grid.ClearSettleActive();
+	if (rows.empty()) return;
+
+	// Settled snow physics, in tiles of whole grid words spread over the worker
+	// pool. A cell only touches its own column and the two beside it, so tiles
+	// two apart never touch the same word: run the even tiles in parallel, then
+	// the odd ones. A cell an even tile moves across its edge lands in an odd
+	// tile's row that has not run yet; the odd tile leaves it there, so no cell
+	// moves twice in a frame.
+	const int words = grid.WordsPerRow();
+	const int tileCount = (words + SETTLE_TILE_WORDS - 1) / SETTLE_TILE_WORDS;
+	const uint64_t frame = pSimData->SettleFrame++;
+	pSimData->SettleRowFlags.resize(static_cast<size_t>(tileCount) * height);
+	for (int phase = 0; phase < 2; ++phase)
+	{
+		const size_t phaseTiles = static_cast<size_t>((tileCount - phase + 1) / 2);
+		pSimData->GetWorkers().ParallelFor(phaseTiles, [&](const size_t i)
+		{
+			const int tile = phase + 2 * static_cast<int>(i);
+			// Each tile has its own stream, keyed by frame and tile, so the result
+			// does not depend on the thread count or scheduling.
+			RandomGenerator rng(RandomGenerator::MixSeed(pSimData->SettleSeed, frame * tileCount + tile));
+			const int wordBegin = tile * SETTLE_TILE_WORDS;
+			SettleTile(pSimData, tile, wordBegin, (std::min)(wordBegin + SETTLE_TILE_WORDS, words), phase == 1, rng);
+		});
+	}
+
+	// Merge the tiles' per-row results (serially, so tiles never share a flag).
+	for (const int y : rows)
+	{
+		uint8_t flags = 0;
+		for (int tile = 0; tile < tileCount; ++tile)
+		{
+			flags |= pSimData->SettleRowFlags[static_cast<size_t>(tile) * height + y];
+		}
+		if (flags & SETTLE_ROW_MOVED)
+		{
+			// Rows y and y + 1 changed: restamp both and wake the settle rows reading them.
+			grid.MarkRowChanged(y);
+			grid.MarkRowChanged(y + 1);
+		}
+		else if (flags & SETTLE_ROW_MOVABLE)
+		{
+			grid.SetSettleActive(y); // nothing rolled a move this time; try again next frame
+		}
+	}
+}
+
+uint64_t SnowField::RandomFlowMask(RandomGenerator& rng)
+{
+	// Each bit set with probability SETTLE_FLOW_ODDS / 64: fold six random words
+	// from the lowest bit of the odds upwards, OR for a 1 bit and AND for a 0 bit.
+	if (SETTLE_FLOW_ODDS >= 64) return ~uint64_t{ 0 };
+	uint64_t mask = 0;
+	for (int b = 0; b < 6; ++b)
+	{
+		const uint64_t r = rng.NextU64();
+		mask = (SETTLE_FLOW_ODDS >> b & 1) ? (mask | r) : (mask & r);
+	}
+	return mask;
+}
+
+void SnowField::SettleTile(SimulationData* pSimData, const int tile, const int wordBegin, const int wordEnd,
+                           const bool afterNeighbours, RandomGenerator& rng)
+{
+	SnowGrid& grid = pSimData->ScenePixels;
+	const int words = grid.WordsPerRow();
+	const uint64_t lastMask = grid.LastWordMask();
+	const size_t height = static_cast<size_t>(grid.Height());
+	uint8_t* const rowFlags = pSimData->SettleRowFlags.data() + static_cast<size_t>(tile) * height;
+
+	// This frame's flags of the neighbour tiles (null: none, or not run yet).
+	const bool lastTile = wordEnd == words;
+	const uint8_t* const leftFlags = afterNeighbours && tile > 0 ? rowFlags - height : nullptr;
+	const uint8_t* const rightFlags = afterNeighbours && !lastTile ? rowFlags + height : nullptr;
+	const std::vector<int>& rows = pSimData->SettleRows;
+
+	// Occupancy of the cell left/right of every cell in word w (bit i = column
+	// 64w+i), reading across word edges. Off-grid neighbours count as occupied.
+	const auto leftOf = [&](const uint64_t* row, const int w)
+	{
+		return row[w] << 1 | (w > 0 ? row[w - 1] >> 63 : 1);
+	};
+	const auto rightOf = [&](const uint64_t* row, const int w)
+	{
+		return w + 1 < words ? row[w] >> 1 | row[w + 1] << 63 : row[w] >> 1 | ~(lastMask >> 1);
+	};
+
+	uint64_t tryLeft[SETTLE_TILE_WORDS];
+	uint64_t tryRight[SETTLE_TILE_WORDS];
+
+	// Iterate from bottom-up, to avoid updating falling pixels multiple times per-frame, which would cause them to "teleport".
+	for (size_t r = 0; r < rows.size(); ++r)
+	{
+		const int y = rows[r];
+		uint64_t* cur = grid.Row(y);
+		uint64_t* below = grid.Row(y + 1);
+		uint8_t flags = 0;
+
+		// Edge cells the neighbours moved into this row this frame (only when
+		// they settled row y - 1 this frame; older flags are stale) are at rest.
+		uint64_t arrivedFirst = 0;
+		uint64_t arrivedLast = 0;
+		if (r + 1 < rows.size() && rows[r + 1] == y - 1)
+		{
+			if (leftFlags != nullptr && (leftFlags[y - 1] & SETTLE_ROW_SENT_RIGHT)) arrivedFirst = 1;
+			if (rightFlags != nullptr && (rightFlags[y - 1] & SETTLE_ROW_SENT_LEFT)) arrivedLast = uint64_t{ 1 } << 63;
+		}
+
+		// Flow downwards: every flowing cell with air below drops straight down.
+		// The rest flow sideways, trying a random side first, so we're less biased.
+		bool anySideways = false;
+		for (int w = wordBegin; w < wordEnd; ++w)
+		{
+			const int k = w - wordBegin;
+			tryLeft[k] = tryRight[k] = 0;
+			if (cur[w] == 0) continue;
+
+			// Cells with somewhere to go, whatever the dice say. None: the word
+			// is at rest and needs no random draws.
+			uint64_t canMove = cur[w] & (~below[w] |
+				~(leftOf(cur, w) | leftOf(below, w)) | ~(rightOf(cur, w) | rightOf(below, w)));
+			if (w == wordBegin) canMove &= ~arrivedFirst;
+			if (w == wordEnd - 1) canMove &= ~arrivedLast;
+			if (canMove == 0) continue;
+			flags |= SETTLE_ROW_MOVABLE;
+
+			const uint64_t flowing = canMove & RandomFlowMask(rng);
+			const uint64_t down = flowing & ~below[w];
+			below[w] |= down;
+			cur[w] &= ~down;
+			if (down != 0) flags |= SETTLE_ROW_MOVED;
+
+			const uint64_t blocked = flowing & ~down;
+			const uint64_t leftFirst = rng.NextU64();
+			tryLeft[k] = blocked & leftFirst;
+			tryRight[k] = blocked & ~leftFirst;
+			anySideways |= blocked != 0;
+		}
+		rowFlags[y] = flags;
+		if (!anySideways) continue;
+
+		// Diagonal moves need both the side cell and the one below it free. Each
+		// pass moves one direction at once, so two cells never claim the same
+		// target; later passes see the cells filled by earlier ones. Order: the
+		// left-first cells go left, the right-first cells go right, then each
+		// tries its second side.
+		for (int pass = 0; pass < 4; ++pass)
+		{
+			const bool left = pass == 0 || pass == 3;
+			uint64_t* const movers = (pass == 0 || pass == 2) ? tryLeft : tryRight;
+			for (int w = wordBegin; w < wordEnd; ++w)
+			{
+				const int k = w - wordBegin;
+				if (movers[k] == 0) continue;
+
+				const uint64_t open = left
+					? ~(leftOf(cur, w) | leftOf(below, w))
+					: ~(rightOf(cur, w) | rightOf(below, w));
+				const uint64_t move = movers[k] & open;
+				if (move == 0) continue;
+
+				cur[w] &= ~move;
+				movers[k] &= ~move;
+				rowFlags[y] |= SETTLE_ROW_MOVED;
+				if (left)
+				{
+					below[w] |= move >> 1;
+					if (move & 1)
+					{
+						below[w - 1] |= uint64_t{ 1 } << 63;
+						if (w == wordBegin) rowFlags[y] |= SETTLE_ROW_SENT_LEFT;
+					}
+				}
+				else
+				{
+					below[w] |= move << 1;
+					if (move >> 63)
+					{
+						below[w + 1] |= 1;
+						if (w == wordEnd - 1) rowFlags[y] |= SETTLE_ROW_SENT_RIGHT;
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "Vector2.h"
+#include "SimulationData.h"
+#include <cstdint>
+#include <vector>
+
+#define TWO_PI 6.28318530718f
+#define PI 3.14159265359f
+
+// SnowField Class
+// All falling snowflakes of one display, stored as a structure of arrays like
+// RainField: each per-flake attribute is its own contiguous column, so the
+// motion update streams over a few float arrays and the sprite list is written
+// straight from them. Also owns the settled-snow physics of both heap modes.
+class SnowField
+{
+public:
+	// Snowflake shape types (also the sprite's cell in the renderer's atlas)
+	enum class SnowflakeShape : uint8_t {
+		Simple,     // Simple circular shape
+		Crystal,    // Star-like crystal shape
+		Hexagon,    // Hexagon shape
+		Star        // Star shape with more branches
+	};
+	static constexpr int SHAPE_COUNT = 4;
+
+	// Sprite geometry in the layout of D2D1_RECT_F and D2D1_MATRIX_3X2_F, so the
+	// renderer passes the arrays to Direct2D as they are.
+	struct SpriteRect
+	{
+		float Left, Top, Right, Bottom;
+	};
+	struct SpriteTransform
+	{
+		float M11, M12, M21, M22, Dx, Dy;
+	};
+	// The visible flakes as sprites grouped by shape: shape s is sprites
+	// [ShapeBegin[s], ShapeBegin[s + 1]). Capacity is kept between frames.
+	struct SpriteList
+	{
+		std::vector<SpriteRect> Dests;
+		std::vector<SpriteTransform> Transforms;
+		size_t ShapeBegin[SHAPE_COUNT + 1] = {};
+
+		size_t Size() const { return ShapeBegin[SHAPE_COUNT]; }
+	};
+
+	SnowField() = default;
+
+	// Movable but not copyable (a field is owned by exactly one display)
+	SnowField(SnowField&&) noexcept = default;
+	SnowField& operator=(SnowField&&) noexcept = default;
+	SnowField(const SnowField&) = delete;
+	SnowField& operator=(const SnowField&) = delete;
+
+	// Append `count` fresh flakes scattered over the scene.
+	void Spawn(int count, SimulationData* pSimData);
+	// Move every flake by deltaSeconds, then settle or respawn the ones that
+	// landed or left the scene. Large fields move in chunks on the WorkerPool
+	// (SimulationData::ParallelUpdate) with the same result.
+	void UpdatePositions(float deltaSeconds, SimulationData* pSimData);
+	// Pop flakes from the back until at most `count` remain.
+	void Truncate(size_t count);
+	void Clear();
+	void Reserve(size_t count);
+	size_t Size() const { return PosX.size(); }
+	bool Empty() const { return PosX.empty(); }
+
+	// Per-frame 3rd noise axis. Identical for every flake in a frame, so compute
+	// it once in DisplayWindow::UpdateSnowFlakes and pass it to AdvanceFlowField.
+	static float ComputeNoiseTime(double clockTime);
+	// Bring the display's drift field (SimulationData::SnowFlow) to this frame's
+	// noise time. Call once per frame, before UpdatePositions.
+	static void AdvanceFlowField(SimulationData* pSimData, float noiseTime);
+	// Re-sample the drift noise for the next round-robin slice of the flakes,
+	// sized so each flake is refreshed about every NOISE_REFRESH_SECONDS (over
+	// SimulationData::NoiseRefreshScale) at any frame rate. Call once per frame,
+	// after AdvanceFlowField.
+	void RefreshNoise(float deltaSeconds, const SimulationData* pSimData);
+	// Per-pixel mode: let settled snow slump/flow one step. Word-parallel on the
+	// bit grid, and parallel over column tiles on the shared WorkerPool.
+	static void SettleSnow(SimulationData* pSimData);
+	// "Simple snow heap" mode: relax the per-column heightmap (volume-conserving
+	// diffusion, matching the macOS build); SnowRenderer draws it as one filled silhouette.
+	static void SmoothSnowHeap(SimulationData* pSimData);
+
+	// Write a sprite for every flake inside `visible` (scene coordinates, edges
+	// included): a square of half-size radius * halfSizePerRadius centred on the
+	// flake moved by (offsetX, offsetY), rotated about that centre. One counting
+	// pass sizes the shape groups, one placing pass fills them. With `previous`,
+	// also write each flake as it was before the last UpdatePositions into the
+	// same slot there (for interpolation; a flake inside `visible` at either
+	// time is included).
+	void BuildSprites(const RECT& visible, float offsetX, float offsetY, float halfSizePerRadius,
+	                  SpriteList& sprites, SpriteList* previous = nullptr) const;
+
+	// Read-only view for the renderers.
+	Vector2 GetPos(const size_t i) const { return Vector2(PosX[i], PosY[i]); }
+	float GetRadius(const size_t i) const { return Radius[i]; }
+	float GetRotation(const size_t i) const { return Rotation[i]; }
+	SnowflakeShape GetShape(const size_t i) const { return static_cast<SnowflakeShape>(Shape[i]); }
+
+	// Width (in logical px, DPI-scaled at runtime) of each simple-heap column.
+	// Public because SimulationData sizes the ColumnHeights array from it.
+	// Matches the macOS build's kSnowColumnSpacing (12 pt).
+	// ↑ coarser, chunkier mounds (fewer columns); ↓ finer, smoother slopes (more columns, more CPU).
+	static constexpr float SNOW_COLUMN_WIDTH_BASE = 12.0f;
+
+	// Falling-flake count per Intensity unit (snow). Public because
+	// DisplayWindow::UpdateSnowFlakes uses it to size the flake pool. Tuned
+	// together with SNOW_EDGE_MARGIN to keep on-screen density constant.
+	// ↑ denser snowfall per intensity step (more flakes, more CPU); ↓ sparser.
+	static constexpr int SNOW_FLAKE_MULTIPLIER = 14;
+
+private:
+	// Flake speed cap (px/s). ↑ lets flakes move faster (more frantic gusts); ↓ keeps it calm.
+	static constexpr float MAX_SPEED = 75.0f;
+	// Strength of the noise-driven wind/swirl. ↑ wilder sideways drift & speed
+	// variation; ↓ straighter, more uniform fall.
+	static constexpr float NOISE_INTENSITY = 20.0f;
+	// How fast the noise field evolves over time (the noise's 3rd axis rate).
+	// ↑ faster-churning gusts; ↓ slow, lazily-shifting drift.
+	static constexpr float NOISE_TIMESCALE = 0.001f;
+	// How often each flake re-samples the drift field (s); in between, its noise
+	// is predicted linearly from its last two samples. At or below the frame time
+	// every flake is sampled every frame. ↑ less noise work on high-refresh
+	// monitors, drift slowly departs from the exact field; ↓ the reverse.
+	static constexpr float NOISE_REFRESH_SECONDS = 1.0f / 60.0f;
+	// Node spacing (raw px, like the noise frequency) of the drift field flakes
+	// sample instead of evaluating the noise. ↑ cheaper field, blurrier swirls;
+	// ↓ closer to the exact noise, more nodes to refresh.
+	static constexpr float FLOW_CELL_SIZE = 8.0f;
+	// Seconds between drift-field keyframes; the field is linearly blended between
+	// them. ↑ fewer node refreshes per frame, gusts evolve less faithfully; ↓ the reverse.
+	static constexpr float FLOW_KEYFRAME_SECONDS = 8.0f;
+	// Steady downward pull (accel). ↑ flakes fall faster & straighter; ↓ driftier, hangs longer.
+	static constexpr float GRAVITY = 10.0f;
+	// Per-pixel-mode settle flow chance (0–10). ↑ snow slumps/flows faster; ↓ stiffer, sticks in place.
+	static constexpr int SNOW_FLOW_RATE = 3;
+	// The same chance as a fraction of 64, the resolution of the word-wide random masks.
+	static constexpr int SETTLE_FLOW_ODDS = ((SNOW_FLOW_RATE + 1) * 64 + 5) / 11;
+	// Tile width of the parallel settle pass, in 64-px grid words; must be at
+	// least 2 so tiles of the same phase never share a word.
+	// ↑ fewer, larger tasks (less overhead, worse balance on narrow screens); ↓ the reverse.
+	static constexpr int SETTLE_TILE_WORDS = 2;
+	// Flakes per task of the parallel update (SimulationData::ParallelUpdate);
+	// fewer than two chunks' worth run serially. About 40 KB of flake columns
+	// per chunk. Also the grouping of simple-heap deposits, so changing it
+	// changes the heap's rounding (not its thread-count independence).
+	// ↑ less scheduling overhead, parallel only at higher counts; ↓ better balance, more tasks.
+	static constexpr size_t PARALLEL_CHUNK_FLAKES = 1024;
+
+	// Horizontal off-screen spawn/despawn margin as a fraction of scene width
+	// (drift headroom for seamless edges). Smaller = fewer off-screen flakes
+	// simulated; too small risks flakes popping out at the edges under drift.
+	static constexpr float SNOW_EDGE_MARGIN = 0.2f;
+
+	// Flake size as a real radius (matches the macOS build's kSnowMin/MaxRadius),
+	// driving both the on-screen draw size and the settled-heap deposit so a flake
+	// that looks bigger also settles proportionally more snow.
+	// ↑ both = chunkier snow; bigger flakes also settle faster (deposit ∝ radius).
+	static constexpr float SNOW_MIN_RADIUS = 0.8f;
+	static constexpr float SNOW_MAX_RADIUS = 2.5f;
+
+	// Simple heightmap heap tuning (aligned with the macOS SnowSystem):
+	// per-flake deposit = radius * SNOW_DEPOSIT_FACTOR (DPI-scaled).
+	// ↑ faster pile buildup per settled flake; ↓ slower.
+	static constexpr float SNOW_DEPOSIT_FACTOR = 0.5f;
+	// Pile height cap as a fraction of scene height.
+	// ↑ lets drifts grow taller before they stop accumulating; ↓ keeps the pile shallow.
+	static constexpr float SNOW_MAX_HEIGHT_FRACTION = 0.35f;
+	// Volume-conserving slope relaxation: each pass moves SNOW_SMOOTH_RATE of any
+	// adjacent height excess above SNOW_SMOOTH_THRESHOLD (px, DPI-scaled) into the
+	// lower neighbour. bigger rate = faster smoothing; bigger threshold = steeper.
+	static constexpr float SNOW_SMOOTH_RATE = 0.08f;
+	static constexpr float SNOW_SMOOTH_THRESHOLD = 2.0f;
+
+	// Motion columns, streamed by every update.
+	std::vector<float> PosX;
+	std::vector<float> PosY;
+	std::vector<float> VelX;
+	std::vector<float> VelY;
+	std::vector<float> Rotation;      // current rotation angle (rad)
+	std::vector<float> RotationSpeed; // rad/s
+	// Position and rotation before the last move (equal to the current ones
+	// for a flake that just (re)spawned), for drawing in between.
+	std::vector<float> PrevPosX;
+	std::vector<float> PrevPosY;
+	std::vector<float> PrevRotation;
+	// Drift noise at the last refresh, its rate of change (per s) and the
+	// seconds since; NoiseStale forces a refresh (new or respawned flake).
+	std::vector<float> NoiseValue;
+	std::vector<float> NoiseSlope;
+	std::vector<float> NoiseAge;
+	std::vector<uint8_t> NoiseStale;
+
+	// Size and look: set at (re)spawn, read by settling and drawing.
+	std::vector<float> Radius; // logical units; see SNOW_MIN/MAX_RADIUS
+	std::vector<uint8_t> Shape; // SnowflakeShape
+
+	// Per-chunk scratch of the chunked update: the flakes that (may) land this
+	// frame, in flake order, and (simple heap) each chunk's deposit per column.
+	// Capacity is kept between frames.
+	std::vector<std::vector<size_t>> ChunkLandings;
+	std::vector<float> ChunkDeposits;
+
+	// Round-robin state of the staggered noise refresh (RefreshNoise): next
+	// flake, and flakes owed as a fraction.
+	size_t NoiseCursor = 0;
+	float NoiseBudget = 0.0f;
+
+	// Per-tile, per-row settle results, merged after both phases.
+	static constexpr uint8_t SETTLE_ROW_MOVED = 1;   // some cell moved (rows y and y + 1 changed)
+	static constexpr uint8_t SETTLE_ROW_MOVABLE = 2; // some cell could have moved
+	// A cell left the tile diagonally, into the edge cell of the neighbour's row y + 1.
+	static constexpr uint8_t SETTLE_ROW_SENT_LEFT = 4;
+	static constexpr uint8_t SETTLE_ROW_SENT_RIGHT = 8;
+
+	// Settle the words [wordBegin, wordEnd) of every active row. With
+	// `afterNeighbours` (the second phase) the tiles either side already ran
+	// this frame, and the cells they moved into this tile's edges stay put.
+	static void SettleTile(SimulationData* pSimData, int tile, int wordBegin, int wordEnd, bool afterNeighbours,
+	                       RandomGenerator& rng);
+	static uint64_t RandomFlowMask(RandomGenerator& rng);
+	static bool IsSceneryPixelSet(const SimulationData* pSimData, int x, int y);
+	// Integrate the motion of flakes [begin, end).
+	void MoveFlakes(size_t begin, size_t end, float deltaSeconds, const SimulationData* pSimData);
+	// Flake i drifted out of the area flakes live in (and must respawn).
+	bool IsOutOfBounds(size_t i, const SimulationData* pSimData) const;
+	// UpdatePositions per heap mode, over `chunks` chunks of PARALLEL_CHUNK_FLAKES.
+	void UpdateOnHeap(float deltaSeconds, SimulationData* pSimData, size_t chunks, bool parallel);
+	void UpdateOnGrid(float deltaSeconds, SimulationData* pSimData, size_t chunks, bool parallel);
+	// Conservative test for the parallel update: false means LandOnGrid would
+	// leave flake i alone while the highest settled row stays at maxSnowHeight.
+	bool MayLandOnGrid(size_t i, const SimulationData* pSimData, int maxSnowHeight) const;
+	// Simple-heap mode: if flake i reached the surface of its heightmap column,
+	// add its deposit to deposits[column]. Returns true if the flake must
+	// respawn (it landed or left the scene).
+	bool LandOnHeap(size_t i, const SimulationData* pSimData, float* deposits) const;
+	// Settle flake i into the grid if it touches settled snow or the ground, or
+	// respawn it if it left the scene (per-pixel mode).
+	void LandOnGrid(size_t i, SimulationData* pSimData);
+	void SampleNoise(size_t i, const SimulationData* pSimData);
+	// Give flake i a new start and look: anywhere over the scene, or just above
+	// its top edge when `atTop` (a respawn).
+	void SpawnFlake(size_t i, SimulationData* pSimData, bool atTop);
+	void Resize(size_t count);
+};
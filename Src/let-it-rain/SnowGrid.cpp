@@ -0,0 +1,76 @@
+#include "SnowGrid.h"
+
+#include <algorithm>
+
+void SnowGrid::Resize(const int width, const int height)
+{
+	Columns = width;
+	RowWords = (width + 63) / 64;
+	const int tailBits = width & 63;
+	LastMask = tailBits == 0 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << tailBits) - 1;
+	Words.assign(static_cast<size_t>(RowWords) * height, 0); // zero-initialized
+	ResetTracking(height);
+}
+
+void SnowGrid::Release()
+{
+	Words.clear();
+	Words.shrink_to_fit();
+	Columns = 0;
+	RowWords = 0;
+	LastMask = 0;
+	RowStamps.clear();
+	RowStamps.shrink_to_fit();
+	SettleActive.clear();
+	SettleActive.shrink_to_fit();
+}
+
+void SnowGrid::Clear()
+{
+	std::fill(Words.begin(), Words.end(), uint64_t{ 0 });
+	ResetTracking(Height());
+}
+
+void SnowGrid::CopyChangedRows(const SnowGrid& source)
+{
+	if (Columns != source.Columns || Height() != source.Height())
+	{
+		Words = source.Words;
+		Columns = source.Columns;
+		RowWords = source.RowWords;
+		LastMask = source.LastMask;
+		RowStamps = source.RowStamps;
+		LastStamp = source.LastStamp;
+		SettleActive.assign(source.SettleActive.size(), 0);
+		return;
+	}
+
+	const int height = Height();
+	for (int y = 0; y < height; ++y)
+	{
+		if (RowStamps[y] == source.RowStamps[y]) continue;
+		std::copy_n(source.Row(y), RowWords, Row(y));
+		RowStamps[y] = source.RowStamps[y];
+	}
+	LastStamp = source.LastStamp;
+}
+
+void SnowGrid::MarkRowChanged(const int y)
+{
+	RowStamps[y] = ++LastStamp;
+	// Row y is the source of settle row y and the floor of settle row y - 1.
+	SettleActive[y] = 1;
+	if (y > 0) SettleActive[y - 1] = 1;
+}
+
+void SnowGrid::ClearSettleActive()
+{
+	std::fill(SettleActive.begin(), SettleActive.end(), static_cast<uint8_t>(0));
+}
+
+void SnowGrid::ResetTracking(const int height)
+{
+	++LastStamp;
+	RowStamps.assign(static_cast<size_t>(height), LastStamp);
+	SettleActive.assign(static_cast<size_t>(height), 0);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// SnowGrid Class
+// Settled-snow occupancy for the per-pixel heap, one bit per pixel: each row is
+// WordsPerRow() 64-bit words, bit i of word w being column 64 * w + i. Bits past
+// the width in a row's last word are always 0. An eighth of the memory of one
+// byte per pixel, and the settle pass moves whole words of cells at a time.
+//
+// Rows also carry change tracking, so a pile that has stopped moving costs
+// nothing: a stamp per row that renderers compare against what they last drew,
+// and a flag per row telling the settle pass which rows may still move.
+class SnowGrid
+{
+public:
+	// Size to width x height and clear. The only call that allocates.
+	void Resize(int width, int height);
+	// Free the storage (Empty() afterwards).
+	void Release();
+	void Clear();
+	// Make this grid a copy of `source`'s cells and row stamps, copying only
+	// the rows whose stamp differs (every row if the size differs). The copy
+	// can then stand in for `source` wherever stamps are compared, e.g. in
+	// SnowRaster. Settle flags are not copied (a copy is for reading).
+	void CopyChangedRows(const SnowGrid& source);
+
+	bool Empty() const { return Words.empty(); }
+	int Width() const { return Columns; }
+	int WordsPerRow() const { return RowWords; }
+	// Valid-column mask of each row's last word.
+	uint64_t LastWordMask() const { return LastMask; }
+
+	bool Get(const int x, const int y) const
+	{
+		return (Words[Index(x, y)] >> (x & 63) & 1) != 0;
+	}
+	void Set(const int x, const int y)
+	{
+		Words[Index(x, y)] |= uint64_t{ 1 } << (x & 63);
+	}
+
+	int Height() const { return static_cast<int>(RowStamps.size()); }
+
+	// Record that cells in row y changed outside the settle pass (a flake
+	// landed): restamps the row and wakes the settle rows that read it.
+	void MarkRowChanged(int y);
+	// Increases every time row y changes; equal stamps mean identical contents.
+	uint64_t RowStamp(const int y) const { return RowStamps[y]; }
+
+	// Settle row y (cells in row y flowing into row y + 1) may move this frame.
+	bool IsSettleActive(const int y) const { return SettleActive[y] != 0; }
+	void SetSettleActive(const int y) { SettleActive[y] = 1; }
+	// Forget every active flag (the settle pass re-raises the ones still live).
+	void ClearSettleActive();
+
+	uint64_t* Row(const int y) { return Words.data() + static_cast<size_t>(y) * RowWords; }
+	const uint64_t* Row(const int y) const { return Words.data() + static_cast<size_t>(y) * RowWords; }
+
+	// Call fn(xStart, xEnd) for every horizontal run of set cells in row y
+	// (both inclusive), left to right. Empty and full words are skipped whole.
+	template <typename Fn>
+	void ForEachRun(const int y, Fn&& fn) const
+	{
+		const uint64_t* row = Row(y);
+		int runStart = -1;
+		for (int w = 0; w < RowWords; ++w)
+		{
+			const uint64_t bits = row[w];
+			const int x0 = w * 64;
+			if (bits == 0)
+			{
+				if (runStart >= 0)
+				{
+					fn(runStart, x0 - 1);
+					runStart = -1;
+				}
+				continue;
+			}
+			if (bits == ~uint64_t{ 0 })
+			{
+				if (runStart < 0) runStart = x0;
+				continue;
+			}
+			for (int b = 0; b < 64; ++b)
+			{
+				const bool set = (bits >> b & 1) != 0;
+				if (set && runStart < 0)
+				{
+					runStart = x0 + b;
+				}
+				else if (!set && runStart >= 0)
+				{
+					fn(runStart, x0 + b - 1);
+					runStart = -1;
+				}
+			}
+		}
+		if (runStart >= 0)
+		{
+			fn(runStart, RowWords * 64 - 1);
+		}
+	}
+
+private:
+	std::vector<uint64_t> Words;
+	int Columns = 0;
+	int RowWords = 0;
+	uint64_t LastMask = 0;
+
+	std::vector<uint64_t> RowStamps;
+	uint64_t LastStamp = 0;
+	std::vector<uint8_t> SettleActive;
+
+	// Restamp every row and drop all settle activity (contents replaced wholesale).
+	void ResetTracking(int height);
+
+	size_t Index(const int x, const int y) const
+	{
+		return static_cast<size_t>(y) * RowWords + static_cast<size_t>(x >> 6);
+	}
+};
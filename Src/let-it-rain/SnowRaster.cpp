@@ -0,0 +1,137 @@
+#include "SnowRaster.h"
+
+#include <algorithm>
+
+bool SnowRaster::Update(const SnowGrid& grid, int radius, const uint32_t bgra)
+{
+	radius = (std::min)((std::max)(radius, 1), MAX_RADIUS);
+	Spans.clear();
+
+	const int height = grid.Height();
+	if (grid.Width() != ImageWidth || height != ImageHeight || radius != DrawnRadius || bgra != DrawnColor)
+	{
+		// New geometry or look: grid stamps start above 0, so every row is redrawn.
+		ImageWidth = grid.Width();
+		ImageHeight = height;
+		DrawnRadius = radius;
+		DrawnColor = bgra;
+		DrawnStamps.assign(static_cast<size_t>(height), 0);
+	}
+	if (ImageWidth <= 0 || ImageHeight <= 0) return false;
+
+	// Grid row y paints pixel rows [y - radius, y + radius); merge the changed
+	// rows' ranges into disjoint spans.
+	size_t rows = 0;
+	for (int y = 0; y < height; ++y)
+	{
+		if (DrawnStamps[y] == grid.RowStamp(y)) continue;
+		DrawnStamps[y] = grid.RowStamp(y);
+
+		const int begin = (std::max)(y - radius, 0);
+		const int end = (std::min)(y + radius, height);
+		if (!Spans.empty() && begin <= Spans.back().End)
+		{
+			rows += static_cast<size_t>(end - Spans.back().End);
+			Spans.back().End = end;
+		}
+		else
+		{
+			Spans.push_back({ begin, end, 0 });
+			rows += static_cast<size_t>(end - begin);
+		}
+	}
+	if (Spans.empty()) return false;
+
+	Staging.resize(rows * static_cast<size_t>(ImageWidth));
+	size_t offset = 0;
+	for (Span& span : Spans)
+	{
+		span.Offset = offset;
+		RasterizeRows(grid, radius, bgra, span.Begin, span.End, Staging.data() + offset,
+		              static_cast<size_t>(ImageWidth));
+		offset += static_cast<size_t>(span.End - span.Begin) * ImageWidth;
+	}
+	return true;
+}
+
+void SnowRaster::Invalidate()
+{
+	std::fill(DrawnStamps.begin(), DrawnStamps.end(), uint64_t{ 0 });
+}
+
+void SnowRaster::RasterizeRows(const SnowGrid& grid, int radius, const uint32_t bgra, const int yBegin,
+                               const int yEnd, uint32_t* pixels, const size_t stride)
+{
+	radius = (std::min)((std::max)(radius, 1), MAX_RADIUS);
+	const int width = grid.Width();
+	const int height = grid.Height();
+	const int words = grid.WordsPerRow();
+	std::vector<uint64_t> rows(static_cast<size_t>(words));
+	std::vector<uint64_t> covered(static_cast<size_t>(words));
+
+	for (int py = yBegin; py < yEnd; ++py, pixels += stride)
+	{
+		// Vertical dilation: pixel row py shows every cell row in (py - radius, py + radius].
+		std::fill(rows.begin(), rows.end(), uint64_t{ 0 });
+		const int cellEnd = (std::min)(py + radius, height - 1);
+		for (int cy = (std::max)(py - radius + 1, 0); cy <= cellEnd; ++cy)
+		{
+			const uint64_t* src = grid.Row(cy);
+			for (int w = 0; w < words; ++w) rows[w] |= src[w];
+		}
+
+		// Horizontal dilation: pixel x shows every cell in (x - radius, x + radius],
+		// i.e. bit x gathers bit x + k for k in [1 - radius, radius].
+		for (int w = 0; w < words; ++w)
+		{
+			const uint64_t prev = w > 0 ? rows[w - 1] : 0;
+			const uint64_t next = w + 1 < words ? rows[w + 1] : 0;
+			uint64_t bits = rows[w];
+			for (int k = 1; k <= radius; ++k)
+			{
+				// Cells k to the right (k < 64, since radius <= MAX_RADIUS).
+				bits |= rows[w] >> k | next << (64 - k);
+			}
+			for (int k = 1; k < radius; ++k)
+			{
+				// Cells k to the left.
+				bits |= rows[w] << k | prev >> (64 - k);
+			}
+			covered[w] = bits;
+		}
+
+		// Expand to pixels; empty and full words are filled whole.
+		for (int w = 0; w < words; ++w)
+		{
+			const int x0 = w * 64;
+			const int count = (std::min)(64, width - x0);
+			const uint64_t bits = covered[w];
+			uint32_t* dst = pixels + x0;
+			if (bits == 0)
+			{
+				std::fill(dst, dst + count, uint32_t{ 0 });
+			}
+			else if (bits == ~uint64_t{ 0 })
+			{
+				std::fill(dst, dst + count, bgra);
+			}
+			else
+			{
+				for (int b = 0; b < count; ++b)
+				{
+					dst[b] = (bits >> b & 1) != 0 ? bgra : 0;
+				}
+			}
+		}
+	}
+}
+
+uint32_t SnowRaster::PackBgra(const float red, const float green, const float blue, const float alpha)
+{
+	const auto channel = [](const float value)
+	{
+		return static_cast<uint32_t>((std::min)((std::max)(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+	};
+	// Premultiplied: color channels never exceed alpha.
+	return channel(alpha) << 24 | channel(red * alpha) << 16 | channel(green * alpha) << 8 | channel(blue * alpha);
+}
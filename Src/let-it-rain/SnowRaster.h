@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SnowGrid.h"
+
+// SnowRaster Class
+// Platform-neutral image of the per-pixel settled snow: 32-bit premultiplied
+// BGRA, one pixel per grid cell, each cell dilated to a (2 * radius)^2 square
+// so the pile stays visible at high DPI. Update() rasterizes only the pixel
+// rows touched by grid rows whose stamp moved on since the previous call, into
+// a staging buffer the renderer copies into its persistent GPU bitmap.
+class SnowRaster
+{
+public:
+	// A run of changed pixel rows [Begin, End); its pixels start at
+	// Pixels() + Offset with a stride of Width() pixels.
+	struct Span
+	{
+		int Begin;
+		int End;
+		size_t Offset;
+	};
+
+	// Bring the image up to date with `grid`. A new grid size, radius or color
+	// redraws every row. Returns false when no row changed (nothing to upload).
+	bool Update(const SnowGrid& grid, int radius, uint32_t bgra);
+	// Forget what was drawn, so the next Update redraws every row (the
+	// consumer lost its copy of the image, e.g. on device loss).
+	void Invalidate();
+
+	int Width() const { return ImageWidth; }
+	int Height() const { return ImageHeight; }
+	// Rows redrawn by the last Update, top to bottom, non-overlapping.
+	const std::vector<Span>& DirtySpans() const { return Spans; }
+	const uint32_t* Pixels() const { return Staging.data(); }
+
+	// Rasterize pixel rows [yBegin, yEnd) of the image of `grid` into `pixels`
+	// (row yBegin first, `stride` pixels apart). Cell (x, y) covers pixels
+	// [x - radius, x + radius) x [y - radius, y + radius); radius is clamped to
+	// [1, MAX_RADIUS].
+	static void RasterizeRows(const SnowGrid& grid, int radius, uint32_t bgra, int yBegin, int yEnd,
+	                          uint32_t* pixels, size_t stride);
+	// Premultiplied BGRA pixel from straight 0-1 channels.
+	static uint32_t PackBgra(float red, float green, float blue, float alpha);
+
+	// Largest dilation radius; keeps the horizontal spread within one word shift.
+	static constexpr int MAX_RADIUS = 32;
+
+private:
+	std::vector<uint64_t> DrawnStamps; // grid row stamps the image was last built from
+	std::vector<Span> Spans;
+	std::vector<uint32_t> Staging;
+	int ImageWidth = 0;
+	int ImageHeight = 0;
+	int DrawnRadius = 0;
+	uint32_t DrawnColor = 0;
+};
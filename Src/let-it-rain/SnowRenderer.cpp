@@ -0,0 +1,235 @@
+#include "SnowRenderer.h"
+#include <array>
+#include <cmath>
+
+void SnowRenderer::DrawAtlasCells(RenderBackend& sheet, const RenderBackend::Color& color)
+{
+	// 2x2 grid of SPRITE_SIZE cells: Simple, Crystal (top row), Hexagon, Star.
+	const float half = SPRITE_SIZE / 2.0f;
+	const float s = SPRITE_SIZE;
+
+	// Each shape is clipped to its cell so overflow (e.g. star spikes that exceed
+	// the half-cell) does not bleed into neighbouring cells in the atlas.
+	sheet.PushClip(0, 0, s, s);
+	DrawSimpleSnowflake(sheet, Vector2(half, half), SPRITE_BASE_DRAW_SIZE, color);
+	sheet.PopClip();
+
+	sheet.PushClip(s, 0, s * 2.0f, s);
+	DrawCrystalSnowflake(sheet, Vector2(s + half, half), SPRITE_BASE_DRAW_SIZE, color);
+	sheet.PopClip();
+
+	sheet.PushClip(0, s, s, s * 2.0f);
+	DrawHexagonSnowflake(sheet, Vector2(half, s + half), SPRITE_BASE_DRAW_SIZE, color);
+	sheet.PopClip();
+
+	sheet.PushClip(s, s, s * 2.0f, s * 2.0f);
+	DrawStarSnowflake(sheet, Vector2(s + half, s + half), SPRITE_BASE_DRAW_SIZE, color);
+	sheet.PopClip();
+}
+
+void SnowRenderer::DrawFallingFlakes(RenderBackend& backend, const SnowField::SpriteList& sprites,
+                                     const RenderBackend::Color& color)
+{
+	if (sprites.Size() == 0) return;
+
+	// Lazily (re)build the colored atlas.
+	constexpr RenderBackend::SpriteSheet sheet = RenderBackend::SpriteSheet::Flakes;
+	if (!backend.HasSpriteSheet(sheet))
+	{
+		backend.BuildSpriteSheet(sheet, SPRITE_SIZE * 2.0f, SPRITE_SIZE * 2.0f,
+		                         [&color](RenderBackend& atlas) { DrawAtlasCells(atlas, color); });
+		if (!backend.HasSpriteSheet(sheet)) return;
+	}
+
+	// One run per shape, from its cell; the atlas is pre-colored (no fade).
+	backend.BeginSprites(sheet);
+	for (int shape = 0; shape < SnowField::SHAPE_COUNT; ++shape)
+	{
+		const size_t first = sprites.ShapeBegin[shape];
+		const size_t count = sprites.ShapeBegin[shape + 1] - first;
+		if (count == 0) continue;
+
+		const float cellX = static_cast<float>(shape % 2) * 0.5f;
+		const float cellY = static_cast<float>(shape / 2) * 0.5f;
+		backend.AddSprites({ cellX, cellY, cellX + 0.5f, cellY + 0.5f }, sprites.Dests.data() + first,
+		                   sprites.Transforms.data() + first, nullptr, count);
+	}
+	backend.EndSprites();
+}
+
+void SnowRenderer::DrawSimpleSnowflake(RenderBackend& rt, Vector2 center, float size, const RenderBackend::Color& color)
+{
+	// For simple snowflakes, just draw an ellipse with slight variations
+	const float radiusX = 1.0f * size;
+	const float radiusY = 0.7f * size;
+
+	// Draw the ellipse
+	rt.FillEllipse(center, radiusX, radiusY, color);
+}
+
+void SnowRenderer::DrawCrystalSnowflake(RenderBackend& rt, Vector2 center, float size, const RenderBackend::Color& color)
+{
+	// Draw a small center circle
+	rt.FillEllipse(center, size * 0.5f, size * 0.5f, color);
+
+	// Draw 6 arms for the crystal (60 degrees apart)
+	const int numArms = 6;
+	const float baseLength = size * 2.0f;
+
+	for (int i = 0; i < numArms; i++)
+	{
+		float angle = (i * TWO_PI) / numArms;
+		float endX = center.x + cos(angle) * baseLength;
+		float endY = center.y + sin(angle) * baseLength;
+
+		// Create a line for each arm
+		Vector2 endPoint = Vector2(endX, endY);
+
+		// Draw the main arm
+		rt.DrawLine(center, endPoint, size * 0.2f, color);
+
+		// Draw small branches (2 per arm)
+		float branchLength = baseLength * 0.4f;
+		float branchAngleOffset = 30.0f * (PI / 180.0f); // 30 degrees
+
+		float midX = center.x + cos(angle) * baseLength * 0.6f;
+		float midY = center.y + sin(angle) * baseLength * 0.6f;
+		Vector2 midPoint = Vector2(midX, midY);
+
+		// First branch
+		float branch1Angle = angle + branchAngleOffset;
+		float branch1EndX = midX + cos(branch1Angle) * branchLength;
+		float branch1EndY = midY + sin(branch1Angle) * branchLength;
+		Vector2 branch1End = Vector2(branch1EndX, branch1EndY);
+		rt.DrawLine(midPoint, branch1End, size * 0.15f, color);
+
+		// Second branch
+		float branch2Angle = angle - branchAngleOffset;
+		float branch2EndX = midX + cos(branch2Angle) * branchLength;
+		float branch2EndY = midY + sin(branch2Angle) * branchLength;
+		Vector2 branch2End = Vector2(branch2EndX, branch2EndY);
+		rt.DrawLine(midPoint, branch2End, size * 0.15f, color);
+	}
+}
+
+void SnowRenderer::DrawHexagonSnowflake(RenderBackend& rt, Vector2 center, float size, const RenderBackend::Color& color)
+{
+	// Draw a hexagon shape using lines
+	constexpr int sides = 6;
+	const float radius = size * 2.0f;
+
+	// Stack-allocated array — no heap, no leak risk (sides + 1 = 7)
+	std::array<Vector2, 7> points;
+
+	for (int i = 0; i <= sides; ++i) {
+		const float angle = i * TWO_PI / sides;
+		points[i] = Vector2(
+			center.x + radius * std::cos(angle),
+			center.y + radius * std::sin(angle)
+		);
+	}
+
+	// Draw the hexagon outline
+	for (int i = 0; i < sides; ++i) {
+		rt.DrawLine(points[i], points[i + 1], size * 0.2f, color);
+	}
+
+	// Draw inner details (spokes)
+	for (int i = 0; i < sides; ++i) {
+		rt.DrawLine(
+			center,
+			points[i],
+			size * 0.15f,
+			color
+		);
+	}
+
+	// Draw center circle
+	rt.FillEllipse(center, size * 0.4f, size * 0.4f, color);
+}
+
+void SnowRenderer::DrawStarSnowflake(RenderBackend& rt, Vector2 center, float size, const RenderBackend::Color& color)
+{
+	// Draw a small center circle
+	rt.FillEllipse(center, size * 0.4f, size * 0.4f, color);
+
+	// Draw a star pattern with 12 spikes
+	const int numSpikes = 12;
+	const float outerRadius = size * 2.5f;
+	const float innerRadius = size * 1.0f;
+
+	for (int i = 0; i < numSpikes; i++)
+	{
+		float angle = (i * TWO_PI) / numSpikes;
+
+		// Main spike
+		float endX = center.x + cos(angle) * outerRadius;
+		float endY = center.y + sin(angle) * outerRadius;
+		Vector2 endPoint = Vector2(endX, endY);
+
+		// Draw the spike
+		rt.DrawLine(center, endPoint, size * 0.15f, color);
+
+		// Draw small intersecting lines between main spikes
+		if (i % 2 == 0) {
+			float crossAngle = angle + (TWO_PI / numSpikes / 2);
+			float crossX = center.x + cos(crossAngle) * innerRadius;
+			float crossY = center.y + sin(crossAngle) * innerRadius;
+			Vector2 crossPoint = Vector2(crossX, crossY);
+
+			rt.DrawLine(center, crossPoint, size * 0.1f, color);
+		}
+	}
+}
+
+void SnowRenderer::DrawSettledSnow(RenderBackend& backend, const SnowGrid& grid, SnowRaster& raster,
+                                   const SimulationData* pSimData, const RenderBackend::Color& color)
+{
+	if (grid.Width() <= 0 || grid.Height() <= 0) return;
+
+	// One image pixel per grid cell. A backend that (re)created its copy of the
+	// image gets every row again.
+	if (backend.ResizeImage(grid.Width(), grid.Height()))
+	{
+		raster.Invalidate();
+	}
+
+	// Each cell is padded to a DPI-scaled square so the pile stays visible.
+	const int radius = static_cast<int>(pSimData->ScaleFactor + 0.5f);
+	if (raster.Update(grid, radius, SnowRaster::PackBgra(color.R, color.G, color.B, color.A)))
+	{
+		// Upload only the rows that changed.
+		backend.UploadImageRows(raster);
+	}
+
+	backend.DrawImage(static_cast<float>(pSimData->SceneRect.left), static_cast<float>(pSimData->SceneRect.top));
+}
+
+void SnowRenderer::DrawSettledSnowSimple(RenderBackend& backend, const std::vector<float>& columnHeights,
+                                         const SimulationData* pSimData, const RenderBackend::Color& color)
+{
+	const std::vector<float>& h = columnHeights;
+	const int numCols = static_cast<int>(h.size());
+	const int width = pSimData->Width;
+	const int cellW = pSimData->SnowColumnWidth;
+	if (numCols < 1 || width < 1 || cellW < 1) return;
+
+	const float left = static_cast<float>(pSimData->SceneRect.left);
+	const float top = static_cast<float>(pSimData->SceneRect.top);
+	const float bottom = top + pSimData->Height;
+
+	// Filled silhouette: left edge -> across the coarse column tops -> right edge.
+	// The outline keeps its capacity between frames (drawn on the render thread only).
+	static thread_local std::vector<Vector2> outline;
+	outline.clear();
+	outline.emplace_back(left, bottom);
+	for (int i = 0; i < numCols; ++i)
+	{
+		outline.emplace_back(left + static_cast<float>(i * cellW), bottom - h[i]);
+	}
+	// Extend the last column's height to the right edge, then close along the bottom.
+	outline.emplace_back(left + static_cast<float>(width), bottom - h[numCols - 1]);
+	outline.emplace_back(left + static_cast<float>(width), bottom);
+
+	backend.FillPolygon(outline.data(), outline.size(), color);
+}
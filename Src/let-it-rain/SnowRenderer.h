@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+#include "RenderBackend.h"
+#include "SimulationData.h"
+#include "SnowField.h"
+#include "SnowGrid.h"
+#include "SnowRaster.h"
+
+// SnowRenderer Class
+// Drawing for a display's snow, from a frame, through a RenderBackend: falling
+// flakes as one sprite batch from a pre-colored shape atlas, and the settled
+// heap in either mode. The simulation (SnowField) carries no drawing code, so
+// it builds without Direct2D.
+class SnowRenderer
+{
+public:
+	// Draw all falling flakes in one batched sprite call, from the shape-grouped
+	// sprite list of the frame (FrameGeometry::Flakes). The backend's flake
+	// atlas is built in `color` when missing (ReleaseSpriteSheets on a color change).
+	static void DrawFallingFlakes(RenderBackend& backend, const SnowField::SpriteList& sprites,
+	                              const RenderBackend::Color& color);
+	// Per-pixel mode: the settled grid as one image. `raster` persists between
+	// frames and only rasterizes the rows that changed since the last draw;
+	// only those are uploaded to the backend.
+	static void DrawSettledSnow(RenderBackend& backend, const SnowGrid& grid, SnowRaster& raster,
+	                            const SimulationData* pSimData, const RenderBackend::Color& color);
+	// "Simple snow heap" mode: the per-column heightmap as a single filled silhouette.
+	static void DrawSettledSnowSimple(RenderBackend& backend, const std::vector<float>& columnHeights,
+	                                  const SimulationData* pSimData, const RenderBackend::Color& color);
+
+	// Flake sprite half-size per unit radius at a display's scale factor; the
+	// simulation thread builds the sprites with it (FrameSnapshot::CaptureSnow).
+	static float FlakeHalfSizePerRadius(const float scaleFactor) { return SNOW_DRAW_SCALE * scaleFactor; }
+
+private:
+	// On-screen half-size (px) per unit radius before DPI scaling (macOS kExtent).
+	// ↑ visually bigger flakes (same radii); ↓ smaller. Does not affect physics.
+	static constexpr float SNOW_DRAW_SCALE = 2.5f;
+
+	// Resolution for pre-rendered sprites
+	static constexpr float SPRITE_SIZE = 64.0f/8;
+	// Base size used during pre-rendering to fit within SPRITE_SIZE
+	static constexpr float SPRITE_BASE_DRAW_SIZE = 15.0f/8;
+
+	// Draw the four shapes into the 2x2 atlas sheet.
+	static void DrawAtlasCells(RenderBackend& sheet, const RenderBackend::Color& color);
+
+	// Helper methods for drawing each shape into the atlas sheet.
+	static void DrawSimpleSnowflake(RenderBackend& rt, Vector2 center, float size, const RenderBackend::Color& color);
+	static void DrawCrystalSnowflake(RenderBackend& rt, Vector2 center, float size, const RenderBackend::Color& color);
+	static void DrawHexagonSnowflake(RenderBackend& rt, Vector2 center, float size, const RenderBackend::Color& color);
+	static void DrawStarSnowflake(RenderBackend& rt, Vector2 center, float size, const RenderBackend::Color& color);
+};
@@ -0,0 +1,520 @@
+#include "SoftwareRenderBackend.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// Length of [center - half, center + half] inside the pixel [-0.5, 0.5].
+	float Overlap(const float center, const float half)
+	{
+		const float covered = (std::min)(center + half, 0.5f) - (std::max)(center - half, -0.5f);
+		return (std::min)((std::max)(covered, 0.0f), 1.0f);
+	}
+
+	// Narrow [lo, hi] to the x for which slope * x + offset lies in [min, max].
+	void NarrowRange(const float slope, const float offset, const float min, const float max, float& lo, float& hi)
+	{
+		if (std::fabs(slope) < 1e-6f)
+		{
+			if (offset < min || offset > max) hi = lo - 1.0f;
+			return;
+		}
+		float a = (min - offset) / slope;
+		float b = (max - offset) / slope;
+		if (a > b) std::swap(a, b);
+		lo = (std::max)(lo, a);
+		hi = (std::min)(hi, b);
+	}
+
+	// Keeps far-off geometry from overflowing int pixel coordinates.
+	float ClampCoordinate(const float v)
+	{
+		return (std::max)((std::min)(v, 1e6f), -1e6f);
+	}
+}
+
+SoftwareRenderBackend::SoftwareRenderBackend(const int width, const int height)
+	: BufferWidth((std::max)(width, 0)), BufferHeight((std::max)(height, 0)),
+	  Buffer(static_cast<size_t>(BufferWidth) * BufferHeight, 0)
+{
+}
+
+void SoftwareRenderBackend::Clear(const uint32_t bgra)
+{
+	std::fill(Buffer.begin(), Buffer.end(), bgra);
+}
+
+void SoftwareRenderBackend::PushClip(const float left, const float top, const float right, const float bottom)
+{
+	// Pixels whose centers fall inside the rectangle.
+	const auto snap = [](const float v) { return static_cast<int>(std::floor(ClampCoordinate(v) + 0.5f)); };
+	const ClipRect outer = Clips.empty() ? ClipRect{ 0, 0, BufferWidth, BufferHeight } : Clips.back();
+	ClipRect clip = { (std::max)(snap(left), outer.Left), (std::max)(snap(top), outer.Top),
+	                  (std::min)(snap(right), outer.Right), (std::min)(snap(bottom), outer.Bottom) };
+	clip.Right = (std::max)(clip.Right, clip.Left);
+	clip.Bottom = (std::max)(clip.Bottom, clip.Top);
+	Clips.push_back(clip);
+}
+
+void SoftwareRenderBackend::PopClip()
+{
+	if (!Clips.empty()) Clips.pop_back();
+}
+
+bool SoftwareRenderBackend::ClipBounds(const float left, const float top, const float right, const float bottom,
+                                       ClipRect& out) const
+{
+	const ClipRect clip = Clips.empty() ? ClipRect{ 0, 0, BufferWidth, BufferHeight } : Clips.back();
+	const auto lower = [](const float v) { return static_cast<int>(std::floor(ClampCoordinate(v))); };
+	const auto upper = [](const float v) { return static_cast<int>(std::ceil(ClampCoordinate(v))); };
+	out.Left = (std::max)(lower(left), clip.Left);
+	out.Top = (std::max)(lower(top), clip.Top);
+	out.Right = (std::min)(upper(right), clip.Right);
+	out.Bottom = (std::min)(upper(bottom), clip.Bottom);
+	return out.Left < out.Right && out.Top < out.Bottom;
+}
+
+void SoftwareRenderBackend::DrawLine(const Vector2 start, const Vector2 end, const float width, const Color& color)
+{
+	const float dx = end.x - start.x;
+	const float dy = end.y - start.y;
+	const float length = std::sqrt(dx * dx + dy * dy);
+	if (length < 1e-6f || width <= 0.0f) return;
+
+	// Line frame: t along the line from start, d across it.
+	const float ux = dx / length;
+	const float uy = dy / length;
+	// Aliased lines light the pixels whose centers are inside, at least one pixel wide.
+	const float half = Antialias ? width * 0.5f : (std::max)(width, 1.0f) * 0.5f;
+	const float reach = half + 1.0f;
+
+	ClipRect bounds;
+	if (!ClipBounds((std::min)(start.x, end.x) - reach, (std::min)(start.y, end.y) - reach,
+	                (std::max)(start.x, end.x) + reach, (std::max)(start.y, end.y) + reach, bounds)) return;
+
+	const Premultiplied source = Premultiply(color);
+	for (int y = bounds.Top; y < bounds.Bottom; ++y)
+	{
+		const float cy = static_cast<float>(y) + 0.5f - start.y;
+		// Only the stretch of the row near the line's rectangle.
+		float lo = static_cast<float>(bounds.Left) + 0.5f - start.x;
+		float hi = static_cast<float>(bounds.Right) - 0.5f - start.x;
+		NarrowRange(-uy, cy * ux, -reach, reach, lo, hi);
+		NarrowRange(ux, cy * uy, -1.0f, length + 1.0f, lo, hi);
+		if (lo > hi) continue;
+		const int x0 = (std::max)(static_cast<int>(std::floor(start.x + lo - 0.5f)), bounds.Left);
+		const int x1 = (std::min)(static_cast<int>(std::ceil(start.x + hi - 0.5f)) + 1, bounds.Right);
+
+		uint32_t* row = Buffer.data() + static_cast<size_t>(y) * BufferWidth;
+		for (int x = x0; x < x1; ++x)
+		{
+			const float cx = static_cast<float>(x) + 0.5f - start.x;
+			const float t = cx * ux + cy * uy;
+			const float d = cy * ux - cx * uy;
+			float coverage;
+			if (Antialias)
+			{
+				coverage = Overlap(d, half) * Overlap(t - length * 0.5f, length * 0.5f);
+			}
+			else
+			{
+				coverage = std::fabs(d) <= half && t >= 0.0f && t < length ? 1.0f : 0.0f;
+			}
+			if (coverage > 0.0f) Blend(row[x], source, coverage);
+		}
+	}
+}
+
+void SoftwareRenderBackend::FillEllipse(const Vector2 center, const float radiusX, const float radiusY,
+                                        const Color& color)
+{
+	if (radiusX <= 0.0f || radiusY <= 0.0f) return;
+
+	ClipRect bounds;
+	if (!ClipBounds(center.x - radiusX, center.y - radiusY, center.x + radiusX, center.y + radiusY, bounds)) return;
+
+	const float invX = 1.0f / radiusX;
+	const float invY = 1.0f / radiusY;
+	const auto inside = [&](const float px, const float py)
+	{
+		const float nx = (px - center.x) * invX;
+		const float ny = (py - center.y) * invY;
+		return nx * nx + ny * ny <= 1.0f;
+	};
+
+	const Premultiplied source = Premultiply(color);
+	constexpr float sampleWeight = 1.0f / (ELLIPSE_SUBSAMPLES * ELLIPSE_SUBSAMPLES);
+	for (int y = bounds.Top; y < bounds.Bottom; ++y)
+	{
+		const float py = static_cast<float>(y);
+		uint32_t* row = Buffer.data() + static_cast<size_t>(y) * BufferWidth;
+		for (int x = bounds.Left; x < bounds.Right; ++x)
+		{
+			const float px = static_cast<float>(x);
+			float coverage;
+			if (!Antialias)
+			{
+				coverage = inside(px + 0.5f, py + 0.5f) ? 1.0f : 0.0f;
+			}
+			else if (inside(px, py) && inside(px + 1.0f, py) && inside(px, py + 1.0f) && inside(px + 1.0f, py + 1.0f))
+			{
+				// The ellipse is convex, so a pixel with all four corners inside is covered.
+				coverage = 1.0f;
+			}
+			else
+			{
+				int hits = 0;
+				for (int sy = 0; sy < ELLIPSE_SUBSAMPLES; ++sy)
+				{
+					const float sampleY = py + (static_cast<float>(sy) + 0.5f) / ELLIPSE_SUBSAMPLES;
+					for (int sx = 0; sx < ELLIPSE_SUBSAMPLES; ++sx)
+					{
+						hits += inside(px + (static_cast<float>(sx) + 0.5f) / ELLIPSE_SUBSAMPLES, sampleY) ? 1 : 0;
+					}
+				}
+				coverage = static_cast<float>(hits) * sampleWeight;
+			}
+			if (coverage > 0.0f) Blend(row[x], source, coverage);
+		}
+	}
+}
+
+void SoftwareRenderBackend::FillPolygon(const Vector2* points, const size_t count, const Color& color)
+{
+	if (count < 3) return;
+	FillFigures(points, count, 1, false, color);
+}
+
+void SoftwareRenderBackend::FillQuads(const Vector2* corners, const size_t quadCount, const Color& color)
+{
+	if (quadCount == 0) return;
+	FillFigures(corners, 4, quadCount, true, color);
+}
+
+void SoftwareRenderBackend::FillFigures(const Vector2* points, const size_t figureSize, const size_t figureCount,
+                                        const bool nonzero, const Color& color)
+{
+	// Every edge of every figure, with the winding it adds where it crosses a
+	// scanline (+1 downwards). Horizontal edges never cross one.
+	Edges.clear();
+	float minX = points[0].x, maxX = points[0].x, minY = points[0].y, maxY = points[0].y;
+	for (size_t f = 0; f < figureCount; ++f)
+	{
+		const Vector2* figure = points + f * figureSize;
+		for (size_t i = 0; i < figureSize; ++i)
+		{
+			const Vector2& a = figure[i];
+			const Vector2& b = figure[i + 1 < figureSize ? i + 1 : 0];
+			minX = (std::min)(minX, a.x);
+			maxX = (std::max)(maxX, a.x);
+			minY = (std::min)(minY, a.y);
+			maxY = (std::max)(maxY, a.y);
+			if (a.y == b.y) continue;
+			Edges.push_back({ a, b, (std::min)(a.y, b.y), (std::max)(a.y, b.y), b.y > a.y ? 1 : -1 });
+		}
+	}
+	ClipRect bounds;
+	if (Edges.empty() || !ClipBounds(minX, minY, maxX, maxY, bounds)) return;
+
+	// Edges join the active list in order of their top as the sub-scanlines
+	// move down, and leave it below their bottom. The list is kept sorted by
+	// crossing; from one sub-scanline to the next edges rarely swap places.
+	std::sort(Edges.begin(), Edges.end(), [](const Edge& l, const Edge& r) { return l.Top < r.Top; });
+	Crossings.clear();
+	size_t nextEdge = 0;
+
+	const Premultiplied source = Premultiply(color);
+	const int samples = Antialias ? POLYGON_SUBSAMPLES : 1;
+	const float sampleWeight = 1.0f / static_cast<float>(samples);
+	const int rowWidth = bounds.Right - bounds.Left;
+	const float clipLeft = static_cast<float>(bounds.Left);
+	const float clipRight = static_cast<float>(bounds.Right);
+	const auto isInside = [nonzero](const int winding) { return nonzero ? winding != 0 : (winding & 1) != 0; };
+
+	// Zeroed once here; each row clears only the pixels it touched.
+	RowCoverage.assign(static_cast<size_t>(rowWidth), 0.0f);
+	for (int y = bounds.Top; y < bounds.Bottom; ++y)
+	{
+		int touchedBegin = bounds.Right;
+		int touchedEnd = bounds.Left;
+
+		// Box-filtered horizontal coverage of one inside span: partial end
+		// pixels, full ones between.
+		const auto addSpan = [&](const float spanBegin, const float spanEnd)
+		{
+			float x0 = (std::max)(spanBegin, clipLeft);
+			float x1 = (std::min)(spanEnd, clipRight);
+			if (!Antialias)
+			{
+				// Pixels whose centers are inside.
+				x0 = std::ceil(x0 - 0.5f);
+				x1 = std::ceil(x1 - 0.5f);
+			}
+			if (x1 <= x0) return;
+
+			float* cell = RowCoverage.data() - bounds.Left;
+			const int ix0 = static_cast<int>(std::floor(x0));
+			const int ix1 = static_cast<int>(std::floor(x1));
+			touchedBegin = (std::min)(touchedBegin, ix0);
+			touchedEnd = (std::max)(touchedEnd, (std::min)(ix1 + 1, bounds.Right));
+			if (ix0 == ix1)
+			{
+				cell[ix0] += (x1 - x0) * sampleWeight;
+				return;
+			}
+			cell[ix0] += (static_cast<float>(ix0 + 1) - x0) * sampleWeight;
+			for (int x = ix0 + 1; x < ix1; ++x) cell[x] += sampleWeight;
+			if (ix1 < bounds.Right) cell[ix1] += (x1 - static_cast<float>(ix1)) * sampleWeight;
+		};
+
+		for (int s = 0; s < samples; ++s)
+		{
+			const float sampleY = static_cast<float>(y) + (static_cast<float>(s) + 0.5f) / static_cast<float>(samples);
+
+			// Where the active edges cross this sub-scanline (half-open in y, so
+			// shared vertices count once).
+			Crossings.erase(std::remove_if(Crossings.begin(), Crossings.end(),
+			                               [&](const Crossing& c) { return Edges[c.EdgeIndex].Bottom <= sampleY; }),
+			                Crossings.end());
+			for (; nextEdge < Edges.size() && Edges[nextEdge].Top <= sampleY; ++nextEdge)
+			{
+				if (Edges[nextEdge].Bottom > sampleY) Crossings.push_back({ 0.0f, Edges[nextEdge].Winding, nextEdge });
+			}
+			if (Crossings.empty()) continue;
+			for (Crossing& crossing : Crossings)
+			{
+				const Vector2& a = Edges[crossing.EdgeIndex].A;
+				const Vector2& b = Edges[crossing.EdgeIndex].B;
+				crossing.X = a.x + (sampleY - a.y) * (b.x - a.x) / (b.y - a.y);
+			}
+			// Insertion sort: linear on the nearly sorted list.
+			for (size_t i = 1; i < Crossings.size(); ++i)
+			{
+				const Crossing crossing = Crossings[i];
+				size_t j = i;
+				for (; j > 0 && Crossings[j - 1].X > crossing.X; --j) Crossings[j] = Crossings[j - 1];
+				Crossings[j] = crossing;
+			}
+
+			// One span from where the winding turns inside to where it turns
+			// outside again, so overlapping figures cover a pixel only once.
+			int winding = 0;
+			float spanBegin = 0.0f;
+			for (const Crossing& crossing : Crossings)
+			{
+				const bool wasInside = isInside(winding);
+				winding += crossing.Winding;
+				const bool nowInside = isInside(winding);
+				if (!wasInside && nowInside) spanBegin = crossing.X;
+				else if (wasInside && !nowInside) addSpan(spanBegin, crossing.X);
+			}
+		}
+
+		uint32_t* row = Buffer.data() + static_cast<size_t>(y) * BufferWidth;
+		float* cell = RowCoverage.data() - bounds.Left;
+		for (int x = touchedBegin; x < touchedEnd; ++x)
+		{
+			if (cell[x] > 0.0f) Blend(row[x], source, (std::min)(cell[x], 1.0f));
+			cell[x] = 0.0f;
+		}
+	}
+}
+
+void SoftwareRenderBackend::BuildSpriteSheet(const SpriteSheet sheet, const float width, const float height,
+                                             const std::function<void(RenderBackend&)>& draw)
+{
+	auto target = std::make_unique<SoftwareRenderBackend>((std::max)(static_cast<int>(std::ceil(width)), 1),
+	                                                      (std::max)(static_cast<int>(std::ceil(height)), 1));
+	draw(*target);
+	Sheets[static_cast<int>(sheet)] = std::move(target);
+}
+
+void SoftwareRenderBackend::ReleaseSpriteSheets()
+{
+	for (std::unique_ptr<SoftwareRenderBackend>& sheet : Sheets) sheet.reset();
+	SpriteSource = nullptr;
+}
+
+void SoftwareRenderBackend::AddSprites(const SpriteRect& source, const SpriteRect* dests,
+                                       const SpriteTransform* transforms, const float* alphas, const size_t count)
+{
+	if (SpriteSource == nullptr) return;
+
+	// Source rectangle in sheet pixels.
+	const SoftwareRenderBackend& sheet = *SpriteSource;
+	const int srcLeft = static_cast<int>(source.Left * static_cast<float>(sheet.Width()) + 0.5f);
+	const int srcTop = static_cast<int>(source.Top * static_cast<float>(sheet.Height()) + 0.5f);
+	const int srcRight = static_cast<int>(source.Right * static_cast<float>(sheet.Width()) + 0.5f);
+	const int srcBottom = static_cast<int>(source.Bottom * static_cast<float>(sheet.Height()) + 0.5f);
+	const float srcW = static_cast<float>(srcRight - srcLeft);
+	const float srcH = static_cast<float>(srcBottom - srcTop);
+	if (srcW <= 0.0f || srcH <= 0.0f) return;
+
+	constexpr SpriteTransform identity = { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+	for (size_t i = 0; i < count; ++i)
+	{
+		const SpriteRect& rect = dests[i];
+		const SpriteTransform& m = transforms != nullptr ? transforms[i] : identity;
+		const float alpha = alphas != nullptr ? alphas[i] : 1.0f;
+		const float det = m.M11 * m.M22 - m.M12 * m.M21;
+		const float rectW = rect.Right - rect.Left;
+		const float rectH = rect.Bottom - rect.Top;
+		if (std::fabs(det) < 1e-9f || rectW <= 0.0f || rectH <= 0.0f || alpha <= 0.0f) continue;
+
+		// Destination bounds: the rectangle's corners through the transform
+		// (row vectors, as Direct2D: p' = p * M).
+		const float cornersX[4] = { rect.Left, rect.Right, rect.Left, rect.Right };
+		const float cornersY[4] = { rect.Top, rect.Top, rect.Bottom, rect.Bottom };
+		float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+		for (int c = 0; c < 4; ++c)
+		{
+			const float tx = cornersX[c] * m.M11 + cornersY[c] * m.M21 + m.Dx;
+			const float ty = cornersX[c] * m.M12 + cornersY[c] * m.M22 + m.Dy;
+			minX = (std::min)(minX, tx);
+			maxX = (std::max)(maxX, tx);
+			minY = (std::min)(minY, ty);
+			maxY = (std::max)(maxY, ty);
+		}
+		ClipRect bounds;
+		if (!ClipBounds(minX, minY, maxX, maxY, bounds)) continue;
+
+		// Each pixel center back into the rectangle, then into the source.
+		const float invDet = 1.0f / det;
+		const float scaleU = srcW / rectW;
+		const float scaleV = srcH / rectH;
+		for (int y = bounds.Top; y < bounds.Bottom; ++y)
+		{
+			const float py = static_cast<float>(y) + 0.5f - m.Dy;
+			uint32_t* row = Buffer.data() + static_cast<size_t>(y) * BufferWidth;
+			for (int x = bounds.Left; x < bounds.Right; ++x)
+			{
+				const float px = static_cast<float>(x) + 0.5f - m.Dx;
+				const float lx = (px * m.M22 - py * m.M21) * invDet;
+				const float ly = (py * m.M11 - px * m.M12) * invDet;
+				const float u = (lx - rect.Left) * scaleU;
+				const float v = (ly - rect.Top) * scaleV;
+				if (u < 0.0f || v < 0.0f || u >= srcW || v >= srcH) continue;
+				uint32_t texel = SampleSheet(sheet, u, v, srcLeft, srcTop, srcRight, srcBottom);
+				if (alpha < 1.0f) texel = Fade(texel, alpha);
+				if (texel != 0) BlendPixel(row[x], texel);
+			}
+		}
+	}
+}
+
+uint32_t SoftwareRenderBackend::SampleSheet(const SoftwareRenderBackend& sheet, const float u, const float v,
+                                            const int x0, const int y0, const int x1, const int y1)
+{
+	// Texel centers sit at half-pixel offsets; neighbours are clamped to the source.
+	const float fx = u - 0.5f;
+	const float fy = v - 0.5f;
+	const int ix = static_cast<int>(std::floor(fx));
+	const int iy = static_cast<int>(std::floor(fy));
+	const float wx = fx - static_cast<float>(ix);
+	const float wy = fy - static_cast<float>(iy);
+	const auto texel = [&](const int tx, const int ty)
+	{
+		return sheet.Pixel((std::min)((std::max)(x0 + tx, x0), x1 - 1), (std::min)((std::max)(y0 + ty, y0), y1 - 1));
+	};
+	const uint32_t p00 = texel(ix, iy);
+	const uint32_t p10 = texel(ix + 1, iy);
+	const uint32_t p01 = texel(ix, iy + 1);
+	const uint32_t p11 = texel(ix + 1, iy + 1);
+	if ((p00 | p10 | p01 | p11) == 0) return 0;
+
+	uint32_t result = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		const float top = static_cast<float>(p00 >> shift & 0xFF) * (1.0f - wx) + static_cast<float>(p10 >> shift & 0xFF) * wx;
+		const float bottom = static_cast<float>(p01 >> shift & 0xFF) * (1.0f - wx) + static_cast<float>(p11 >> shift & 0xFF) * wx;
+		result |= static_cast<uint32_t>(top * (1.0f - wy) + bottom * wy + 0.5f) << shift;
+	}
+	return result;
+}
+
+uint32_t SoftwareRenderBackend::Fade(const uint32_t pixel, const float alpha)
+{
+	uint32_t result = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		result |= static_cast<uint32_t>(static_cast<float>(pixel >> shift & 0xFF) * alpha + 0.5f) << shift;
+	}
+	return result;
+}
+
+bool SoftwareRenderBackend::ResizeImage(const int width, const int height)
+{
+	if (width == ImageWidth && height == ImageHeight && !Image.empty()) return false;
+	ImageWidth = (std::max)(width, 0);
+	ImageHeight = (std::max)(height, 0);
+	Image.assign(static_cast<size_t>(ImageWidth) * ImageHeight, 0);
+	return true;
+}
+
+void SoftwareRenderBackend::UploadImageRows(const SnowRaster& raster)
+{
+	if (raster.Width() != ImageWidth || raster.Height() != ImageHeight) return;
+	for (const SnowRaster::Span& span : raster.DirtySpans())
+	{
+		const size_t pixels = static_cast<size_t>(span.End - span.Begin) * ImageWidth;
+		std::copy(raster.Pixels() + span.Offset, raster.Pixels() + span.Offset + pixels,
+		          Image.begin() + static_cast<size_t>(span.Begin) * ImageWidth);
+	}
+}
+
+void SoftwareRenderBackend::DrawImage(const float left, const float top)
+{
+	// Nearest neighbour at one pixel per pixel: a whole-pixel offset.
+	const int offsetX = static_cast<int>(std::floor(left + 0.5f));
+	const int offsetY = static_cast<int>(std::floor(top + 0.5f));
+	ClipRect bounds;
+	if (!ClipBounds(static_cast<float>(offsetX), static_cast<float>(offsetY), static_cast<float>(offsetX + ImageWidth),
+	                static_cast<float>(offsetY + ImageHeight), bounds)) return;
+
+	for (int y = bounds.Top; y < bounds.Bottom; ++y)
+	{
+		const uint32_t* src = Image.data() + static_cast<size_t>(y - offsetY) * ImageWidth - offsetX;
+		uint32_t* row = Buffer.data() + static_cast<size_t>(y) * BufferWidth;
+		for (int x = bounds.Left; x < bounds.Right; ++x)
+		{
+			if (src[x] != 0) BlendPixel(row[x], src[x]);
+		}
+	}
+}
+
+SoftwareRenderBackend::Premultiplied SoftwareRenderBackend::Premultiply(const Color& color)
+{
+	const auto unit = [](const float v) { return (std::min)((std::max)(v, 0.0f), 1.0f); };
+	const float alpha = unit(color.A) * 255.0f;
+	return { unit(color.B) * alpha, unit(color.G) * alpha, unit(color.R) * alpha, alpha };
+}
+
+void SoftwareRenderBackend::Blend(uint32_t& pixel, const Premultiplied& color, const float coverage)
+{
+	const float keep = 1.0f - color.A * coverage / 255.0f;
+	const auto channel = [&](const float source, const int shift)
+	{
+		const float value = source * coverage + static_cast<float>(pixel >> shift & 0xFF) * keep;
+		return static_cast<uint32_t>((std::min)(value + 0.5f, 255.0f)) << shift;
+	};
+	pixel = channel(color.B, 0) | channel(color.G, 8) | channel(color.R, 16) | channel(color.A, 24);
+}
+
+void SoftwareRenderBackend::BlendPixel(uint32_t& pixel, const uint32_t source)
+{
+	const uint32_t alpha = source >> 24;
+	if (alpha == 255 || pixel == 0)
+	{
+		pixel = source;
+		return;
+	}
+	const uint32_t keep = 255 - alpha;
+	uint32_t result = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		const uint32_t value = (source >> shift & 0xFF) + ((pixel >> shift & 0xFF) * keep + 127) / 255;
+		result |= (std::min)(value, 255u) << shift;
+	}
+	pixel = result;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "RenderBackend.h"
+
+// SoftwareRenderBackend Class
+// CPU implementation of RenderBackend: rasterizes into a 32-bit premultiplied
+// BGRA buffer (the swap chain's format), source-over. Edges get box-filtered
+// coverage (analytic for lines, 4x4 samples on ellipse edges, 4 sub-scanlines
+// for polygons); sprites sample their sheet bilinearly with aliased edges
+// and the settled-snow image is copied one pixel per pixel, as on Direct2D.
+// Output is close to, not bit-identical with, Direct2D's. Used headless: golden
+// images of the renderers and draw-path benchmarks off Windows.
+class SoftwareRenderBackend final : public RenderBackend
+{
+public:
+	SoftwareRenderBackend(int width, int height);
+
+	// Fill the whole buffer (ignores the clip) with a premultiplied pixel.
+	void Clear(uint32_t bgra = 0);
+
+	int Width() const { return BufferWidth; }
+	int Height() const { return BufferHeight; }
+	// Row-major, Width() pixels per row.
+	const uint32_t* Pixels() const { return Buffer.data(); }
+	uint32_t Pixel(const int x, const int y) const { return Buffer[static_cast<size_t>(y) * BufferWidth + x]; }
+
+	void SetAntialiasing(bool enabled) override { Antialias = enabled; }
+	void PushClip(float left, float top, float right, float bottom) override;
+	void PopClip() override;
+
+	void DrawLine(Vector2 start, Vector2 end, float width, const Color& color) override;
+	void FillEllipse(Vector2 center, float radiusX, float radiusY, const Color& color) override;
+	void FillPolygon(const Vector2* points, size_t count, const Color& color) override;
+	// All quads in one scanline pass (nonzero winding), so overlaps blend once.
+	void FillQuads(const Vector2* corners, size_t quadCount, const Color& color) override;
+
+	bool HasSpriteSheet(SpriteSheet sheet) const override { return Sheets[static_cast<int>(sheet)] != nullptr; }
+	void BuildSpriteSheet(SpriteSheet sheet, float width, float height,
+	                      const std::function<void(RenderBackend&)>& draw) override;
+	void ReleaseSpriteSheets() override;
+	// Sprites are drawn as they are added; EndSprites has nothing left to do.
+	void BeginSprites(SpriteSheet sheet) override { SpriteSource = Sheets[static_cast<int>(sheet)].get(); }
+	void AddSprites(const SpriteRect& source, const SpriteRect* dests, const SpriteTransform* transforms,
+	                const float* alphas, size_t count) override;
+	void EndSprites() override { SpriteSource = nullptr; }
+
+	bool ResizeImage(int width, int height) override;
+	void UploadImageRows(const SnowRaster& raster) override;
+	void DrawImage(float left, float top) override;
+
+private:
+	// Pixel bounds [Left, Right) x [Top, Bottom).
+	struct ClipRect
+	{
+		int Left, Top, Right, Bottom;
+	};
+	// A polygon edge from A to B; Top/Bottom are its y extent and Winding is
+	// +1 when it runs downwards.
+	struct Edge
+	{
+		Vector2 A, B;
+		float Top, Bottom;
+		int Winding;
+	};
+	// Where an active edge crosses the current sub-scanline.
+	struct Crossing
+	{
+		float X;
+		int Winding;
+		size_t EdgeIndex;
+	};
+	// Premultiplied color in 0-255 channel units.
+	struct Premultiplied
+	{
+		float B, G, R, A;
+	};
+
+	// Sub-scanlines per pixel row for polygon coverage.
+	// ↑ smoother near-horizontal edges, slower; ↓ faster, more banding.
+	static constexpr int POLYGON_SUBSAMPLES = 4;
+	// Samples per axis on ellipse edge pixels (interior pixels are not sampled).
+	// ↑ smoother small splatters, slower; ↓ faster, blockier.
+	static constexpr int ELLIPSE_SUBSAMPLES = 4;
+
+	static Premultiplied Premultiply(const Color& color);
+	// Source-over of `color` scaled by `coverage` (0-1) onto a pixel.
+	static void Blend(uint32_t& pixel, const Premultiplied& color, float coverage);
+	// Source-over of a premultiplied pixel.
+	static void BlendPixel(uint32_t& pixel, uint32_t source);
+	// Bilinear sample of `sheet` inside [x0, x1) x [y0, y1) at (u, v) pixels.
+	static uint32_t SampleSheet(const SoftwareRenderBackend& sheet, float u, float v, int x0, int y0, int x1, int y1);
+	// Scale every channel of a premultiplied pixel (fade).
+	static uint32_t Fade(uint32_t pixel, float alpha);
+	// Scanline fill of figureCount closed figures of figureSize points each,
+	// nonzero or even-odd, with coverage accumulated per pixel over all of them.
+	void FillFigures(const Vector2* points, size_t figureSize, size_t figureCount, bool nonzero, const Color& color);
+	// Clamp a float bounding box to the clip; false when nothing is left.
+	bool ClipBounds(float left, float top, float right, float bottom, ClipRect& out) const;
+
+	int BufferWidth;
+	int BufferHeight;
+	std::vector<uint32_t> Buffer;
+	bool Antialias = true;
+	std::vector<ClipRect> Clips; // innermost last; each is already intersected with its parent
+
+	std::unique_ptr<SoftwareRenderBackend> Sheets[SPRITE_SHEET_COUNT];
+	const SoftwareRenderBackend* SpriteSource = nullptr; // sheet between BeginSprites and EndSprites
+
+	std::vector<uint32_t> Image; // copy of the settled-snow raster
+	int ImageWidth = 0;
+	int ImageHeight = 0;
+
+	// Polygon scratch, kept between calls.
+	std::vector<Edge> Edges;
+	std::vector<Crossing> Crossings; // the active edges, sorted by X
+	std::vector<float> RowCoverage;
+};
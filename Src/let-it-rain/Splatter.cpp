@@ -1,56 +1,56 @@
 #include "Splatter.h"
-#include "MathUtil.h"
-#include "RandomGenerator.h"
+#include "SimulationData.h"
 
-#include <d2d1.h>
+#include <algorithm>
 
-Splatter::Splatter(DisplayData* pDispData, const Vector2 pos, const Vector2 vel) :
-	pDisplayData(pDispData), Pos(pos), Vel(vel)
+Splatter::Splatter(const Vector2 pos, const Vector2 vel, const float radius, const double landingTime) :
+	Pos(pos), Vel(vel), Radius(radius), LandingTime(landingTime)
 {
-	// Create splatters with radius ranging from 1.0 to 2.0 pixels
-	Radius = (RandomGenerator::GetInstance().GenerateInt(15, 25) / 10.0f) * pDispData->ScaleFactor;
 	Pos.y = pos.y - Radius; // Slight adjustment
+	PrevPos = Pos;
 }
 
 Splatter::~Splatter() = default;
 
-void Splatter::UpdatePosition(const float deltaSeconds)
+void Splatter::UpdatePosition(const float deltaSeconds, const SimulationData* pSimData)
 {
+	PrevPos = Pos;
+
 	// Update the position of the raindrop
 	Pos.x += Vel.x * deltaSeconds;
 	Pos.y += Vel.y * deltaSeconds;
 
-	Vel.y += GRAVITY * pDisplayData->ScaleFactor * deltaSeconds; // gravity (per-second, DPI-scaled like the launch velocity)
-	Vel.x *= (1.0f - AIR_DAMP * deltaSeconds);                   // horizontal air drag (per-second; dimensionless rate, not DPI-scaled)
+	Vel.y += GRAVITY * pSimData->ScaleFactor * deltaSeconds; // gravity (per-second, DPI-scaled like the launch velocity)
+	Vel.x *= (1.0f - AIR_DAMP * deltaSeconds);                // horizontal air drag (per-second; dimensionless rate, not DPI-scaled)
 
 	// Check for bouncing against sides
-	if (Pos.x + Radius > pDisplayData->SceneRect.right || Pos.x - Radius <
-		pDisplayData->SceneRect.left)
+	if (Pos.x + Radius > pSimData->SceneRect.right || Pos.x - Radius <
+		pSimData->SceneRect.left)
 	{
 		Vel.x = -Vel.x;
 	}
 	// Check for bouncing against bottom border
-	if (Pos.y + Radius > pDisplayData->SceneRect.bottom)
+	if (Pos.y + Radius > pSimData->SceneRect.bottom)
 	{
-		Pos.y = pDisplayData->SceneRect.bottom - Radius; // Keep the ellipse within bounds
+		Pos.y = pSimData->SceneRect.bottom - Radius; // Keep the ellipse within bounds
 		Vel.y = -Vel.y * BOUNCE_DAMPING; // Bounce with damping
 		SplatterBounceCount++;
 	}
 	// Check for bouncing against top
-	if (Pos.y - Radius < pDisplayData->SceneRect.top)
+	if (Pos.y - Radius < pSimData->SceneRect.top)
 	{
 		Pos.y = Radius; // Keep the ellipse within bounds
 		Vel.y = -Vel.y; // Reverse the direction if it hits the top edge
 	}
 }
 
-void Splatter::Draw(ID2D1DeviceContext* dc, ID2D1SolidColorBrush* pBrush) const
+bool Splatter::IsExpired(const double now) const
 {
-	if (MathUtil::IsPointInRect(pDisplayData->SceneRect, Pos) &&
-		SplatterBounceCount < MAX_SPLATTER_BOUNCE_COUNT_)
-	{
-		// Define the ellipse with center at (posX, posY) and radius 5px
-		const D2D1_ELLIPSE ellipse = D2D1::Ellipse(D2D1::Point2F(Pos.x, Pos.y), Radius, Radius);
-		dc->FillEllipse(ellipse, pBrush);
-	}
+	return now - LandingTime >= SPLATTER_DURATION_SECONDS || SplatterBounceCount >= MAX_SPLATTER_BOUNCE_COUNT_;
+}
+
+float Splatter::GetAlpha(const double now) const
+{
+	const float age = static_cast<float>(now - LandingTime);
+	return (std::max)(0.0f, 1.0f - age / SPLATTER_DURATION_SECONDS) * 0.75f;
 }
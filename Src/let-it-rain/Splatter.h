@@ -1,13 +1,18 @@
 #pragma once
 
 #include "Vector2.h"
-#include "DisplayData.h"
+
+class SimulationData;
 
 // Splatter Class
+// Plain value type living in a display's SplatterPool. It carries no
+// back-pointer to its display: the scene data is passed in by the pool, so
+// the pool is one flat, pre-sized array with no pointer chasing.
 class Splatter
 {
 public:
-	Splatter(DisplayData* pDispData, Vector2 pos, Vector2 vel);
+	Splatter() = default; // empty pool slot
+	Splatter(Vector2 pos, Vector2 vel, float radius, double landingTime);
 	~Splatter();
 
 	// Default move/copy are fine (no owning heap resources)
@@ -16,8 +21,25 @@ public:
 	Splatter(Splatter&&) = default;
 	Splatter& operator=(Splatter&&) = default;
 
-	void UpdatePosition(float deltaSeconds);
-	void Draw(ID2D1DeviceContext* dc, ID2D1SolidColorBrush* pBrush) const;
+	void UpdatePosition(float deltaSeconds, const SimulationData* pSimData);
+
+	// True once the burst has faded out or the droplet has stopped bouncing;
+	// either way it will never draw again and its pool slot can be reused.
+	// `now` is the owning pool's clock.
+	bool IsExpired(double now) const;
+	// Burst opacity at `now`. Fades 0.75 → 0.0 over SPLATTER_DURATION_SECONDS.
+	float GetAlpha(double now) const;
+
+	Vector2 GetPos() const { return Pos; }
+	// Position before the last UpdatePosition (GetPos for a new splatter).
+	Vector2 GetPrevPos() const { return PrevPos; }
+	float GetRadius() const { return Radius; }
+
+	// Splatter burst lifetime in seconds (time-based, frame-rate independent).
+	// 0.5 s == the legacy 50-tick count at the fixed 0.01 s step, so the splatter
+	// fade is unchanged to an observer.
+	// ↑ splash lingers longer before fading out; ↓ vanishes quicker.
+	static constexpr float SPLATTER_DURATION_SECONDS = 0.5f;
 
 private:
 	// Bounces before a splatter stops drawing. ↑ keeps bouncing longer; ↓ settles sooner.
@@ -36,11 +58,11 @@ private:
 	// ↑ toward 1 = bouncier, taller rebounds; ↓ toward 0 = dead, no bounce.
 	static constexpr float BOUNCE_DAMPING = 0.9f;
 
-	DisplayData* pDisplayData; // not owned
-
 	Vector2 Pos;
+	Vector2 PrevPos;
 	Vector2 Vel;
-	float Radius;
+	float Radius = 0.0f;
 
 	int SplatterBounceCount = 0;
+	double LandingTime = 0.0; // pool clock when the parent drop landed; drives the fade/expiry
 };
@@ -0,0 +1,95 @@
+#include "SplatterPool.h"
+
+#include <algorithm>
+
+#include "SimulationData.h"
+#include "WorkerPool.h"
+
+size_t SplatterPool::SlotAt(const size_t offset) const
+{
+	const size_t slot = Head + offset;
+	return slot < Slots.size() ? slot : slot - Slots.size();
+}
+
+void SplatterPool::Reserve(const size_t capacity)
+{
+	if (capacity <= Slots.size()) return;
+
+	// Unroll the ring into the new storage so the live run starts at slot 0.
+	std::vector<Splatter> slots(capacity);
+	for (size_t i = 0; i < Count; ++i)
+	{
+		slots[i] = Slots[SlotAt(i)];
+	}
+	Slots.swap(slots);
+	Head = 0;
+}
+
+void SplatterPool::Clear()
+{
+	Head = 0;
+	Count = 0;
+	Clock = 0.0;
+}
+
+void SplatterPool::Emit(const Vector2 pos, const Vector2 vel, const float radius)
+{
+	if (Slots.empty()) return;
+
+	if (Count == Slots.size())
+	{
+		// Full: recycle the oldest landing. The new splatter becomes the newest
+		// entry, so landing order (and expiry order) is preserved.
+		Slots[Head] = Splatter(pos, vel, radius, Clock);
+		Head = SlotAt(1);
+		return;
+	}
+	Slots[SlotAt(Count)] = Splatter(pos, vel, radius, Clock);
+	++Count;
+}
+
+void SplatterPool::Update(const float deltaSeconds, const SimulationData* pSimData)
+{
+	if (Count == 0)
+	{
+		// Restart the clock whenever the pool drains so it never loses precision.
+		Clock = 0.0;
+		return;
+	}
+	Clock += deltaSeconds;
+
+	// Splatters move independently, so large pools go to the WorkerPool in chunks.
+	const auto updateRange = [&](const size_t begin, const size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			Splatter& splatter = Slots[SlotAt(i)];
+			if (!splatter.IsExpired(Clock))
+			{
+				splatter.UpdatePosition(deltaSeconds, pSimData);
+			}
+		}
+	};
+	const size_t chunks = (Count + PARALLEL_CHUNK_SPLATTERS - 1) / PARALLEL_CHUNK_SPLATTERS;
+	if (pSimData->ParallelUpdate && chunks > 1)
+	{
+		pSimData->GetWorkers().ParallelFor(chunks, [&](const size_t c)
+		{
+			const size_t begin = c * PARALLEL_CHUNK_SPLATTERS;
+			updateRange(begin, (std::min)(begin + PARALLEL_CHUNK_SPLATTERS, Count));
+		});
+	}
+	else
+	{
+		updateRange(0, Count);
+	}
+
+	// Landing times increase from the head, so the expired splatters (by age)
+	// are a prefix of the ring. Ones that stopped bouncing early just stay in
+	// place, undrawn, until the head reaches them.
+	while (Count > 0 && Slots[Head].IsExpired(Clock))
+	{
+		Head = SlotAt(1);
+		--Count;
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Splatter.h"
+
+// SplatterPool Class
+// Fixed-capacity ring of splatter slots, one per display. Splatters are
+// written at the ring's tail in landing order, so the head is always the
+// oldest landing: expiry retires slots from the head, and when the ring is
+// full a new landing recycles the oldest slot instead of growing. Storage is
+// only (re)allocated by Reserve, so steady-state rain never touches the heap.
+class SplatterPool
+{
+public:
+	// Size the ring to `capacity` slots, keeping live splatters (oldest first).
+	// Never shrinks. The only call that allocates.
+	void Reserve(size_t capacity);
+	void Clear();
+
+	// Launch one splatter at the current pool clock. Recycles the oldest slot if full.
+	void Emit(Vector2 pos, Vector2 vel, float radius);
+	// Advance the pool clock, integrate live splatters and retire expired ones.
+	void Update(float deltaSeconds, const SimulationData* pSimData);
+
+	// Live splatter at `offset` from the oldest (0 = oldest). Some may already be
+	// expired but not yet retired; check IsExpired(GetClock()) before drawing.
+	const Splatter& operator[](const size_t offset) const { return Slots[SlotAt(offset)]; }
+	double GetClock() const { return Clock; }
+
+	size_t Size() const { return Count; }
+	size_t Capacity() const { return Slots.size(); }
+
+private:
+	// Splatters per task of the parallel update (SimulationData::ParallelUpdate).
+	// ↑ less scheduling overhead; ↓ better balance.
+	static constexpr size_t PARALLEL_CHUNK_SPLATTERS = 2048;
+
+	std::vector<Splatter> Slots;
+	size_t Head = 0;   // slot of the oldest live splatter
+	size_t Count = 0;  // live slots, starting at Head (wrapping)
+	double Clock = 0.0; // simulated seconds; splatters are stamped with it on landing
+
+	size_t SlotAt(size_t offset) const;
+};
@@ -0,0 +1,140 @@
+#include "TaskPool.h"
+
+#include <algorithm>
+
+namespace
+{
+	// The pool and deque index of the worker running on this thread, if any.
+	thread_local const TaskPool* CurrentPool = nullptr;
+	thread_local size_t CurrentQueue = 0;
+}
+
+TaskPool& TaskPool::GetInstance()
+{
+	static TaskPool instance([]
+	{
+		const unsigned hardwareThreads = std::thread::hardware_concurrency();
+		return (std::min)(hardwareThreads > 1 ? hardwareThreads - 1 : 0u, DEFAULT_MAX_WORKERS);
+	}());
+	return instance;
+}
+
+TaskPool::TaskPool(const unsigned workerCount)
+{
+	const size_t queueCount = (std::max)(workerCount, 1u);
+	Queues.reserve(queueCount);
+	for (size_t i = 0; i < queueCount; ++i)
+	{
+		Queues.push_back(std::make_unique<Queue>());
+	}
+	Workers.reserve(workerCount);
+	for (unsigned i = 0; i < workerCount; ++i)
+	{
+		Workers.emplace_back(&TaskPool::WorkerMain, this, static_cast<size_t>(i));
+	}
+}
+
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(SleepMutex);
+		Stopping = true;
+	}
+	Wake.notify_all();
+	for (std::thread& worker : Workers)
+	{
+		worker.join();
+	}
+}
+
+void TaskPool::Submit(Group& group, std::function<void()> task)
+{
+	group.Pending.fetch_add(1, std::memory_order_relaxed);
+
+	const size_t target = CurrentPool == this
+		? CurrentQueue
+		: NextQueue.fetch_add(1, std::memory_order_relaxed) % Queues.size();
+	{
+		std::lock_guard<std::mutex> lock(Queues[target]->Mutex);
+		Queues[target]->Tasks.push_back({ std::move(task), &group });
+	}
+	Queued.fetch_add(1, std::memory_order_release);
+
+	// Taking the sleep mutex orders this wake after any sleeper's last check.
+	{
+		std::lock_guard<std::mutex> lock(SleepMutex);
+	}
+	Wake.notify_all();
+}
+
+void TaskPool::Wait(Group& group)
+{
+	const size_t home = CurrentPool == this ? CurrentQueue : Queues.size();
+	while (!group.Done())
+	{
+		if (RunOne(home)) continue;
+
+		std::unique_lock<std::mutex> lock(SleepMutex);
+		Wake.wait(lock, [&]
+		{
+			return group.Done() || Queued.load(std::memory_order_acquire) > 0;
+		});
+	}
+}
+
+void TaskPool::WorkerMain(const size_t index)
+{
+	CurrentPool = this;
+	CurrentQueue = index;
+	for (;;)
+	{
+		if (RunOne(index)) continue;
+
+		std::unique_lock<std::mutex> lock(SleepMutex);
+		Wake.wait(lock, [this] { return Stopping || Queued.load(std::memory_order_acquire) > 0; });
+		if (Stopping) return;
+	}
+}
+
+bool TaskPool::RunOne(const size_t home)
+{
+	if (Queued.load(std::memory_order_acquire) == 0) return false;
+
+	// Own deque from the back (the newest task, still warm in cache), then the
+	// others from the front (the oldest, which their owner would reach last).
+	Task task;
+	bool found = false;
+	const size_t count = Queues.size();
+	for (size_t k = 0; k < count && !found; ++k)
+	{
+		const size_t i = home < count ? (home + k) % count : k;
+		Queue& queue = *Queues[i];
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		if (queue.Tasks.empty()) continue;
+		if (i == home)
+		{
+			task = std::move(queue.Tasks.back());
+			queue.Tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(queue.Tasks.front());
+			queue.Tasks.pop_front();
+		}
+		found = true;
+	}
+	if (!found) return false;
+	Queued.fetch_sub(1, std::memory_order_relaxed);
+
+	task.Run();
+
+	if (task.Owner->Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		// Last task of its group: wake whoever waits for it.
+		{
+			std::lock_guard<std::mutex> lock(SleepMutex);
+		}
+		Wake.notify_all();
+	}
+	return true;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// TaskPool Class
+// Small work-stealing pool for coarse, independent tasks such as one display's
+// simulation step. Each worker owns a deque: it runs its own newest task first
+// and, once that is empty, steals the oldest task of another worker. A thread
+// waiting for a group runs queued tasks too, so with no workers everything
+// simply runs inline in Wait. (Data-parallel loops inside a task still go to
+// WorkerPool.)
+class TaskPool
+{
+public:
+	// Completion count of a set of submitted tasks. Must outlive its tasks.
+	class Group
+	{
+	public:
+		// True once every task submitted to the group so far has finished.
+		bool Done() const { return Pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class TaskPool;
+		std::atomic<size_t> Pending{ 0 };
+	};
+
+	// Process-wide pool; see DEFAULT_MAX_WORKERS.
+	static TaskPool& GetInstance();
+
+	explicit TaskPool(unsigned workerCount);
+	~TaskPool();
+
+	TaskPool(const TaskPool&) = delete;
+	TaskPool& operator=(const TaskPool&) = delete;
+
+	// Queue `task` as part of `group`. From a worker it goes on that worker's
+	// own deque; from any other thread the deques are filled round robin.
+	void Submit(Group& group, std::function<void()> task);
+	// Return once every task of `group` has finished, running queued tasks (of
+	// any group) on the calling thread in the meantime.
+	void Wait(Group& group);
+
+	size_t WorkerCount() const { return Workers.size(); }
+
+	// Worker cap of the shared instance: coarse tasks come one per display, so
+	// more threads than displays would only sit idle. ↑ more simultaneous
+	// tasks; ↓ fewer threads competing with WorkerPool and the render thread.
+	static constexpr unsigned DEFAULT_MAX_WORKERS = 4;
+
+private:
+	struct Task
+	{
+		std::function<void()> Run;
+		Group* Owner;
+	};
+	struct Queue
+	{
+		std::mutex Mutex;
+		std::deque<Task> Tasks;
+	};
+
+	void WorkerMain(size_t index);
+	// Run one queued task, preferring the back of deque `home` (if any) and then
+	// the front of the others. Returns false if every deque was empty.
+	bool RunOne(size_t home);
+
+	std::vector<std::unique_ptr<Queue>> Queues; // one per worker (at least one)
+	std::vector<std::thread> Workers;
+	std::atomic<size_t> NextQueue{ 0 }; // round-robin target of outside submits
+	std::atomic<size_t> Queued{ 0 };    // tasks in all deques
+
+	// Sleeping workers and waiters; woken by every submit and every finished group.
+	std::mutex SleepMutex;
+	std::condition_variable Wake;
+	bool Stopping = false;
+};
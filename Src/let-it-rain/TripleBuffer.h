@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// TripleBuffer Class
+// Lock-free handoff of whole values from one producer thread to one consumer
+// thread. Three slots rotate between the roles "back" (being written by the
+// producer), "front" (being read by the consumer) and "middle" (the latest
+// finished value, waiting). Publishing swaps back and middle; acquiring swaps
+// middle and front if the middle is newer. Neither side ever waits for the
+// other, the producer never overwrites what the consumer reads, and the
+// consumer always gets the newest finished value (older unread ones are
+// simply skipped). Slots are reused in place, so their buffers keep their
+// capacity.
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() = default;
+	TripleBuffer(const TripleBuffer&) = delete;
+	TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	// Producer: the slot to fill. Only valid until the next Publish.
+	T& Back() { return Slots[BackIndex]; }
+	// Producer: hand the back slot over as the newest value and take the
+	// middle slot (whatever it holds) as the next back slot.
+	void Publish()
+	{
+		BackIndex = Middle.exchange(static_cast<uint8_t>(BackIndex | FRESH), std::memory_order_acq_rel) & INDEX_MASK;
+	}
+
+	// Consumer: make the newest published value the front slot. Returns false
+	// (front unchanged) when nothing was published since the last Acquire.
+	bool Acquire()
+	{
+		if ((Middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+		FrontIndex = Middle.exchange(FrontIndex, std::memory_order_acq_rel) & INDEX_MASK;
+		return true;
+	}
+	// Consumer: the value acquired last. Only valid until the next Acquire.
+	const T& Front() const { return Slots[FrontIndex]; }
+
+	// Call fn(slot) on all three slots and forget any unread value. Only while
+	// neither side is running (e.g. to clear every slot after a reset).
+	template <typename Fn>
+	void ForEachSlot(Fn&& fn)
+	{
+		for (T& slot : Slots) fn(slot);
+		Middle.store(Middle.load(std::memory_order_relaxed) & INDEX_MASK, std::memory_order_relaxed);
+	}
+
+private:
+	// Middle holds a slot index plus this flag while its value is unread.
+	static constexpr uint8_t FRESH = 4;
+	static constexpr uint8_t INDEX_MASK = 3;
+
+	T Slots[3];
+	uint8_t BackIndex = 0;          // producer's own
+	uint8_t FrontIndex = 1;         // consumer's own
+	std::atomic<uint8_t> Middle{ 2 };
+};
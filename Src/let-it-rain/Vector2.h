@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cmath>
-#include <d2d1_1.h>
 
 class Vector2
 {
@@ -30,9 +29,4 @@ public:
 			y = (y / currentMag) * mag;
 		}
 	}
-
-	D2D1_POINT_2F ToD2DPoint() const
-	{
-		return D2D1::Point2F(x, y);
-	}
 };
@@ -0,0 +1,32 @@
+#include "VisibilityTracker.h"
+
+bool VisibilityTracker::Update(const bool covered, const double nowSeconds)
+{
+	const State before = Current;
+	if (!covered)
+	{
+		CoveredSince = -1.0;
+		Current = State::Visible;
+		return Current != before;
+	}
+
+	if (CoveredSince < 0.0) CoveredSince = nowSeconds;
+	const double coveredSeconds = nowSeconds - CoveredSince;
+	if (coveredSeconds >= PAUSE_AFTER_SECONDS)
+	{
+		Current = State::Paused;
+	}
+	else if (coveredSeconds >= OCCLUDE_DELAY_SECONDS && Current == State::Visible)
+	{
+		Current = State::Occluded;
+		LastKeepAlive = nowSeconds;
+	}
+	return Current != before;
+}
+
+bool VisibilityTracker::TakeKeepAliveTick(const double nowSeconds)
+{
+	if (Current != State::Occluded || nowSeconds - LastKeepAlive < KEEP_ALIVE_SECONDS) return false;
+	LastKeepAlive = nowSeconds;
+	return true;
+}
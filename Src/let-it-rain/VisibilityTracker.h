@@ -0,0 +1,42 @@
+#pragma once
+
+// VisibilityTracker Class
+// Whether a display is worth drawing, from repeated "is it covered" samples.
+// Covered for OCCLUDE_DELAY_SECONDS (so alt-tabbing past a fullscreen window
+// does not count), the display turns Occluded: nothing is drawn, and the
+// scene only takes a keep-alive step every KEEP_ALIVE_SECONDS so snow keeps
+// falling and settling, slowly. Covered for PAUSE_AFTER_SECONDS, it turns
+// Paused and costs nothing at all. Uncovered, it is Visible again at once.
+// Pure logic: the caller passes the time.
+class VisibilityTracker
+{
+public:
+	enum class State
+	{
+		Visible,
+		Occluded,
+		Paused
+	};
+
+	// Feed one sample. Returns true if the state changed.
+	bool Update(bool covered, double nowSeconds);
+	State GetState() const { return Current; }
+	// True when an Occluded display is due its next keep-alive step; counts
+	// the step as taken.
+	bool TakeKeepAliveTick(double nowSeconds);
+
+	// Seconds covered before drawing stops. ↑ ignores longer glimpses of a
+	// fullscreen window; ↓ saves sooner.
+	static constexpr double OCCLUDE_DELAY_SECONDS = 0.5;
+	// Seconds between keep-alive steps while Occluded. ↑ cheaper; ↓ the hidden
+	// scene keeps closer to its normal pace.
+	static constexpr double KEEP_ALIVE_SECONDS = 0.25;
+	// Seconds covered before pausing outright. ↑ the heap grows behind a game
+	// for longer; ↓ full savings sooner.
+	static constexpr double PAUSE_AFTER_SECONDS = 30.0;
+
+private:
+	State Current = State::Visible;
+	double CoveredSince = -1.0; // start of the current covered run; < 0: not covered
+	double LastKeepAlive = 0.0;
+};
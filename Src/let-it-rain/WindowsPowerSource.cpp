@@ -0,0 +1,38 @@
+#include "WindowsPowerSource.h"
+
+#include <algorithm>
+
+PowerSource::State WindowsPowerSource::Read()
+{
+	State state;
+
+	SYSTEM_POWER_STATUS power;
+	if (GetSystemPowerStatus(&power))
+	{
+		// 255 = unknown; treated as mains power.
+		state.OnBattery = power.ACLineStatus == 0;
+		state.BatterySaver = power.SystemStatusFlag == 1;
+	}
+
+	FILETIME idle, kernel, user, created, exited, processKernel, processUser;
+	if (GetSystemTimes(&idle, &kernel, &user) &&
+		GetProcessTimes(GetCurrentProcess(), &created, &exited, &processKernel, &processUser))
+	{
+		// System kernel time includes the idle time.
+		const ULONGLONG systemTotal = ToTicks(kernel) + ToTicks(user);
+		const ULONGLONG systemIdle = ToTicks(idle);
+		const ULONGLONG processBusy = ToTicks(processKernel) + ToTicks(processUser);
+		if (HasTimes && systemTotal > LastSystemTotal)
+		{
+			const double total = static_cast<double>(systemTotal - LastSystemTotal);
+			const double busy = total - static_cast<double>(systemIdle - LastSystemIdle);
+			const double ours = static_cast<double>(processBusy - LastProcessBusy);
+			state.OtherCpuLoad = static_cast<float>(std::clamp((busy - ours) / total, 0.0, 1.0));
+		}
+		LastSystemTotal = systemTotal;
+		LastSystemIdle = systemIdle;
+		LastProcessBusy = processBusy;
+		HasTimes = true;
+	}
+	return state;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <windows.h>
+
+#include "PowerSource.h"
+
+// WindowsPowerSource Class
+// PowerSource reading the system: battery and battery saver from
+// GetSystemPowerStatus, and the CPU load of every process but this one from
+// GetSystemTimes / GetProcessTimes (our own share is left out, so throttling
+// cannot end just because it worked).
+class WindowsPowerSource final : public PowerSource
+{
+public:
+	State Read() override;
+
+private:
+	// Totals at the previous Read (100 ns units, summed over all processors).
+	ULONGLONG LastSystemTotal = 0;
+	ULONGLONG LastSystemIdle = 0;
+	ULONGLONG LastProcessBusy = 0;
+	bool HasTimes = false;
+
+	static ULONGLONG ToTicks(const FILETIME& time)
+	{
+		return (static_cast<ULONGLONG>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+	}
+};
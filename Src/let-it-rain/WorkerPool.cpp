@@ -0,0 +1,96 @@
+#include "WorkerPool.h"
+
+WorkerPool& WorkerPool::GetInstance()
+{
+	static WorkerPool instance([]
+	{
+		const unsigned hardwareThreads = std::thread::hardware_concurrency();
+		return hardwareThreads > 1 ? hardwareThreads - 1 : 0u;
+	}());
+	return instance;
+}
+
+WorkerPool::WorkerPool(const unsigned workerCount)
+{
+	Workers.reserve(workerCount);
+	for (unsigned i = 0; i < workerCount; ++i)
+	{
+		Workers.emplace_back(&WorkerPool::WorkerMain, this);
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		Stopping = true;
+	}
+	WorkReady.notify_all();
+	for (std::thread& worker : Workers)
+	{
+		worker.join();
+	}
+}
+
+void WorkerPool::ParallelFor(const size_t count, const std::function<void(size_t)>& body)
+{
+	if (count == 0) return;
+
+	std::unique_lock<std::mutex> call(CallMutex, std::try_to_lock);
+	if (!call.owns_lock() || Workers.empty() || count == 1)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			body(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		Body = &body;
+		Count = count;
+		NextIndex.store(0, std::memory_order_relaxed);
+		ActiveWorkers = Workers.size();
+		++Generation;
+	}
+	WorkReady.notify_all();
+
+	RunIndices();
+
+	// Every worker checks in for every job, so none can still be reading Body
+	// (or miss the next job's generation) once this returns.
+	std::unique_lock<std::mutex> lock(Mutex);
+	WorkDone.wait(lock, [this] { return ActiveWorkers == 0; });
+	Body = nullptr;
+}
+
+void WorkerPool::WorkerMain()
+{
+	uint64_t seenGeneration = 0;
+	std::unique_lock<std::mutex> lock(Mutex);
+	for (;;)
+	{
+		WorkReady.wait(lock, [&] { return Stopping || Generation != seenGeneration; });
+		if (Stopping) return;
+		seenGeneration = Generation;
+
+		lock.unlock();
+		RunIndices();
+		lock.lock();
+
+		if (--ActiveWorkers == 0)
+		{
+			WorkDone.notify_one();
+		}
+	}
+}
+
+void WorkerPool::RunIndices()
+{
+	for (size_t i = NextIndex.fetch_add(1, std::memory_order_relaxed); i < Count;
+	     i = NextIndex.fetch_add(1, std::memory_order_relaxed))
+	{
+		(*Body)(i);
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// WorkerPool Class
+// Fixed set of worker threads for data-parallel simulation passes. ParallelFor
+// hands out loop indices from a shared counter and the calling thread works
+// too, so on a single core (no workers) the loop simply runs inline.
+class WorkerPool
+{
+public:
+	// Process-wide pool with one worker per extra hardware thread.
+	static WorkerPool& GetInstance();
+
+	explicit WorkerPool(unsigned workerCount);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	// Run body(i) for every i in [0, count) and return once all have finished.
+	// Indices run in no particular order, so bodies must be independent. A call
+	// made while the pool is already busy (nested, or from another thread) runs
+	// inline on the caller instead of waiting.
+	void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+	size_t WorkerCount() const { return Workers.size(); }
+
+private:
+	void WorkerMain();
+	void RunIndices();
+
+	std::vector<std::thread> Workers;
+
+	std::mutex CallMutex; // held for the duration of one ParallelFor
+	std::mutex Mutex;     // guards the job fields below
+	std::condition_variable WorkReady;
+	std::condition_variable WorkDone;
+
+	const std::function<void(size_t)>* Body = nullptr;
+	size_t Count = 0;
+	std::atomic<size_t> NextIndex{ 0 };
+	size_t ActiveWorkers = 0; // workers that have not yet finished the current job
+	uint64_t Generation = 0;  // bumped once per job; wakes the workers
+	bool Stopping = false;
+};
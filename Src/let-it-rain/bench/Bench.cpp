@@ -0,0 +1,63 @@
+#include "Bench.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Entry
+	{
+		const char* Name;
+		Bench::Case Run;
+	};
+
+	// Function-local so registration from other translation units' static
+	// initializers never sees it unconstructed.
+	std::vector<Entry>& Registry()
+	{
+		static std::vector<Entry> entries;
+		return entries;
+	}
+}
+
+volatile double Bench::Sink = 0.0;
+
+int Bench::Register(const char* name, const Case run)
+{
+	Registry().push_back({ name, run });
+	return static_cast<int>(Registry().size());
+}
+
+int Bench::RunMatching(const char* filter)
+{
+	int ran = 0;
+	for (const Entry& entry : Registry())
+	{
+		if (filter != nullptr && std::strstr(entry.Name, filter) == nullptr) continue;
+		std::printf("== %s\n", entry.Name);
+		entry.Run();
+		++ran;
+	}
+	return ran;
+}
+
+void Bench::Measure(const char* label, const double items, const std::function<void()>& body)
+{
+	using Clock = std::chrono::steady_clock;
+	for (int i = 0; i < WARMUP_RUNS; ++i) body();
+
+	long runs = 0;
+	const Clock::time_point start = Clock::now();
+	double elapsed = 0.0;
+	do
+	{
+		body();
+		++runs;
+		elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+	}
+	while (elapsed < MIN_SECONDS);
+
+	const double perRun = elapsed / static_cast<double>(runs);
+	std::printf("  %-40s %10.3f ms %10.2f M/s\n", label, perRun * 1e3, items / perRun * 1e-6);
+}
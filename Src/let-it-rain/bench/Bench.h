@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+
+// Bench Class
+// Minimal benchmark harness for the headless core: cases register themselves
+// with LIR_BENCH and are picked on the command line by name (substring match;
+// no argument runs them all). Each measurement repeats its body until it has
+// run for MIN_SECONDS and reports the mean time per run.
+class Bench
+{
+public:
+	using Case = void (*)();
+
+	static int Register(const char* name, Case run);
+	// Run every case whose name contains `filter` (all for null); returns how many ran.
+	static int RunMatching(const char* filter);
+
+	// Time `body` and print "<label>  <ms per run>  <rate>"; `items` is the
+	// work one run does (drops, flakes, pixels...), reported per second.
+	static void Measure(const char* label, double items, const std::function<void()>& body);
+
+	// Keep a result alive so the optimizer cannot drop the work producing it.
+	template <typename T>
+	static void Keep(const T& value)
+	{
+		Sink = Sink + static_cast<double>(value);
+	}
+
+private:
+	// ↑ steadier numbers, slower suite; ↓ quicker, noisier.
+	static constexpr double MIN_SECONDS = 0.25;
+	static constexpr int WARMUP_RUNS = 3;
+
+	static volatile double Sink;
+};
+
+// Define a benchmark case: LIR_BENCH(RainLayout) { ... }
+#define LIR_BENCH(name) \
+	static void name(); \
+	static const int name##Registered = Bench::Register(#name, name); \
+	static void name()
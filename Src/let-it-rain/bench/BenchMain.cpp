@@ -0,0 +1,16 @@
+#include <cstdio>
+
+#include "Bench.h"
+
+// let_it_rain_bench [filter]
+// Runs the cases whose name contains `filter`, or all of them.
+int main(const int argc, char** argv)
+{
+	const char* filter = argc > 1 ? argv[1] : nullptr;
+	if (Bench::RunMatching(filter) == 0)
+	{
+		std::fprintf(stderr, "no benchmark matches \"%s\"\n", filter);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,49 @@
+#include <vector>
+
+#include "Bench.h"
+#include "CpuFeatures.h"
+#include "FastNoiseLite.h"
+#include "NoiseKernel.h"
+#include "RandomGenerator.h"
+
+// Batched 3D noise at each instruction set this machine supports, against
+// the per-point FastNoiseLite::GetNoise loop it replaces, for both noise types.
+LIR_BENCH(NoiseKernel)
+{
+	constexpr size_t COUNT = 65536;
+	RandomGenerator rng(12);
+	std::vector<float> x(COUNT), y(COUNT), z(COUNT), out(COUNT);
+	rng.FillFloat(x.data(), COUNT, 0.0f, 1920.0f);
+	rng.FillFloat(y.data(), COUNT, 0.0f, 1080.0f);
+	rng.FillFloat(z.data(), COUNT, 0.0f, 100.0f);
+
+	for (const NoiseKernel::NoiseType type : { NoiseKernel::NoiseType::OpenSimplex2, NoiseKernel::NoiseType::OpenSimplex2S })
+	{
+		NoiseKernel::Params params;
+		params.Type = type;
+		const char* typeName = type == NoiseKernel::NoiseType::OpenSimplex2 ? "OpenSimplex2" : "OpenSimplex2S";
+
+		FastNoiseLite reference;
+		NoiseKernel::Configure(reference, params);
+		char label[64];
+		std::snprintf(label, sizeof(label), "%s, GetNoise loop", typeName);
+		Bench::Measure(label, static_cast<double>(COUNT), [&]
+		{
+			for (size_t i = 0; i < COUNT; ++i) out[i] = reference.GetNoise(x[i], y[i], z[i]);
+		});
+		Bench::Keep(out[0]);
+
+		const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Sse41, SimdLevel::Avx2,
+		                             SimdLevel::Neon };
+		for (const SimdLevel level : levels)
+		{
+			if (!CpuFeatures::IsSupported(level)) continue;
+			std::snprintf(label, sizeof(label), "%s, Evaluate %s", typeName, CpuFeatures::GetSimdLevelName(level));
+			Bench::Measure(label, static_cast<double>(COUNT), [&]
+			{
+				NoiseKernel::Evaluate(level, params, x.data(), y.data(), z.data(), COUNT, out.data());
+			});
+			Bench::Keep(out[0]);
+		}
+	}
+}
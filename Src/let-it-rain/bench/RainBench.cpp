@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Bench.h"
+#include "MathUtil.h"
+#include "RainField.h"
+#include "SimulationData.h"
+#include "Splatter.h"
+
+namespace
+{
+	constexpr float FRAME_SECONDS = 1.0f / 60.0f;
+	// Frames run before timing, so the field has reached its steady mix of
+	// falling, landed and respawned drops.
+	constexpr int SETTLE_FRAMES = 240;
+
+	// The drop layout RainField replaced: one object per drop with a back-pointer
+	// to its display and its own splatter vector, updated one drop at a time.
+	// Same integration and landing rules, so both layouts do the same work.
+	class LegacyRainDrop
+	{
+	public:
+		LegacyRainDrop(const int windDirectionFactor, SimulationData* pSimData) :
+			pSimData(pSimData), WindDirectionFactor(windDirectionFactor)
+		{
+			RandomGenerator& rng = pSimData->RainRng;
+			const int xWiden = pSimData->Width / 3;
+			Pos.x = static_cast<float>(rng.GenerateInt(pSimData->SceneRect.left - xWiden,
+			                                           pSimData->SceneRect.right + xWiden));
+			Pos.y = static_cast<float>((rng.GenerateInt(pSimData->SceneRect.top - pSimData->Height / 2,
+			                                            pSimData->SceneRect.top) / 10) * 10);
+			Radius = (rng.GenerateInt(2, 7) / 10.0f) * pSimData->ScaleFactor;
+			Vel.x = 75.0f * WindDirectionFactor * pSimData->ScaleFactor;
+			Vel.y = 1000.0f * pSimData->ScaleFactor;
+			const float velMag = std::sqrt(Vel.x * Vel.x + Vel.y * Vel.y);
+			TrailDir = Vector2(Vel.x / velMag, Vel.y / velMag);
+			TrailLength = rng.GenerateInt(30, 100) * pSimData->ScaleFactor;
+		}
+
+		bool DidTouchGround() const { return TouchedGround; }
+		bool IsReadyForErase() const { return IsDead; }
+
+		void UpdatePosition(const float deltaSeconds)
+		{
+			if (IsDead) return;
+			Pos.x += Vel.x * deltaSeconds;
+			Pos.y += Vel.y * deltaSeconds;
+			if (!TouchedGround)
+			{
+				if (Pos.y + Radius >= pSimData->SceneRect.bottom)
+				{
+					TouchedGround = true;
+					Pos.y = static_cast<float>(pSimData->SceneRect.bottom);
+					if (MathUtil::IsPointInRect(pSimData->SceneRect, Pos)) CreateSplatters();
+					else IsDead = true;
+				}
+			}
+			else
+			{
+				for (Splatter& splatter : Splatters) splatter.UpdatePosition(deltaSeconds, pSimData);
+				SplatterTime += deltaSeconds;
+				IsDead = SplatterTime >= Splatter::SPLATTER_DURATION_SECONDS;
+			}
+		}
+
+	private:
+		SimulationData* pSimData;
+		int WindDirectionFactor;
+		Vector2 Pos;
+		Vector2 Vel;
+		float Radius;
+		float TrailLength;
+		Vector2 TrailDir;
+		bool TouchedGround = false;
+		bool IsDead = false;
+		float SplatterTime = 0.0f;
+		std::vector<Splatter> Splatters;
+
+		void CreateSplatters()
+		{
+			RandomGenerator& rng = pSimData->SplatterRng;
+			Splatters.reserve(3);
+			for (int i = 0; i < 3; i++)
+			{
+				const float angle = rng.GenerateInt(20, 70, 110, 160) * (3.14f / 180.0f);
+				const Vector2 vel(200.0f * std::cos(angle) * pSimData->ScaleFactor,
+				                  -200.0f * std::sin(angle) * pSimData->ScaleFactor);
+				Splatters.emplace_back(Pos, vel, (rng.GenerateInt(15, 25) / 10.0f) * pSimData->ScaleFactor, 0.0);
+			}
+		}
+	};
+
+	void SetUpScene(SimulationData& simData)
+	{
+		simData.SetSceneBounds(RECT{ 0, 0, 1920, 1080 }, 1.0f);
+		simData.SeedRandomStreams(7, 0);
+	}
+
+	// One frame of DisplayWindow::UpdateRainDrops on the old per-drop objects.
+	void StepLegacy(std::vector<LegacyRainDrop>& drops, const int target, SimulationData& simData)
+	{
+		for (LegacyRainDrop& drop : drops) drop.UpdatePosition(FRAME_SECONDS);
+		int falling = 0;
+		for (size_t i = 0; i < drops.size();)
+		{
+			if (drops[i].IsReadyForErase())
+			{
+				if (i + 1 != drops.size()) drops[i] = std::move(drops.back());
+				drops.pop_back();
+			}
+			else
+			{
+				if (!drops[i].DidTouchGround()) falling++;
+				++i;
+			}
+		}
+		for (int i = falling; i < target; ++i) drops.emplace_back(1, &simData);
+	}
+
+	// The same frame on RainField.
+	void StepField(RainField& field, const int target, SimulationData& simData)
+	{
+		field.UpdatePositions(FRAME_SECONDS, &simData);
+		const int falling = field.RemoveDead();
+		field.Spawn(target - falling, 1, &simData);
+	}
+}
+
+// Per-drop objects (AoS) vs the RainField columns (SoA), one
+// steady-state frame of update + erase + respawn.
+LIR_BENCH(RainLayout)
+{
+	for (const int target : { 3000, 30000, 300000 })
+	{
+		char label[64];
+		{
+			SimulationData simData;
+			SetUpScene(simData);
+			std::vector<LegacyRainDrop> drops;
+			for (int f = 0; f < SETTLE_FRAMES; ++f) StepLegacy(drops, target, simData);
+			std::snprintf(label, sizeof(label), "legacy objects, %d drops", target);
+			Bench::Measure(label, target, [&] { StepLegacy(drops, target, simData); });
+		}
+		{
+			SimulationData simData;
+			SetUpScene(simData);
+			simData.Splatters.Reserve(RainField::SplatterCapacity(static_cast<size_t>(target)));
+			RainField field;
+			for (int f = 0; f < SETTLE_FRAMES; ++f) StepField(field, target, simData);
+			std::snprintf(label, sizeof(label), "RainField columns, %d drops", target);
+			Bench::Measure(label, target, [&] { StepField(field, target, simData); });
+			Bench::Keep(field.Size());
+		}
+	}
+}
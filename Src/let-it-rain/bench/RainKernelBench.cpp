@@ -0,0 +1,40 @@
+#include <cstdint>
+#include <vector>
+
+#include "Bench.h"
+#include "CpuFeatures.h"
+#include "RainKernel.h"
+#include "RandomGenerator.h"
+
+// The batched drop integration + ground test at each instruction set
+// this machine supports.
+LIR_BENCH(RainKernel)
+{
+	for (const size_t count : { 4096, 65536, 1048576 })
+	{
+		RandomGenerator rng(count);
+		std::vector<float> posX(count), posY(count), velX(count), velY(count), probe(count);
+		std::vector<uint64_t> mask((count + 63) / 64);
+		rng.FillFloat(posX.data(), count, -600.0f, 2500.0f);
+		rng.FillFloat(velX.data(), count, -150.0f, 150.0f);
+		rng.FillFloat(velY.data(), count, 900.0f, 1100.0f);
+		rng.FillFloat(probe.data(), count, -100.0f, 0.7f);
+
+		const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Sse41, SimdLevel::Avx2,
+		                             SimdLevel::Neon };
+		for (const SimdLevel level : levels)
+		{
+			if (!CpuFeatures::IsSupported(level)) continue;
+			// Restart from the same heights, so every level tests the same share of landings.
+			rng.FillFloat(posY.data(), count, -600.0f, 1080.0f);
+			char label[64];
+			std::snprintf(label, sizeof(label), "%s, %zu drops", CpuFeatures::GetSimdLevelName(level), count);
+			Bench::Measure(label, static_cast<double>(count), [&]
+			{
+				RainKernel::IntegrateDrops(level, posX.data(), posY.data(), velX.data(), velY.data(), probe.data(),
+				                           count, 1.0f / 60.0f, 1080.0f, mask.data());
+			});
+			Bench::Keep(mask[0]);
+		}
+	}
+}
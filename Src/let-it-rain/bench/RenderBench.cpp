@@ -0,0 +1,151 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Bench.h"
+#include "FrameGeometry.h"
+#include "RainRenderer.h"
+#include "RandomGenerator.h"
+#include "SimulationData.h"
+#include "SnowGrid.h"
+#include "SnowRaster.h"
+#include "SnowRenderer.h"
+#include "SoftwareRenderBackend.h"
+
+namespace
+{
+	constexpr int WIDTH = 1920;
+	constexpr int HEIGHT = 1080;
+	const RenderBackend::Color COLOR = { 0.67f, 0.67f, 0.67f, 1.0f };
+
+	// Trails slanting with the wind over the whole scene, one splatter per ten.
+	FrameGeometry RainFrame(const int trails)
+	{
+		RandomGenerator rng(5);
+		FrameGeometry frame;
+		for (int i = 0; i < trails; ++i)
+		{
+			const Vector2 end(rng.GenerateFloat(0.0f, WIDTH), rng.GenerateFloat(0.0f, HEIGHT));
+			const float length = rng.GenerateFloat(10.0f, 40.0f);
+			frame.Trails.push_back({ Vector2(end.x - 0.2f * length, end.y - length), end, rng.GenerateFloat(0.5f, 3.0f) });
+			if (i % 10 == 0)
+			{
+				frame.Splatters.push_back({ Vector2(end.x, HEIGHT - rng.GenerateFloat(0.0f, 20.0f)),
+				                            rng.GenerateFloat(1.0f, 4.0f), rng.GenerateFloat(0.2f, 1.0f) });
+			}
+		}
+		return frame;
+	}
+
+	SnowField::SpriteList FlakeSprites(const int flakes)
+	{
+		RandomGenerator rng(6);
+		SnowField::SpriteList sprites;
+		for (int s = 0; s <= SnowField::SHAPE_COUNT; ++s)
+		{
+			sprites.ShapeBegin[s] = static_cast<size_t>(flakes) * s / SnowField::SHAPE_COUNT;
+		}
+		for (int i = 0; i < flakes; ++i)
+		{
+			const float cx = rng.GenerateFloat(0.0f, WIDTH);
+			const float cy = rng.GenerateFloat(0.0f, HEIGHT);
+			const float half = rng.GenerateFloat(2.0f, 8.0f);
+			const float rotation = rng.GenerateFloat(0.0f, TWO_PI);
+			const float c = std::cos(rotation);
+			const float s = std::sin(rotation);
+			sprites.Dests.push_back({ cx - half, cy - half, cx + half, cy + half });
+			sprites.Transforms.push_back({ c, s, -s, c, cx - cx * c + cy * s, cy - cx * s - cy * c });
+		}
+		return sprites;
+	}
+}
+
+// RainRenderer::Draw through SoftwareRenderBackend at 1080p, trails
+// as streak sprites (smooth) and as aliased quads, 3k and 30k drops.
+LIR_BENCH(DrawRainDrops)
+{
+	SoftwareRenderBackend backend(WIDTH, HEIGHT);
+	for (const int trails : { 3000, 30000 })
+	{
+		const FrameGeometry frame = RainFrame(trails);
+		for (const bool smooth : { true, false })
+		{
+			char label[64];
+			std::snprintf(label, sizeof(label), "%d drops, %s", trails, smooth ? "smooth" : "aliased");
+			Bench::Measure(label, trails, [&]
+			{
+				backend.Clear();
+				RainRenderer::Draw(backend, frame, COLOR, smooth);
+			});
+		}
+	}
+	Bench::Keep(backend.Pixel(WIDTH / 2, HEIGHT / 2));
+}
+
+// SnowRenderer::DrawFallingFlakes through SoftwareRenderBackend at
+// 1080p, 1k and 10k flakes.
+LIR_BENCH(DrawFallingFlakes)
+{
+	SoftwareRenderBackend backend(WIDTH, HEIGHT);
+	for (const int flakes : { 1000, 10000 })
+	{
+		const SnowField::SpriteList sprites = FlakeSprites(flakes);
+		char label[64];
+		std::snprintf(label, sizeof(label), "%d flakes", flakes);
+		Bench::Measure(label, flakes, [&]
+		{
+			backend.Clear();
+			SnowRenderer::DrawFallingFlakes(backend, sprites, COLOR);
+		});
+	}
+	Bench::Keep(backend.Pixel(WIDTH / 2, HEIGHT / 2));
+}
+
+// The settled heap through SoftwareRenderBackend at 1080p: the
+// per-pixel image redrawn whole and after a frame's landings, and the simple
+// heap's silhouette.
+LIR_BENCH(DrawSettledSnow)
+{
+	SimulationData simData;
+	simData.SetSceneBounds(RECT{ 0, 0, WIDTH, HEIGHT }, 1.0f);
+	SoftwareRenderBackend backend(WIDTH, HEIGHT);
+	const double pixels = static_cast<double>(WIDTH) * HEIGHT;
+
+	SnowGrid grid;
+	grid.Resize(WIDTH, HEIGHT);
+	RandomGenerator rng(7);
+	const int surface = HEIGHT - HEIGHT / 5;
+	for (int x = 0; x < WIDTH; ++x)
+	{
+		for (int y = surface + rng.GenerateInt(-10, 10); y < HEIGHT; ++y) grid.Set(x, y);
+	}
+	for (int y = 0; y < HEIGHT; ++y) grid.MarkRowChanged(y);
+
+	SnowRaster raster;
+	Bench::Measure("per-pixel, whole image", pixels, [&]
+	{
+		raster.Invalidate();
+		SnowRenderer::DrawSettledSnow(backend, grid, raster, &simData, COLOR);
+	});
+	Bench::Measure("per-pixel, after 40 landings", pixels, [&]
+	{
+		for (int i = 0; i < 40; ++i)
+		{
+			const int y = surface - 12 - rng.GenerateInt(0, 20);
+			grid.Set(rng.GenerateInt(0, WIDTH - 1), y);
+			grid.MarkRowChanged(y);
+		}
+		SnowRenderer::DrawSettledSnow(backend, grid, raster, &simData, COLOR);
+	});
+
+	std::vector<float> heights(simData.ColumnHeights.size());
+	for (size_t i = 0; i < heights.size(); ++i)
+	{
+		heights[i] = 150.0f + 60.0f * std::sin(static_cast<float>(i) * 0.05f) + static_cast<float>(i % 7);
+	}
+	Bench::Measure("simple heap", pixels, [&]
+	{
+		SnowRenderer::DrawSettledSnowSimple(backend, heights, &simData, COLOR);
+	});
+	Bench::Keep(backend.Pixel(WIDTH / 2, HEIGHT - 1));
+}
@@ -0,0 +1,50 @@
+#include "Bench.h"
+#include "SimulationData.h"
+#include "SnowField.h"
+#include "SnowRenderer.h"
+
+namespace
+{
+	constexpr float FRAME_SECONDS = 1.0f / 60.0f;
+	constexpr int SETTLE_FRAMES = 120;
+}
+
+// One snow frame on the flake columns (drift field, noise refresh,
+// motion and landing on the simple heap) and the sprite list built from them,
+// at 1k, 10k and 100k flakes.
+LIR_BENCH(SnowFlakes)
+{
+	for (const int count : { 1000, 10000, 100000 })
+	{
+		SimulationData simData;
+		simData.SetSceneBounds(RECT{ 0, 0, 1920, 1080 }, 1.0f);
+		simData.ApplySnowHeapMode(true);
+		simData.SeedRandomStreams(2, 0);
+		SnowField flakes;
+		flakes.Spawn(count, &simData);
+
+		double clock = 0.0;
+		const auto step = [&]
+		{
+			clock += FRAME_SECONDS;
+			SnowField::AdvanceFlowField(&simData, SnowField::ComputeNoiseTime(clock));
+			flakes.RefreshNoise(FRAME_SECONDS, &simData);
+			flakes.UpdatePositions(FRAME_SECONDS, &simData);
+			SnowField::SmoothSnowHeap(&simData);
+		};
+		for (int frame = 0; frame < SETTLE_FRAMES; ++frame) step();
+
+		char label[64];
+		std::snprintf(label, sizeof(label), "update, %d flakes", count);
+		Bench::Measure(label, count, step);
+
+		SnowField::SpriteList sprites;
+		const float halfSize = SnowRenderer::FlakeHalfSizePerRadius(simData.ScaleFactor);
+		std::snprintf(label, sizeof(label), "sprite list, %d flakes", count);
+		Bench::Measure(label, count, [&]
+		{
+			flakes.BuildSprites(simData.SceneRect, 0.0f, 0.0f, halfSize, sprites);
+		});
+		Bench::Keep(flakes.Size());
+	}
+}
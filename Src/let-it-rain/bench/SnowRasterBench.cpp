@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <vector>
+
+#include "Bench.h"
+#include "RandomGenerator.h"
+#include "SnowGrid.h"
+#include "SnowRaster.h"
+
+// The settled-snow image, rasterized whole from the bit grid and
+// brought up to date after a few rows change, at 1080p and 4K (radius = DPI scale).
+LIR_BENCH(SnowRasterize)
+{
+	struct Resolution
+	{
+		const char* Name;
+		int Width, Height, Radius;
+	};
+	for (const Resolution& res : { Resolution{ "1080p", 1920, 1080, 1 }, Resolution{ "4K", 3840, 2160, 2 } })
+	{
+		// A pile over the bottom fifth with a ragged surface and loose cells above.
+		SnowGrid grid;
+		grid.Resize(res.Width, res.Height);
+		RandomGenerator rng(4);
+		for (int x = 0; x < res.Width; ++x)
+		{
+			const int top = res.Height - res.Height / 5 + rng.GenerateInt(-10, 10);
+			for (int y = top; y < res.Height; ++y) grid.Set(x, y);
+			if (rng.GenerateInt(0, 3) == 0) grid.Set(x, top - rng.GenerateInt(2, 30));
+		}
+		for (int y = 0; y < res.Height; ++y) grid.MarkRowChanged(y);
+
+		const uint32_t color = SnowRaster::PackBgra(1.0f, 1.0f, 1.0f, 1.0f);
+		const double pixels = static_cast<double>(res.Width) * res.Height;
+		std::vector<uint32_t> image(static_cast<size_t>(pixels));
+		char label[64];
+		std::snprintf(label, sizeof(label), "%s, full image", res.Name);
+		Bench::Measure(label, pixels, [&]
+		{
+			SnowRaster::RasterizeRows(grid, res.Radius, color, 0, res.Height, image.data(),
+			                          static_cast<size_t>(res.Width));
+		});
+		Bench::Keep(image.back());
+
+		// A frame of snowfall touches a few dozen rows near the surface.
+		SnowRaster raster;
+		raster.Update(grid, res.Radius, color);
+		const int surface = res.Height - res.Height / 5;
+		std::snprintf(label, sizeof(label), "%s, Update after 40 landings", res.Name);
+		Bench::Measure(label, pixels, [&]
+		{
+			for (int i = 0; i < 40; ++i)
+			{
+				const int y = surface - rng.GenerateInt(0, 60);
+				grid.Set(rng.GenerateInt(0, res.Width - 1), y);
+				grid.MarkRowChanged(y);
+			}
+			raster.Update(grid, res.Radius, color);
+		});
+		Bench::Keep(raster.DirtySpans().size());
+	}
+}
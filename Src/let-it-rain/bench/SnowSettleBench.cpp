@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Bench.h"
+#include "RandomGenerator.h"
+#include "SimulationData.h"
+#include "SnowField.h"
+
+namespace
+{
+	// Cells landing on the pile per frame, per 1080p of scene area (a heavy snowfall).
+	constexpr int LANDINGS_PER_FRAME = 400;
+	// Mean depth of the starting pile as a fraction of the scene height.
+	constexpr float PILE_DEPTH = 0.15f;
+
+	// A per-pixel heap holding a solid pile with a bumpy surface; returns the
+	// top row of each column's snow.
+	std::vector<int> SetUpPile(SimulationData& simData, const int width, const int height, const float scale)
+	{
+		simData.SetSceneBounds(RECT{ 0, 0, width, height }, scale);
+		simData.ApplySnowHeapMode(false);
+		simData.SeedRandomStreams(5, 0);
+
+		RandomGenerator rng(9);
+		std::vector<int> surface(static_cast<size_t>(width));
+		int top = height - static_cast<int>(height * PILE_DEPTH);
+		for (int x = 0; x < width; ++x)
+		{
+			top += rng.GenerateInt(-1, 1);
+			surface[x] = top;
+			for (int y = top; y < height; ++y) simData.ScenePixels.Set(x, y);
+		}
+		int highest = height;
+		for (int y = 0; y < height; ++y) simData.ScenePixels.MarkRowChanged(y);
+		for (const int y : surface) highest = (std::min)(highest, y);
+		simData.MaxSnowHeight = highest - 1;
+		return surface;
+	}
+}
+
+// The word-wide settle pass on a churning pile and on a pile at rest,
+// at 1080p, 4K and 8K.
+LIR_BENCH(SnowSettle)
+{
+	struct Resolution
+	{
+		const char* Name;
+		int Width, Height;
+		float Scale;
+	};
+	for (const Resolution& res : { Resolution{ "1080p", 1920, 1080, 1.0f }, Resolution{ "4K", 3840, 2160, 2.0f },
+	                               Resolution{ "8K", 7680, 4320, 4.0f } })
+	{
+		const double pixels = static_cast<double>(res.Width) * res.Height;
+		char label[64];
+
+		// Fresh snow keeps landing on the surface and sliding down its slopes.
+		SimulationData simData;
+		std::vector<int> surface = SetUpPile(simData, res.Width, res.Height, res.Scale);
+		RandomGenerator rng(13);
+		const int landings = static_cast<int>(LANDINGS_PER_FRAME * pixels / (1920.0 * 1080.0));
+		std::snprintf(label, sizeof(label), "%s, snowing", res.Name);
+		Bench::Measure(label, pixels, [&]
+		{
+			for (int i = 0; i < landings; ++i)
+			{
+				const int x = rng.GenerateInt(0, res.Width - 1);
+				int& top = surface[x];
+				if (top <= 1) continue;
+				--top;
+				simData.ScenePixels.Set(x, top);
+				simData.ScenePixels.MarkRowChanged(top);
+				simData.MaxSnowHeight = (std::min)(simData.MaxSnowHeight, top);
+			}
+			SnowField::SettleSnow(&simData);
+		});
+
+		// Then nothing lands: the pile comes to rest and the pass skips it.
+		for (int frame = 0; frame < 3000; ++frame) SnowField::SettleSnow(&simData);
+		std::snprintf(label, sizeof(label), "%s, at rest", res.Name);
+		Bench::Measure(label, pixels, [&] { SnowField::SettleSnow(&simData); });
+		Bench::Keep(simData.ScenePixels.Row(res.Height - 1)[0]);
+	}
+}
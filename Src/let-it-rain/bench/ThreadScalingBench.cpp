@@ -0,0 +1,67 @@
+#include "Bench.h"
+#include "RainField.h"
+#include "SimulationData.h"
+#include "SnowField.h"
+#include "WorkerPool.h"
+
+namespace
+{
+	constexpr float FRAME_SECONDS = 1.0f / 60.0f;
+	constexpr int WARMUP_FRAMES = 120;
+	constexpr int RAIN_DROPS = 300000;
+	constexpr int SNOW_FLAKES = 100000;
+}
+
+// The parallel rain and snow updates (SimulationData::ParallelUpdate)
+// on pools of 1 to 16 threads, caller included, at 300k drops and 100k flakes.
+// Threads past the machine's core count show the cost of oversubscription.
+LIR_BENCH(ThreadScaling)
+{
+	for (const unsigned threads : { 1u, 2u, 4u, 8u, 16u })
+	{
+		WorkerPool pool(threads - 1);
+		char label[64];
+		{
+			SimulationData simData;
+			simData.SetSceneBounds(RECT{ 0, 0, 3840, 2160 }, 2.0f);
+			simData.SeedRandomStreams(4, 0);
+			simData.Workers = &pool;
+			simData.Splatters.Reserve(RainField::SplatterCapacity(RAIN_DROPS));
+			RainField drops;
+			drops.Reserve(RAIN_DROPS);
+			const auto step = [&]
+			{
+				drops.UpdatePositions(FRAME_SECONDS, &simData);
+				const int toGenerate = RAIN_DROPS - drops.RemoveDead();
+				if (toGenerate > 0) drops.Spawn(toGenerate, 0, &simData);
+			};
+			for (int frame = 0; frame < WARMUP_FRAMES; ++frame) step();
+
+			std::snprintf(label, sizeof(label), "rain, %u thread(s)", threads);
+			Bench::Measure(label, RAIN_DROPS, step);
+			Bench::Keep(drops.Size());
+		}
+		{
+			SimulationData simData;
+			simData.SetSceneBounds(RECT{ 0, 0, 3840, 2160 }, 2.0f);
+			simData.ApplySnowHeapMode(true);
+			simData.SeedRandomStreams(4, 0);
+			simData.Workers = &pool;
+			SnowField flakes;
+			flakes.Spawn(SNOW_FLAKES, &simData);
+			double clock = 0.0;
+			const auto step = [&]
+			{
+				clock += FRAME_SECONDS;
+				SnowField::AdvanceFlowField(&simData, SnowField::ComputeNoiseTime(clock));
+				flakes.RefreshNoise(FRAME_SECONDS, &simData);
+				flakes.UpdatePositions(FRAME_SECONDS, &simData);
+			};
+			for (int frame = 0; frame < WARMUP_FRAMES; ++frame) step();
+
+			std::snprintf(label, sizeof(label), "snow, %u thread(s)", threads);
+			Bench::Measure(label, SNOW_FLAKES, step);
+			Bench::Keep(flakes.Size());
+		}
+	}
+}
@@ -0,0 +1,81 @@
+// Steady-state rain must not touch the heap: after a warm-up, RainField and
+// the display's SplatterPool run frame after frame with zero allocations.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "RainField.h"
+#include "SimulationData.h"
+#include "TestUtil.h"
+
+namespace
+{
+	std::atomic<long> Allocations{ 0 };
+
+	void* CountedAlloc(const size_t size)
+	{
+		++Allocations;
+		if (void* p = std::malloc(size != 0 ? size : 1)) return p;
+		throw std::bad_alloc();
+	}
+}
+
+// Every allocation of the process passes through here (aligned and nothrow
+// variants forward to these in the standard library).
+void* operator new(const size_t size) { return CountedAlloc(size); }
+void* operator new[](const size_t size) { return CountedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+namespace
+{
+	constexpr float FRAME_SECONDS = 1.0f / 60.0f;
+	constexpr int WARMUP_FRAMES = 600; // several full fall-and-splash cycles
+	constexpr int MEASURED_FRAMES = 3000;
+
+	// One frame of DisplayWindow::UpdateRainDrops.
+	void Step(RainField& drops, SimulationData& simData, const int maxDrops, const int wind)
+	{
+		drops.UpdatePositions(FRAME_SECONDS, &simData);
+		const int toGenerate = maxDrops - drops.RemoveDead();
+		if (toGenerate > 0)
+		{
+			drops.Reserve(drops.Size() + static_cast<size_t>(toGenerate));
+			drops.Spawn(toGenerate, wind, &simData);
+		}
+	}
+
+	void RunSteadyRain(const int maxDrops, const int wind, const bool parallel)
+	{
+		SimulationData simData;
+		simData.SetSceneBounds(RECT{ 0, 0, 1920, 1080 }, 1.0f);
+		simData.SeedRandomStreams(11, 0);
+		simData.ParallelUpdate = parallel;
+		simData.Splatters.Reserve(RainField::SplatterCapacity(static_cast<size_t>(maxDrops)));
+
+		RainField drops;
+		drops.Reserve(static_cast<size_t>(maxDrops));
+		for (int f = 0; f < WARMUP_FRAMES; ++f) Step(drops, simData, maxDrops, wind);
+
+		const long before = Allocations.load();
+		for (int f = 0; f < MEASURED_FRAMES; ++f) Step(drops, simData, maxDrops, wind);
+		const long allocated = Allocations.load() - before;
+
+		std::printf("%d drops, wind %d, %s: %ld allocation(s) in %d frames (%zu splatters live)\n", maxDrops, wind,
+		            parallel ? "parallel" : "serial", allocated, MEASURED_FRAMES, simData.Splatters.Size());
+		CHECK(allocated == 0);
+		CHECK(simData.Splatters.Size() > 0);
+	}
+}
+
+int main()
+{
+	RunSteadyRain(300, 0, false);
+	RunSteadyRain(3000, -3, false);
+	RunSteadyRain(30000, 5, true);
+	return Test::Result();
+}
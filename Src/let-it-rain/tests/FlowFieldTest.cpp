@@ -0,0 +1,226 @@
+// Falling flakes read their drift from FlowField, a coarse keyframed copy of
+// the snow noise, instead of evaluating the noise. Side by side with the exact
+// noise, the field's values and the flake paths it produces must stay close.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "NoiseKernel.h"
+#include "RandomGenerator.h"
+#include "SimulationData.h"
+#include "SnowField.h"
+#include "TestUtil.h"
+
+namespace
+{
+	constexpr float FRAME_SECONDS = 1.0f / 60.0f;
+
+	// SnowField's flake motion constants (private there): drift strength, fall
+	// and speed cap, per second at scale 1.
+	constexpr float NOISE_INTENSITY = 20.0f;
+	constexpr float GRAVITY = 10.0f;
+	constexpr float MAX_SPEED = 75.0f;
+
+	// Largest tolerated field error (noise range is -1 to 1), mean and worst.
+	constexpr float MAX_MEAN_SAMPLE_ERROR = 0.015f;
+	constexpr float MAX_SAMPLE_ERROR = 0.08f;
+	// Flake paths are chaotic: a half-pixel nudge to the start of an exact path
+	// already ends tens of px away after a few seconds. So the field's paths
+	// must stay close over a short horizon (px, mean and worst), and over a long
+	// one stay within a factor of that nudge's divergence and drift the flake
+	// population the same way (mean and spread of the sideways travel, px).
+	constexpr float SHORT_SECONDS = 1.0f;
+	constexpr float MAX_MEAN_SHORT_ERROR = 1.5f;
+	constexpr float MAX_SHORT_ERROR = 8.0f;
+	constexpr float LONG_SECONDS = 10.0f;
+	constexpr float NUDGE = 0.5f;
+	constexpr float MAX_LONG_ERROR_RATIO = 3.0f;
+	constexpr float MAX_DRIFT_DIFFERENCE = 10.0f;
+
+	float Exact(const SimulationData& simData, const float x, const float y, const float noiseTime)
+	{
+		float value = 0.0f;
+		NoiseKernel::Evaluate(simData.SnowNoise, &x, &y, &noiseTime, 1, &value);
+		return value;
+	}
+
+	void SetUpScene(SimulationData& simData)
+	{
+		simData.SetSceneBounds(RECT{ 0, 0, 1920, 1080 }, 1.0f);
+	}
+
+	// The field against the exact noise at random points, frame after frame,
+	// across several keyframes.
+	void TestSampleError()
+	{
+		SimulationData simData;
+		SetUpScene(simData);
+		RandomGenerator rng(3);
+
+		double sumError = 0.0;
+		float maxError = 0.0f;
+		long samples = 0;
+		for (int frame = 0; frame < 60 * 30; ++frame)
+		{
+			const float noiseTime = SnowField::ComputeNoiseTime(frame * FRAME_SECONDS);
+			SnowField::AdvanceFlowField(&simData, noiseTime);
+			for (int i = 0; i < 20; ++i)
+			{
+				const float x = rng.GenerateFloat(0.0f, 1920.0f);
+				const float y = rng.GenerateFloat(0.0f, 1080.0f);
+				const float error = std::fabs(simData.SnowFlow.Sample(x, y) - Exact(simData, x, y, noiseTime));
+				sumError += error;
+				maxError = (std::max)(maxError, error);
+				++samples;
+			}
+		}
+		const double meanError = sumError / static_cast<double>(samples);
+		std::printf("field vs noise: mean error %.5f, max %.5f over %ld samples\n", meanError, maxError, samples);
+		CHECK(meanError < MAX_MEAN_SAMPLE_ERROR);
+		CHECK(maxError < MAX_SAMPLE_ERROR);
+	}
+
+	// A jump back in time, or far ahead, rebuilds the field at the new time.
+	void TestJumps()
+	{
+		SimulationData simData;
+		SetUpScene(simData);
+		for (const double clock : { 100.0, 5.0, 500.0 })
+		{
+			const float noiseTime = SnowField::ComputeNoiseTime(clock);
+			SnowField::AdvanceFlowField(&simData, noiseTime);
+			float maxError = 0.0f;
+			for (float y = 3.0f; y < 1080.0f; y += 97.0f)
+			{
+				for (float x = 5.0f; x < 1920.0f; x += 101.0f)
+				{
+					maxError = (std::max)(maxError, std::fabs(simData.SnowFlow.Sample(x, y) -
+						Exact(simData, x, y, noiseTime)));
+				}
+			}
+			if (!CHECK(maxError < MAX_SAMPLE_ERROR)) std::fprintf(stderr, "  after jump to %gs\n", clock);
+		}
+	}
+
+	struct Flake
+	{
+		float X, Y, VelX, VelY;
+	};
+
+	// SnowField::MoveFlakes' drift, fall and speed cap for one flake and frame.
+	void Move(Flake& flake, const float noiseValue)
+	{
+		const float angle = noiseValue * TWO_PI + PI * 0.5f;
+		flake.VelX += std::cos(angle) * NOISE_INTENSITY * FRAME_SECONDS * 2.0f;
+		flake.VelY += std::sin(angle) * NOISE_INTENSITY * FRAME_SECONDS + GRAVITY * FRAME_SECONDS;
+		const float speed = std::sqrt(flake.VelX * flake.VelX + flake.VelY * flake.VelY);
+		if (speed > MAX_SPEED)
+		{
+			flake.VelX *= MAX_SPEED / speed;
+			flake.VelY *= MAX_SPEED / speed;
+		}
+		flake.X += flake.VelX * FRAME_SECONDS;
+		flake.Y += flake.VelY * FRAME_SECONDS;
+	}
+
+	struct PathError
+	{
+		double Mean = 0.0;
+		float Max = 0.0f;
+	};
+
+	PathError Compare(const std::vector<Flake>& actual, const std::vector<Flake>& expected)
+	{
+		PathError error;
+		for (size_t i = 0; i < expected.size(); ++i)
+		{
+			const float distance = std::hypot(actual[i].X - expected[i].X, actual[i].Y - expected[i].Y);
+			error.Mean += distance;
+			error.Max = (std::max)(error.Max, distance);
+		}
+		error.Mean /= static_cast<double>(expected.size());
+		return error;
+	}
+
+	// Mean and standard deviation of the flakes' sideways travel from `start`.
+	void Drift(const std::vector<Flake>& flakes, const std::vector<Flake>& start, double& mean, double& spread)
+	{
+		double sum = 0.0;
+		double sumSq = 0.0;
+		for (size_t i = 0; i < flakes.size(); ++i)
+		{
+			const double dx = flakes[i].X - start[i].X;
+			sum += dx;
+			sumSq += dx * dx;
+		}
+		mean = sum / static_cast<double>(flakes.size());
+		spread = std::sqrt((std::max)(sumSq / static_cast<double>(flakes.size()) - mean * mean, 0.0));
+	}
+
+	// The same flakes driven by the exact noise, by the field, and by the exact
+	// noise from nudged starts.
+	void TestTrajectories()
+	{
+		SimulationData simData;
+		SetUpScene(simData);
+		RandomGenerator rng(12);
+
+		std::vector<Flake> start(500);
+		for (Flake& flake : start)
+		{
+			flake = { rng.GenerateFloat(100.0f, 1820.0f), rng.GenerateFloat(0.0f, 300.0f), 0.0f, 0.0f };
+		}
+		std::vector<Flake> exact = start;
+		std::vector<Flake> field = start;
+		std::vector<Flake> nudged = start;
+		for (Flake& flake : nudged) flake.X += NUDGE;
+
+		const double startClock = 37.0; // mid-keyframe
+		const int shortFrames = static_cast<int>(SHORT_SECONDS / FRAME_SECONDS);
+		const int longFrames = static_cast<int>(LONG_SECONDS / FRAME_SECONDS);
+		for (int frame = 1; frame <= longFrames; ++frame)
+		{
+			const float noiseTime = SnowField::ComputeNoiseTime(startClock + frame * FRAME_SECONDS);
+			SnowField::AdvanceFlowField(&simData, noiseTime);
+			for (size_t i = 0; i < start.size(); ++i)
+			{
+				Move(exact[i], Exact(simData, exact[i].X, exact[i].Y, noiseTime));
+				Move(field[i], simData.SnowFlow.Sample(field[i].X, field[i].Y));
+				Move(nudged[i], Exact(simData, nudged[i].X, nudged[i].Y, noiseTime));
+			}
+
+			if (frame == shortFrames)
+			{
+				const PathError error = Compare(field, exact);
+				std::printf("field paths after %gs: mean error %.3f px, max %.3f px\n", SHORT_SECONDS, error.Mean,
+				            error.Max);
+				CHECK(error.Mean < MAX_MEAN_SHORT_ERROR);
+				CHECK(error.Max < MAX_SHORT_ERROR);
+			}
+		}
+
+		const PathError fieldError = Compare(field, exact);
+		const PathError nudgeError = Compare(nudged, exact);
+		std::printf("paths after %gs: field mean error %.2f px, %gpx nudge %.2f px\n", LONG_SECONDS, fieldError.Mean,
+		            NUDGE, nudgeError.Mean);
+		CHECK(fieldError.Mean < MAX_LONG_ERROR_RATIO * nudgeError.Mean);
+
+		double exactMean, exactSpread, fieldMean, fieldSpread;
+		Drift(exact, start, exactMean, exactSpread);
+		Drift(field, start, fieldMean, fieldSpread);
+		std::printf("sideways drift: exact %+.2f +- %.2f px, field %+.2f +- %.2f px\n", exactMean, exactSpread,
+		            fieldMean, fieldSpread);
+		CHECK(std::fabs(fieldMean - exactMean) < MAX_DRIFT_DIFFERENCE);
+		CHECK(std::fabs(fieldSpread - exactSpread) < MAX_DRIFT_DIFFERENCE);
+	}
+}
+
+int main()
+{
+	TestSampleError();
+	TestJumps();
+	TestTrajectories();
+	return Test::Result();
+}
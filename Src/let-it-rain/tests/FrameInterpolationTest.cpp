@@ -0,0 +1,272 @@
+// Fixed-tick interpolation of FrameSnapshot, as DisplayWindow::Simulate
+// captures it and Render draws it: InterpolationFactor maps the frame clock to
+// a clamped point between the last two ticks, and Interpolate at 0 and 1
+// reproduces the geometry before and after the last tick. Trails crossing the
+// scene edge are trimmed to it, never dropped.
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "FrameGeometry.h"
+#include "FrameSnapshot.h"
+#include "MathUtil.h"
+#include "RainField.h"
+#include "SimulationData.h"
+#include "SnowField.h"
+#include "TestUtil.h"
+
+namespace
+{
+	constexpr float TICK_SECONDS = 1.0f / 60.0f;
+	constexpr int WARMUP_TICKS = 90; // long enough for drops to reach the ground
+	constexpr int MAX_DROPS = 400;
+	constexpr int FLAKES = 400;
+	const RECT SCENE = { 0, 0, 320, 240 };
+	// Lerp(a, b, 1) is a + (b - a), which may miss b by an ulp (px).
+	constexpr float TOLERANCE = 1e-3f;
+
+	bool Near(const Vector2 a, const Vector2 b, const float tolerance)
+	{
+		return std::fabs(a.x - b.x) <= tolerance && std::fabs(a.y - b.y) <= tolerance;
+	}
+
+	// Distance of `point` from the line through `a` and `b`.
+	float DistanceFromLine(const Vector2 point, const Vector2 a, const Vector2 b)
+	{
+		const float dx = b.x - a.x;
+		const float dy = b.y - a.y;
+		const float length = std::hypot(dx, dy);
+		if (length == 0.0f) return std::hypot(point.x - a.x, point.y - a.y);
+		return std::fabs((point.x - a.x) * dy - (point.y - a.y) * dx) / length;
+	}
+
+	void TestInterpolationFactor()
+	{
+		FrameSnapshot frame;
+		// Not interpolated: always the last state.
+		CHECK(frame.InterpolationFactor(-5.0) == 1.0f);
+		CHECK(frame.InterpolationFactor(1e6) == 1.0f);
+
+		frame.EndTime = 10.0;
+		frame.TickSeconds = TICK_SECONDS;
+		CHECK(frame.InterpolationFactor(9.0) == 0.0f);
+		CHECK(frame.InterpolationFactor(10.0) == 0.0f);
+		CHECK(std::fabs(frame.InterpolationFactor(10.0 + TICK_SECONDS * 0.25) - 0.25f) < 1e-4f);
+		CHECK(std::fabs(frame.InterpolationFactor(10.0 + TICK_SECONDS * 0.5) - 0.5f) < 1e-4f);
+		CHECK(frame.InterpolationFactor(10.0 + TICK_SECONDS) == 1.0f);
+		CHECK(frame.InterpolationFactor(11.0) == 1.0f);
+	}
+
+	// The trail of drop `i` at `alpha` (0 before the last tick, 1 after), untrimmed.
+	FrameGeometry::Trail DropTrail(const RainField& drops, const size_t i, const float alpha)
+	{
+		const Vector2 to = drops.GetPosition(i);
+		const Vector2 tail = drops.GetTrailStart(i);
+		const Vector2 pos = alpha == 0.0f ? drops.GetPreviousPosition(i) : to;
+		return { Vector2(pos.x + tail.x - to.x, pos.y + tail.y - to.y), pos, drops.GetRadius(i) };
+	}
+
+	// Rain at alpha 0 and 1 against the drops and splatters themselves.
+	void CheckRain(const FrameSnapshot& frame, const RainField& drops, const SimulationData& simData,
+	               const float alpha, int& crossingTrails)
+	{
+		FrameGeometry geometry;
+		frame.Interpolate(alpha, geometry);
+
+		// Every drop with an end inside the scene, in drop order.
+		size_t k = 0;
+		size_t mismatches = 0;
+		for (size_t i = 0; i < drops.Size(); ++i)
+		{
+			const FrameGeometry::Trail expected = DropTrail(drops, i, alpha);
+			const bool startInside = MathUtil::IsPointInRect(SCENE, expected.Start);
+			const bool endInside = MathUtil::IsPointInRect(SCENE, expected.End);
+			if (!startInside && !endInside) continue;
+			if (k >= geometry.Trails.size())
+			{
+				++mismatches;
+				break;
+			}
+
+			const FrameGeometry::Trail& trail = geometry.Trails[k++];
+			if (trail.Width != expected.Width) ++mismatches;
+			if (startInside && endInside)
+			{
+				if (!Near(trail.Start, expected.Start, TOLERANCE) || !Near(trail.End, expected.End, TOLERANCE)) ++mismatches;
+				continue;
+			}
+
+			// Crossing the edge: trimmed to the scene along the same line, the
+			// inside end kept.
+			++crossingTrails;
+			const Vector2 inside = startInside ? expected.Start : expected.End;
+			const Vector2 keptEnd = startInside ? trail.Start : trail.End;
+			if (!Near(keptEnd, inside, TOLERANCE)) ++mismatches;
+			if (!MathUtil::IsPointInRect(SCENE, trail.Start) || !MathUtil::IsPointInRect(SCENE, trail.End)) ++mismatches;
+			if (DistanceFromLine(trail.Start, expected.Start, expected.End) > 0.01f ||
+			    DistanceFromLine(trail.End, expected.Start, expected.End) > 0.01f)
+			{
+				++mismatches;
+			}
+		}
+		if (!CHECK(mismatches == 0 && k == geometry.Trails.size()))
+		{
+			std::fprintf(stderr, "  trails at alpha %g: %zu mismatches, %zu of %zu matched\n", alpha, mismatches, k,
+			             geometry.Trails.size());
+		}
+
+		// Splatters inside the scene at that moment, in pool order.
+		const SplatterPool& splatters = simData.Splatters;
+		const double now = splatters.GetClock();
+		std::vector<FrameGeometry::Splat> expectedSplats;
+		for (size_t i = 0; i < splatters.Size(); ++i)
+		{
+			const Splatter& splatter = splatters[i];
+			if (splatter.IsExpired(now)) continue;
+			const Vector2 pos = alpha == 0.0f ? splatter.GetPrevPos() : splatter.GetPos();
+			if (!MathUtil::IsPointInRect(SCENE, pos)) continue;
+			expectedSplats.push_back({ pos, splatter.GetRadius(), splatter.GetAlpha(now) });
+		}
+		bool sameSplats = geometry.Splatters.size() == expectedSplats.size();
+		for (size_t i = 0; sameSplats && i < expectedSplats.size(); ++i)
+		{
+			sameSplats = Near(geometry.Splatters[i].Pos, expectedSplats[i].Pos, TOLERANCE) &&
+				geometry.Splatters[i].Radius == expectedSplats[i].Radius &&
+				geometry.Splatters[i].Alpha == expectedSplats[i].Alpha;
+		}
+		CHECK(sameSplats);
+		CHECK(!expectedSplats.empty());
+	}
+
+	void TestRain()
+	{
+		SimulationData simData;
+		simData.SetSceneBounds(SCENE, 1.0f);
+		simData.SeedRandomStreams(5, 0);
+		simData.Splatters.Reserve(RainField::SplatterCapacity(MAX_DROPS));
+		RainField drops;
+		drops.Reserve(MAX_DROPS);
+		for (int tick = 0; tick < WARMUP_TICKS; ++tick)
+		{
+			drops.UpdatePositions(TICK_SECONDS, &simData);
+			const int toGenerate = MAX_DROPS - drops.RemoveDead();
+			// Slanted by the wind, so trails also cross the side edges.
+			if (toGenerate > 0) drops.Spawn(toGenerate, 6, &simData);
+		}
+
+		FrameSnapshot frame;
+		frame.EndTime = WARMUP_TICKS * TICK_SECONDS;
+		frame.TickSeconds = TICK_SECONDS;
+		frame.CaptureRain(drops, &simData);
+
+		int crossingTrails = 0;
+		CheckRain(frame, drops, simData, 0.0f, crossingTrails);
+		CheckRain(frame, drops, simData, 1.0f, crossingTrails);
+		std::printf("rain: %zu drops, %d trails trimmed at the edge\n", drops.Size(), crossingTrails);
+		CHECK(crossingTrails > 0);
+
+		// Between the ticks every trail still lies inside the scene.
+		FrameGeometry geometry;
+		frame.Interpolate(0.5f, geometry);
+		CHECK(!geometry.Trails.empty());
+		bool inside = true;
+		for (const FrameGeometry::Trail& trail : geometry.Trails)
+		{
+			inside = inside && MathUtil::IsPointInRect(SCENE, trail.Start) && MathUtil::IsPointInRect(SCENE, trail.End);
+		}
+		CHECK(inside);
+
+		// Captured without a tick length: the last state at any alpha.
+		FrameSnapshot still;
+		still.CaptureRain(drops, &simData);
+		CHECK(still.InterpolationFactor(0.0) == 1.0f);
+		FrameGeometry last;
+		frame.Interpolate(1.0f, last);
+		still.Interpolate(0.0f, geometry);
+		bool same = geometry.Trails.size() == last.Trails.size();
+		for (size_t i = 0; same && i < last.Trails.size(); ++i)
+		{
+			same = Near(geometry.Trails[i].Start, last.Trails[i].Start, TOLERANCE) &&
+				Near(geometry.Trails[i].End, last.Trails[i].End, TOLERANCE);
+		}
+		CHECK(same);
+	}
+
+	bool SameSprites(const SnowField::SpriteList& actual, const SnowField::SpriteList& expected)
+	{
+		if (actual.Size() != expected.Size()) return false;
+		for (int s = 0; s <= SnowField::SHAPE_COUNT; ++s)
+		{
+			if (actual.ShapeBegin[s] != expected.ShapeBegin[s]) return false;
+		}
+		for (size_t k = 0; k < expected.Size(); ++k)
+		{
+			const SnowField::SpriteRect& a = actual.Dests[k];
+			const SnowField::SpriteRect& e = expected.Dests[k];
+			if (a.Left != e.Left || a.Top != e.Top || a.Right != e.Right || a.Bottom != e.Bottom) return false;
+			const SnowField::SpriteTransform& at = actual.Transforms[k];
+			const SnowField::SpriteTransform& et = expected.Transforms[k];
+			if (at.M11 != et.M11 || at.M12 != et.M12 || at.M21 != et.M21 || at.M22 != et.M22 || at.Dx != et.Dx ||
+			    at.Dy != et.Dy)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void TestSnow()
+	{
+		SimulationData simData;
+		simData.SetSceneBounds(SCENE, 1.0f);
+		simData.ApplySnowHeapMode(true);
+		simData.SeedRandomStreams(5, 0);
+		SnowField flakes;
+		flakes.Spawn(FLAKES, &simData);
+		double clock = 0.0;
+		for (int tick = 0; tick < WARMUP_TICKS; ++tick)
+		{
+			clock += TICK_SECONDS;
+			SnowField::AdvanceFlowField(&simData, SnowField::ComputeNoiseTime(clock));
+			flakes.RefreshNoise(TICK_SECONDS, &simData);
+			flakes.UpdatePositions(TICK_SECONDS, &simData);
+		}
+
+		constexpr float HALF_SIZE_PER_RADIUS = 2.0f;
+		FrameSnapshot frame;
+		frame.EndTime = clock;
+		frame.TickSeconds = TICK_SECONDS;
+		frame.CaptureSnow(flakes, &simData, HALF_SIZE_PER_RADIUS);
+
+		SnowField::SpriteList to, from;
+		flakes.BuildSprites(simData.SceneRectNorm, 0.0f, 0.0f, HALF_SIZE_PER_RADIUS, to, &from);
+		CHECK(to.Size() > 0);
+
+		FrameGeometry geometry;
+		frame.Interpolate(0.0f, geometry);
+		CHECK(SameSprites(geometry.Flakes, from));
+		frame.Interpolate(1.0f, geometry);
+		CHECK(SameSprites(geometry.Flakes, to));
+		CHECK(frame.ColumnHeights == simData.ColumnHeights);
+
+		// Half way, each sprite lies half way.
+		frame.Interpolate(0.5f, geometry);
+		bool halfWay = geometry.Flakes.Size() == to.Size();
+		for (size_t k = 0; halfWay && k < to.Size(); ++k)
+		{
+			const float middle = (from.Dests[k].Left + to.Dests[k].Left) * 0.5f;
+			halfWay = std::fabs(geometry.Flakes.Dests[k].Left - middle) <= TOLERANCE;
+		}
+		CHECK(halfWay);
+		std::printf("snow: %zu of %zu flakes drawn\n", to.Size(), flakes.Size());
+	}
+}
+
+int main()
+{
+	TestInterpolationFactor();
+	TestRain();
+	TestSnow();
+	return Test::Result();
+}
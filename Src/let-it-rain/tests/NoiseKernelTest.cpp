@@ -0,0 +1,98 @@
+// Every NoiseKernel instruction set this machine supports must match
+// FastNoiseLite::GetNoise within NoiseKernel::MAX_ERROR, for both noise types,
+// several seeds and frequencies, and batches whose tail is shorter than a vector.
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "CpuFeatures.h"
+#include "FastNoiseLite.h"
+#include "NoiseKernel.h"
+#include "RandomGenerator.h"
+#include "TestUtil.h"
+
+namespace
+{
+	using NoiseType = NoiseKernel::NoiseType;
+
+	const char* TypeName(const NoiseType type)
+	{
+		return type == NoiseType::OpenSimplex2 ? "OpenSimplex2" : "OpenSimplex2S";
+	}
+
+	// Returns the largest difference seen.
+	float CompareWithReference(const SimdLevel level, const NoiseKernel::Params& params, const size_t count)
+	{
+		RandomGenerator rng(count * 17 + static_cast<unsigned>(params.Seed));
+		std::vector<float> x(count), y(count), z(count), out(count);
+		// Scene-sized coordinates and a noise time, both signs, so every
+		// lattice rounding and step direction is taken.
+		rng.FillFloat(x.data(), count, -2000.0f, 4000.0f);
+		rng.FillFloat(y.data(), count, -1200.0f, 2400.0f);
+		rng.FillFloat(z.data(), count, -500.0f, 500.0f);
+		// A few round coordinates, including the origin.
+		for (size_t i = 0; i < count && i < 4; ++i)
+		{
+			x[i] = static_cast<float>(i) * 50.0f;
+			y[i] = -static_cast<float>(i) * 50.0f;
+			z[i] = 0.0f;
+		}
+
+		NoiseKernel::Evaluate(level, params, x.data(), y.data(), z.data(), count, out.data());
+
+		FastNoiseLite reference;
+		NoiseKernel::Configure(reference, params);
+		float maxError = 0.0f;
+		size_t mismatches = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float error = std::fabs(out[i] - reference.GetNoise(x[i], y[i], z[i]));
+			if (!(error <= NoiseKernel::MAX_ERROR)) ++mismatches;
+			if (error > maxError) maxError = error;
+		}
+		if (!CHECK(mismatches == 0))
+		{
+			std::fprintf(stderr, "  %s, %s, seed %d, frequency %g, %zu points: %zu mismatches (max error %g)\n",
+			             CpuFeatures::GetSimdLevelName(level), TypeName(params.Type), params.Seed, params.Frequency,
+			             count, mismatches, maxError);
+		}
+		return maxError;
+	}
+}
+
+int main()
+{
+	const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Sse41, SimdLevel::Avx2,
+	                             SimdLevel::Neon };
+	int tested = 0;
+	for (const SimdLevel level : levels)
+	{
+		if (!CpuFeatures::IsSupported(level)) continue;
+		++tested;
+		float maxError = 0.0f;
+		for (const NoiseType type : { NoiseType::OpenSimplex2, NoiseType::OpenSimplex2S })
+		{
+			for (const int seed : { 1337, 0, -7, 2024 })
+			{
+				for (const float frequency : { 0.01f, 0.0025f, 0.37f })
+				{
+					NoiseKernel::Params params;
+					params.Type = type;
+					params.Seed = seed;
+					params.Frequency = frequency;
+					// Empty, shorter than a vector, vectors with every tail length, and a large batch.
+					for (const size_t count : { 0, 1, 3, 4, 5, 7, 8, 9, 15, 17, 1000, 4099 })
+					{
+						const float error = CompareWithReference(level, params, count);
+						if (error > maxError) maxError = error;
+					}
+				}
+			}
+		}
+		std::printf("%s vs FastNoiseLite: max error %g\n", CpuFeatures::GetSimdLevelName(level), maxError);
+	}
+	std::printf("%d level(s) checked (best here: %s)\n", tested,
+	            CpuFeatures::GetSimdLevelName(CpuFeatures::GetSimdLevel()));
+	return Test::Result();
+}
@@ -0,0 +1,142 @@
+// PowerPolicy driven by a FixedPowerSource through a synthetic trace: AC to
+// battery, battery saver, back to AC, a short and a sustained CPU-load burst,
+// and recovery. Power-state changes apply at the next poll; load throttling
+// starts and ends only after HIGH_LOAD_SECONDS / LOW_LOAD_SECONDS beyond the
+// far edge of the band, so load inside the band never flips it.
+
+#include <cstdio>
+
+#include "PowerPolicy.h"
+#include "PowerSource.h"
+#include "TestUtil.h"
+
+namespace
+{
+	using Reason = PowerPolicy::Reason;
+
+	bool IsFull(const PowerPolicy::Limits& limits)
+	{
+		return limits.MaxFrameRate == PowerPolicy::FULL.MaxFrameRate &&
+			limits.ParticleScale == PowerPolicy::FULL.ParticleScale &&
+			limits.SettleInterval == PowerPolicy::FULL.SettleInterval;
+	}
+
+	bool IsThrottled(const PowerPolicy::Limits& limits)
+	{
+		return limits.MaxFrameRate == PowerPolicy::THROTTLED.MaxFrameRate &&
+			limits.ParticleScale == PowerPolicy::THROTTLED.ParticleScale &&
+			limits.SettleInterval == PowerPolicy::THROTTLED.SettleInterval;
+	}
+
+	PowerSource::State MakeState(const bool onBattery, const bool batterySaver, const float load)
+	{
+		PowerSource::State state;
+		state.OnBattery = onBattery;
+		state.BatterySaver = batterySaver;
+		state.OtherCpuLoad = load;
+		return state;
+	}
+
+	// One poll per second from `now` on, each with `load`, while the limits
+	// stay as they are; returns the time of the first poll that changes them,
+	// or -1 if none within `seconds`.
+	double PollLoad(PowerPolicy& policy, FixedPowerSource& source, double& now, const float load, const int seconds)
+	{
+		source.Set(MakeState(false, false, load));
+		for (int i = 0; i < seconds; ++i)
+		{
+			now += PowerPolicy::POLL_SECONDS;
+			if (policy.Update(now)) return now;
+		}
+		return -1.0;
+	}
+
+	void TestPowerStates()
+	{
+		FixedPowerSource source;
+		source.Set(MakeState(false, false, 0.2f));
+		PowerPolicy policy(source);
+
+		// The first call always polls; on AC with little load nothing is lowered.
+		CHECK(!policy.Update(0.0));
+		CHECK(policy.GetReason() == Reason::None);
+		CHECK(IsFull(policy.GetLimits()));
+
+		// Unplugged: seen at the next poll, not before.
+		source.Set(MakeState(true, false, 0.2f));
+		CHECK(!policy.Update(0.5));
+		CHECK(policy.GetReason() == Reason::None);
+		CHECK(policy.Update(1.0));
+		CHECK(policy.GetReason() == Reason::Battery);
+		CHECK(IsThrottled(policy.GetLimits()));
+		CHECK(!policy.Update(2.0));
+
+		// Battery saver outranks battery; the limits stay throttled.
+		source.Set(MakeState(true, true, 0.2f));
+		CHECK(policy.Update(3.0));
+		CHECK(policy.GetReason() == Reason::BatterySaver);
+		CHECK(IsThrottled(policy.GetLimits()));
+
+		// Plugged in again: full speed at the next poll.
+		source.Set(MakeState(false, false, 0.2f));
+		CHECK(policy.Update(4.0));
+		CHECK(policy.GetReason() == Reason::None);
+		CHECK(IsFull(policy.GetLimits()));
+	}
+
+	void TestLoad()
+	{
+		FixedPowerSource source;
+		source.Set(MakeState(false, false, 0.1f));
+		PowerPolicy policy(source);
+		double now = 0.0;
+		policy.Update(now);
+
+		// A burst shorter than HIGH_LOAD_SECONDS, then load inside the band for
+		// a minute: no change.
+		CHECK(PollLoad(policy, source, now, 0.95f, 2) < 0.0);
+		CHECK(PollLoad(policy, source, now, 0.7f, 60) < 0.0);
+		CHECK(policy.GetReason() == Reason::None);
+
+		// Sustained high load throttles HIGH_LOAD_SECONDS after its first poll.
+		const double start = now + PowerPolicy::POLL_SECONDS;
+		const double throttledAt = PollLoad(policy, source, now, 0.9f, 30);
+		CHECK(throttledAt - start == PowerPolicy::HIGH_LOAD_SECONDS);
+		CHECK(policy.GetReason() == Reason::SystemLoad);
+		CHECK(IsThrottled(policy.GetLimits()));
+
+		// Hysteresis: dropping into the band keeps the throttle, and so does
+		// low load that does not last LOW_LOAD_SECONDS.
+		CHECK(PollLoad(policy, source, now, 0.7f, 60) < 0.0);
+		CHECK(PollLoad(policy, source, now, 0.3f, 9) < 0.0);
+		CHECK(PollLoad(policy, source, now, 0.7f, 1) < 0.0);
+		CHECK(policy.GetReason() == Reason::SystemLoad);
+
+		// Battery outranks load while unplugged; back on AC the load throttle
+		// still holds.
+		source.Set(MakeState(true, false, 0.9f));
+		now += PowerPolicy::POLL_SECONDS;
+		CHECK(policy.Update(now));
+		CHECK(policy.GetReason() == Reason::Battery);
+		source.Set(MakeState(false, false, 0.9f));
+		now += PowerPolicy::POLL_SECONDS;
+		CHECK(policy.Update(now));
+		CHECK(policy.GetReason() == Reason::SystemLoad);
+
+		// Recovery: unknown load counts as low; LOW_LOAD_SECONDS of it restores
+		// full speed.
+		const double lowStart = now + PowerPolicy::POLL_SECONDS;
+		const double recoveredAt = PollLoad(policy, source, now, -1.0f, 30);
+		CHECK(recoveredAt - lowStart == PowerPolicy::LOW_LOAD_SECONDS);
+		CHECK(policy.GetReason() == Reason::None);
+		CHECK(IsFull(policy.GetLimits()));
+		std::printf("load throttled after %.0f s, restored after %.0f s\n", throttledAt - start, recoveredAt - lowStart);
+	}
+}
+
+int main()
+{
+	TestPowerStates();
+	TestLoad();
+	return Test::Result();
+}
@@ -0,0 +1,162 @@
+// QualityGovernor against synthetic timing traces at 60 Hz (12.5 ms budget):
+// steady overload sheds detail level by level, lone hitches and costs inside
+// the hysteresis band change nothing, ample headroom recovers detail, and a
+// load that only fits at the lower level makes each retried rise wait twice
+// as long. Reset returns to full detail and forgets that history.
+
+#include <cstdio>
+#include <vector>
+
+#include "QualityGovernor.h"
+#include "TestUtil.h"
+
+namespace
+{
+	constexpr float FRAME_SECONDS = 1.0f / 60.0f;
+	constexpr float BUDGET = FRAME_SECONDS * QualityGovernor::BUDGET_SHARE;
+	constexpr float OVER = BUDGET * 1.6f;
+	constexpr float UNDER = BUDGET * 0.4f;
+	// Between UPGRADE_SHARE and the budget: neither drops nor rises a level.
+	constexpr float IN_BAND = BUDGET * 0.8f;
+
+	// Feed `frames` samples of `cost` (split between simulation and drawing);
+	// returns the sample indices (0-based) at which the level changed.
+	std::vector<int> Feed(QualityGovernor& governor, const float cost, const int frames)
+	{
+		std::vector<int> changes;
+		for (int i = 0; i < frames; ++i)
+		{
+			if (governor.AddSample(cost * 0.25f, cost * 0.75f)) changes.push_back(i);
+		}
+		return changes;
+	}
+
+	void TestOverload()
+	{
+		QualityGovernor governor(FRAME_SECONDS);
+		CHECK(Feed(governor, UNDER, 1000).empty());
+		CHECK(governor.GetLevel() == 0);
+
+		// One level per DOWNGRADE_FRAMES over budget (once the smoothed cost
+		// gets there), each after the cooldown of the last, down to the
+		// cheapest level and no further.
+		const std::vector<int> drops = Feed(governor, OVER, 1000);
+		CHECK(drops.size() == QualityGovernor::LEVEL_COUNT - 1);
+		CHECK(drops.size() > 0 && drops[0] >= QualityGovernor::DOWNGRADE_FRAMES - 1 &&
+		      drops[0] < QualityGovernor::DOWNGRADE_FRAMES + 15);
+		for (size_t i = 1; i < drops.size(); ++i)
+		{
+			CHECK(drops[i] - drops[i - 1] == QualityGovernor::COOLDOWN_FRAMES + QualityGovernor::DOWNGRADE_FRAMES);
+		}
+		CHECK(governor.GetLevel() == QualityGovernor::LEVEL_COUNT - 1);
+		CHECK(governor.GetKnobs().ParticleScale < 1.0f);
+		CHECK(!governor.GetKnobs().SmoothTrails);
+
+		// Inside the hysteresis band the level holds, however long.
+		CHECK(Feed(governor, IN_BAND, 5000).empty());
+
+		// Ample headroom: back up one level at a time, each after UPGRADE_FRAMES
+		// under UPGRADE_SHARE.
+		const std::vector<int> rises = Feed(governor, UNDER, 3000);
+		CHECK(rises.size() == QualityGovernor::LEVEL_COUNT - 1);
+		for (size_t i = 1; i < rises.size(); ++i)
+		{
+			CHECK(rises[i] - rises[i - 1] == QualityGovernor::COOLDOWN_FRAMES + QualityGovernor::UPGRADE_FRAMES);
+		}
+		CHECK(rises.size() > 0 && rises[0] >= QualityGovernor::UPGRADE_FRAMES - 1);
+		CHECK(governor.GetLevel() == 0);
+		CHECK(governor.GetKnobs().ParticleScale == 1.0f);
+	}
+
+	void TestSpikes()
+	{
+		// A lone hitch is capped at SPIKE_CAP budgets and cannot tip the average.
+		QualityGovernor governor(FRAME_SECONDS);
+		int changes = 0;
+		for (int frame = 0; frame < 3000; ++frame)
+		{
+			const float cost = frame % 50 == 49 ? 1.0f : UNDER;
+			if (governor.AddSample(0.0f, cost)) ++changes;
+		}
+		CHECK(changes == 0);
+		CHECK(governor.GetLevel() == 0);
+
+		// Alternating over and under budget: the smoothed cost sits in the band.
+		for (int frame = 0; frame < 3000; ++frame)
+		{
+			const float cost = frame % 2 == 0 ? BUDGET * 1.15f : BUDGET * 0.55f;
+			if (governor.AddSample(cost, 0.0f)) ++changes;
+		}
+		CHECK(changes == 0);
+	}
+
+	// Frames spent at level 1 before each rise, with a load that fits only at
+	// level 1: level 0 costs OVER, level 1 costs UNDER.
+	std::vector<int> RetriedRises(QualityGovernor& governor, const int rises)
+	{
+		std::vector<int> waits;
+		int sinceDrop = 0;
+		while (static_cast<int>(waits.size()) < rises)
+		{
+			const float cost = governor.GetLevel() == 0 ? OVER : UNDER;
+			const int level = governor.GetLevel();
+			++sinceDrop;
+			if (governor.AddSample(cost, 0.0f) && governor.GetLevel() < level)
+			{
+				waits.push_back(sinceDrop);
+			}
+			if (governor.GetLevel() > level) sinceDrop = 0;
+		}
+		return waits;
+	}
+
+	void TestRetriedRises()
+	{
+		QualityGovernor governor(FRAME_SECONDS);
+		const std::vector<int> waits = RetriedRises(governor, 7);
+		int wait = QualityGovernor::UPGRADE_FRAMES;
+		for (size_t i = 0; i < waits.size(); ++i)
+		{
+			std::printf("rise %zu after %d frames (waiting %d)\n", i, waits[i], wait);
+			// The wait, plus the cooldown of the drop and the smoothed cost
+			// sinking under UPGRADE_SHARE.
+			CHECK(waits[i] >= wait);
+			CHECK(waits[i] <= wait + QualityGovernor::COOLDOWN_FRAMES + 30);
+			wait = wait * 2 < QualityGovernor::MAX_UPGRADE_FRAMES ? wait * 2 : QualityGovernor::MAX_UPGRADE_FRAMES;
+		}
+		CHECK(governor.GetLevel() == 0);
+
+		// Reset: full detail, and the next rise waits UPGRADE_FRAMES again.
+		Feed(governor, OVER, 200);
+		CHECK(governor.GetLevel() > 0);
+		governor.Reset();
+		CHECK(governor.GetLevel() == 0);
+		CHECK(governor.GetSmoothedSeconds() == 0.0f);
+		const std::vector<int> afterReset = RetriedRises(governor, 1);
+		CHECK(afterReset[0] >= QualityGovernor::UPGRADE_FRAMES);
+		CHECK(afterReset[0] <= QualityGovernor::UPGRADE_FRAMES + QualityGovernor::COOLDOWN_FRAMES + 30);
+	}
+
+	void TestFramePeriod()
+	{
+		// A cost over a 60 Hz budget fits at 30 Hz: the level is kept, then
+		// recovered.
+		QualityGovernor governor(FRAME_SECONDS);
+		Feed(governor, OVER, 20);
+		CHECK(governor.GetLevel() == 1);
+		governor.SetFramePeriod(FRAME_SECONDS * 2.0f);
+		CHECK(governor.GetLevel() == 1);
+		CHECK(governor.GetBudgetSeconds() == BUDGET * 2.0f);
+		CHECK(Feed(governor, BUDGET * 1.1f, 1000).size() == 1);
+		CHECK(governor.GetLevel() == 0);
+	}
+}
+
+int main()
+{
+	TestOverload();
+	TestSpikes();
+	TestRetriedRises();
+	TestFramePeriod();
+	return Test::Result();
+}
@@ -0,0 +1,114 @@
+// Every RainKernel instruction set this machine supports must integrate random
+// drops exactly like the scalar path: same positions, same ground masks.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "CpuFeatures.h"
+#include "RainKernel.h"
+#include "RandomGenerator.h"
+#include "TestUtil.h"
+
+namespace
+{
+	constexpr float GROUND_Y = 1080.0f;
+	constexpr int STEPS = 30;
+
+#if defined(LIR_ARCH_X86)
+	// x86 builds never contract the scalar path into FMAs, so every level matches bit for bit.
+	constexpr float TOLERANCE = 0.0f;
+#else
+	// Elsewhere the compiler may fuse the scalar multiply-add (see RainKernel.h).
+	constexpr float TOLERANCE = 1e-3f;
+#endif
+
+	struct Drops
+	{
+		std::vector<float> PosX, PosY, VelX, VelY, ProbeOffsetY;
+		std::vector<uint64_t> Mask;
+
+		Drops(const size_t count, RandomGenerator& rng) :
+			PosX(count), PosY(count), VelX(count), VelY(count), ProbeOffsetY(count), Mask((count + 63) / 64)
+		{
+			rng.FillFloat(PosX.data(), count, -1000.0f, 3000.0f);
+			rng.FillFloat(PosY.data(), count, -600.0f, 1200.0f);
+			rng.FillFloat(VelX.data(), count, -300.0f, 300.0f);
+			rng.FillFloat(VelY.data(), count, 500.0f, 2000.0f);
+			// Landing probes (+radius) and sunk-trail probes (-trail height).
+			rng.FillFloat(ProbeOffsetY.data(), count, -100.0f, 0.7f);
+		}
+
+		void Step(const SimdLevel level, const float deltaSeconds)
+		{
+			RainKernel::IntegrateDrops(level, PosX.data(), PosY.data(), VelX.data(), VelY.data(),
+			                           ProbeOffsetY.data(), PosX.size(), deltaSeconds, GROUND_Y, Mask.data());
+		}
+	};
+
+	bool Near(const float a, const float b)
+	{
+		return TOLERANCE == 0.0f ? a == b : std::fabs(a - b) <= TOLERANCE * (1.0f + std::fabs(b));
+	}
+
+	void CompareWithScalar(const SimdLevel level, const size_t count, const float deltaSeconds)
+	{
+		RandomGenerator rng(count * 31 + 5);
+		Drops expected(count, rng);
+		Drops actual = expected;
+
+		for (int step = 0; step < STEPS; ++step)
+		{
+			expected.Step(SimdLevel::Scalar, deltaSeconds);
+			actual.Step(level, deltaSeconds);
+
+			size_t mismatches = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (!Near(actual.PosX[i], expected.PosX[i]) || !Near(actual.PosY[i], expected.PosY[i])) ++mismatches;
+
+				const bool expectedBit = (expected.Mask[i / 64] >> (i % 64) & 1) != 0;
+				const bool actualBit = (actual.Mask[i / 64] >> (i % 64) & 1) != 0;
+				// With a tolerance, a probe that close to the ground may go either way.
+				const float probe = expected.PosY[i] + expected.ProbeOffsetY[i];
+				const bool onEdge = TOLERANCE != 0.0f && Near(probe, GROUND_Y);
+				if (expectedBit != actualBit && !onEdge) ++mismatches;
+			}
+			// Bits past `count` in the last word must stay clear.
+			if (count % 64 != 0) CHECK(actual.Mask.back() >> (count % 64) == 0);
+
+			if (!CHECK(mismatches == 0))
+			{
+				std::fprintf(stderr, "  %s: %zu drops, dt %g, step %d: %zu mismatches\n",
+				             CpuFeatures::GetSimdLevelName(level), count, deltaSeconds, step, mismatches);
+				return;
+			}
+		}
+	}
+}
+
+int main()
+{
+	const SimdLevel levels[] = { SimdLevel::Sse2, SimdLevel::Sse41, SimdLevel::Avx2, SimdLevel::Neon };
+	int tested = 0;
+	for (const SimdLevel level : levels)
+	{
+		if (!CpuFeatures::IsSupported(level)) continue;
+		std::printf("%s vs Scalar\n", CpuFeatures::GetSimdLevelName(level));
+		++tested;
+		// Partial words, exact words and multi-word fields.
+		for (const size_t count : { 0, 1, 3, 63, 64, 65, 127, 1000, 4099 })
+		{
+			for (const float deltaSeconds : { 1.0f / 144.0f, 1.0f / 60.0f, 0.1f })
+			{
+				CompareWithScalar(level, count, deltaSeconds);
+			}
+		}
+	}
+	// The scalar path still has to run on machines without any SIMD level.
+	CompareWithScalar(SimdLevel::Scalar, 1000, 1.0f / 60.0f);
+	std::printf("%d SIMD level(s) checked (best here: %s)\n", tested,
+	            CpuFeatures::GetSimdLevelName(CpuFeatures::GetSimdLevel()));
+	return Test::Result();
+}
@@ -0,0 +1,295 @@
+// The particle renderers drawn through SoftwareRenderBackend must match the
+// checked-in golden images (tests/golden/*.ppm): rain trails (streak sprites
+// and aliased quads) with splatters, falling flakes, the settled heap in both
+// modes, and translucent quads overlapping in one FillQuads. The scenes are fixed geometry from a pinned RandomGenerator, so
+// only drawing changes can move them. Small per-channel differences are
+// tolerated (float rounding across compilers).
+//
+// After an intended change to a draw path, rewrite the goldens with
+//     RenderGoldenTest --update
+// and review the new images before committing them. A failing scene is
+// written next to the test executable as <name>.actual.ppm.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "FrameGeometry.h"
+#include "RainRenderer.h"
+#include "RandomGenerator.h"
+#include "SimulationData.h"
+#include "SnowGrid.h"
+#include "SnowRaster.h"
+#include "SnowRenderer.h"
+#include "SoftwareRenderBackend.h"
+#include "TestUtil.h"
+
+namespace
+{
+	constexpr int WIDTH = 192;
+	constexpr int HEIGHT = 108;
+	constexpr uint32_t BACKGROUND = 0xFF101828; // opaque, premultiplied BGRA
+	const RenderBackend::Color COLOR = { 0.67f, 0.72f, 0.80f, 1.0f };
+
+	// A pixel differs when any channel is off by more than CHANNEL_TOLERANCE;
+	// a scene fails when more than MISMATCH_SHARE of its pixels differ.
+	constexpr int CHANNEL_TOLERANCE = 4;
+	constexpr double MISMATCH_SHARE = 0.002;
+
+	std::string GoldenPath(const char* name)
+	{
+		return std::string(LIR_GOLDEN_DIR) + "/" + name + ".ppm";
+	}
+
+	// Binary PPM (P6), RGB: the background is opaque, so alpha is always 255.
+	bool WritePpm(const std::string& path, const SoftwareRenderBackend& image)
+	{
+		FILE* file = std::fopen(path.c_str(), "wb");
+		if (file == nullptr) return false;
+		std::fprintf(file, "P6\n%d %d\n255\n", image.Width(), image.Height());
+		std::vector<unsigned char> rgb(static_cast<size_t>(image.Width()) * image.Height() * 3);
+		for (int i = 0; i < image.Width() * image.Height(); ++i)
+		{
+			const uint32_t pixel = image.Pixels()[i];
+			rgb[i * 3 + 0] = static_cast<unsigned char>(pixel >> 16);
+			rgb[i * 3 + 1] = static_cast<unsigned char>(pixel >> 8);
+			rgb[i * 3 + 2] = static_cast<unsigned char>(pixel);
+		}
+		const bool ok = std::fwrite(rgb.data(), 1, rgb.size(), file) == rgb.size();
+		return std::fclose(file) == 0 && ok;
+	}
+
+	bool ReadPpm(const std::string& path, int& width, int& height, std::vector<unsigned char>& rgb)
+	{
+		FILE* file = std::fopen(path.c_str(), "rb");
+		if (file == nullptr) return false;
+		int maxValue = 0;
+		bool ok = std::fscanf(file, "P6 %d %d %d", &width, &height, &maxValue) == 3 && maxValue == 255 &&
+			width > 0 && height > 0 && std::fgetc(file) != EOF;
+		if (ok)
+		{
+			rgb.resize(static_cast<size_t>(width) * height * 3);
+			ok = std::fread(rgb.data(), 1, rgb.size(), file) == rgb.size();
+		}
+		std::fclose(file);
+		return ok;
+	}
+
+	// Drop trails slanting with the wind, a few crossing each other, and
+	// splatters of every size and fade.
+	FrameGeometry RainScene()
+	{
+		RandomGenerator rng(23);
+		FrameGeometry frame;
+		for (int i = 0; i < 70; ++i)
+		{
+			const Vector2 end(rng.GenerateFloat(0.0f, WIDTH), rng.GenerateFloat(10.0f, HEIGHT));
+			const float length = rng.GenerateFloat(6.0f, 30.0f);
+			const float slant = rng.GenerateFloat(-0.4f, 0.4f);
+			const float width = rng.GenerateFloat(0.4f, 4.0f);
+			frame.Trails.push_back({ Vector2(end.x - slant * length, end.y - length), end, width });
+		}
+		for (int i = 0; i < 6; ++i)
+		{
+			// Crossing pairs, so overlapping trails are covered.
+			const Vector2 center(24.0f + 28.0f * i, 40.0f);
+			frame.Trails.push_back({ Vector2(center.x - 8.0f, center.y - 20.0f), Vector2(center.x + 8.0f, center.y + 20.0f), 3.0f });
+			frame.Trails.push_back({ Vector2(center.x + 8.0f, center.y - 20.0f), Vector2(center.x - 8.0f, center.y + 20.0f), 3.0f });
+		}
+		for (int i = 0; i < 30; ++i)
+		{
+			frame.Splatters.push_back({ Vector2(rng.GenerateFloat(0.0f, WIDTH), rng.GenerateFloat(HEIGHT - 20.0f, HEIGHT)),
+			                            rng.GenerateFloat(0.5f, 4.0f), rng.GenerateFloat(0.2f, 1.0f) });
+		}
+		return frame;
+	}
+
+	// Flakes of every shape, size and rotation, placed as SnowField::BuildSprites does.
+	SnowField::SpriteList FlakeScene()
+	{
+		RandomGenerator rng(29);
+		SnowField::SpriteList sprites;
+		constexpr int PER_SHAPE = 20;
+		for (int s = 0; s <= SnowField::SHAPE_COUNT; ++s)
+		{
+			sprites.ShapeBegin[s] = static_cast<size_t>(s) * PER_SHAPE;
+		}
+		for (int i = 0; i < SnowField::SHAPE_COUNT * PER_SHAPE; ++i)
+		{
+			const float cx = rng.GenerateFloat(0.0f, WIDTH);
+			const float cy = rng.GenerateFloat(0.0f, HEIGHT);
+			const float half = rng.GenerateFloat(1.5f, 7.0f);
+			const float rotation = rng.GenerateFloat(0.0f, TWO_PI);
+			const float c = std::cos(rotation);
+			const float s = std::sin(rotation);
+			sprites.Dests.push_back({ cx - half, cy - half, cx + half, cy + half });
+			sprites.Transforms.push_back({ c, s, -s, c, cx - cx * c + cy * s, cy - cx * s - cy * c });
+		}
+		return sprites;
+	}
+
+	// Settled snow: an uneven drift and a few loose cells above it.
+	void FillGrid(SnowGrid& grid)
+	{
+		grid.Resize(WIDTH, HEIGHT);
+		for (int x = 0; x < WIDTH; ++x)
+		{
+			const float t = static_cast<float>(x) / WIDTH;
+			const int depth = static_cast<int>(14.0f + 10.0f * std::sin(t * 9.0f) + 6.0f * std::sin(t * 23.0f + 1.0f));
+			for (int y = HEIGHT - depth; y < HEIGHT; ++y) grid.Set(x, y);
+		}
+		RandomGenerator rng(31);
+		for (int i = 0; i < 40; ++i) grid.Set(rng.GenerateInt(0, WIDTH - 1), rng.GenerateInt(40, HEIGHT - 30));
+		for (int y = 0; y < HEIGHT; ++y) grid.MarkRowChanged(y);
+	}
+
+	// A fan of translucent quads around a common center, each crossing all the
+	// others: one FillQuads shape, so the overlaps are no brighter.
+	std::vector<Vector2> QuadFan()
+	{
+		std::vector<Vector2> corners;
+		for (int i = 0; i < 6; ++i)
+		{
+			const float angle = static_cast<float>(i) * PI / 6.0f;
+			const Vector2 along(std::cos(angle) * 45.0f, std::sin(angle) * 45.0f);
+			const Vector2 across(-std::sin(angle) * 4.0f, std::cos(angle) * 4.0f);
+			const Vector2 center(WIDTH * 0.5f, HEIGHT * 0.5f);
+			corners.emplace_back(center.x - along.x - across.x, center.y - along.y - across.y);
+			corners.emplace_back(center.x + along.x - across.x, center.y + along.y - across.y);
+			corners.emplace_back(center.x + along.x + across.x, center.y + along.y + across.y);
+			corners.emplace_back(center.x - along.x + across.x, center.y - along.y + across.y);
+		}
+		return corners;
+	}
+
+	// Where two quads of one FillQuads overlap, the pixel equals one covered by
+	// a single quad, antialiased or not.
+	void TestQuadOverlap()
+	{
+		const Vector2 corners[] = {
+			{ 10.0f, 10.0f }, { 30.0f, 10.0f }, { 30.0f, 30.0f }, { 10.0f, 30.0f },
+			{ 20.0f, 20.0f }, { 40.0f, 20.0f }, { 40.0f, 40.0f }, { 20.0f, 40.0f },
+		};
+		for (const bool antialias : { true, false })
+		{
+			SoftwareRenderBackend backend(48, 48);
+			backend.Clear(BACKGROUND);
+			backend.SetAntialiasing(antialias);
+			backend.FillQuads(corners, 2, { 1.0f, 1.0f, 1.0f, 0.5f });
+			CHECK(backend.Pixel(25, 25) == backend.Pixel(15, 15));
+			CHECK(backend.Pixel(25, 25) == backend.Pixel(35, 35));
+			CHECK(backend.Pixel(15, 15) != BACKGROUND);
+			CHECK(backend.Pixel(35, 15) == BACKGROUND);
+		}
+	}
+
+	struct Scene
+	{
+		const char* Name;
+		std::function<void(SoftwareRenderBackend&)> Draw;
+	};
+
+	// True when the scene matches its golden (or was written, when updating).
+	bool CheckScene(const Scene& scene, const bool update)
+	{
+		SoftwareRenderBackend backend(WIDTH, HEIGHT);
+		backend.Clear(BACKGROUND);
+		scene.Draw(backend);
+
+		const std::string golden = GoldenPath(scene.Name);
+		if (update)
+		{
+			const bool written = WritePpm(golden, backend);
+			std::printf("%s: %s %s\n", scene.Name, written ? "wrote" : "could not write", golden.c_str());
+			return written;
+		}
+
+		int width = 0;
+		int height = 0;
+		std::vector<unsigned char> expected;
+		if (!ReadPpm(golden, width, height, expected))
+		{
+			std::fprintf(stderr, "%s: cannot read %s\n", scene.Name, golden.c_str());
+			return false;
+		}
+		if (width != WIDTH || height != HEIGHT)
+		{
+			std::fprintf(stderr, "%s: golden is %dx%d, expected %dx%d\n", scene.Name, width, height, WIDTH, HEIGHT);
+			return false;
+		}
+
+		int mismatches = 0;
+		int maxDifference = 0;
+		for (int i = 0; i < WIDTH * HEIGHT; ++i)
+		{
+			const uint32_t pixel = backend.Pixels()[i];
+			const int actual[3] = { static_cast<int>(pixel >> 16 & 0xFF), static_cast<int>(pixel >> 8 & 0xFF),
+			                        static_cast<int>(pixel & 0xFF) };
+			int difference = 0;
+			for (int c = 0; c < 3; ++c)
+			{
+				const int d = std::abs(actual[c] - expected[static_cast<size_t>(i) * 3 + c]);
+				difference = d > difference ? d : difference;
+			}
+			maxDifference = difference > maxDifference ? difference : maxDifference;
+			mismatches += difference > CHANNEL_TOLERANCE ? 1 : 0;
+		}
+		const bool ok = mismatches <= static_cast<int>(MISMATCH_SHARE * WIDTH * HEIGHT);
+		std::printf("%s: %d pixel(s) off, max channel difference %d\n", scene.Name, mismatches, maxDifference);
+		if (!ok)
+		{
+			const std::string actual = std::string(scene.Name) + ".actual.ppm";
+			WritePpm(actual, backend);
+			std::fprintf(stderr, "%s: does not match %s (written to %s)\n", scene.Name, golden.c_str(), actual.c_str());
+		}
+		return ok;
+	}
+}
+
+int main(const int argc, char** argv)
+{
+	const bool update = argc > 1 && std::strcmp(argv[1], "--update") == 0;
+
+	SimulationData simData;
+	simData.SetSceneBounds(RECT{ 0, 0, WIDTH, HEIGHT }, 1.0f);
+	const FrameGeometry rain = RainScene();
+	const SnowField::SpriteList flakes = FlakeScene();
+	const std::vector<Vector2> fan = QuadFan();
+
+	const Scene scenes[] = {
+		{ "rain", [&](SoftwareRenderBackend& backend) { RainRenderer::Draw(backend, rain, COLOR, true); } },
+		{ "rain_aliased", [&](SoftwareRenderBackend& backend) { RainRenderer::Draw(backend, rain, COLOR, false); } },
+		{ "snow_flakes", [&](SoftwareRenderBackend& backend) { SnowRenderer::DrawFallingFlakes(backend, flakes, COLOR); } },
+		{ "snow_settled", [&](SoftwareRenderBackend& backend)
+		{
+			SnowGrid grid;
+			FillGrid(grid);
+			SnowRaster raster;
+			SnowRenderer::DrawSettledSnow(backend, grid, raster, &simData, COLOR);
+		} },
+		{ "snow_simple", [&](SoftwareRenderBackend& backend)
+		{
+			std::vector<float> heights(simData.ColumnHeights.size());
+			for (size_t i = 0; i < heights.size(); ++i)
+			{
+				heights[i] = 12.0f + 9.0f * std::sin(static_cast<float>(i) * 0.45f) + static_cast<float>(i % 3);
+			}
+			SnowRenderer::DrawSettledSnowSimple(backend, heights, &simData, COLOR);
+		} },
+		{ "quads_overlap", [&](SoftwareRenderBackend& backend)
+		{
+			backend.FillQuads(fan.data(), fan.size() / 4, { COLOR.R, COLOR.G, COLOR.B, 0.5f });
+		} },
+	};
+	for (const Scene& scene : scenes)
+	{
+		CHECK(CheckScene(scene, update));
+	}
+	TestQuadOverlap();
+	return Test::Result();
+}
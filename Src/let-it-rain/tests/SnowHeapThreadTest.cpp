@@ -0,0 +1,87 @@
+// The simple heap must not depend on how the flake update is scheduled: the
+// same seeded scene run serially (ParallelUpdate off), on a WorkerPool with
+// no workers, one worker and several workers ends with the same ColumnHeights
+// and the same flakes, bit for bit.
+
+#include <cstdio>
+#include <vector>
+
+#include "SimulationData.h"
+#include "SnowField.h"
+#include "TestUtil.h"
+#include "WorkerPool.h"
+
+namespace
+{
+	constexpr float FRAME_SECONDS = 1.0f / 60.0f;
+	constexpr int FRAMES = 600;
+	// Many PARALLEL_CHUNK_FLAKES chunks, so the tasks really interleave.
+	constexpr int FLAKES = 20000;
+
+	struct Result
+	{
+		std::vector<float> ColumnHeights;
+		std::vector<float> PosX, PosY, Radius, Rotation;
+	};
+
+	// `pool` null: ParallelUpdate off, every chunk in order on this thread.
+	Result Run(WorkerPool* pool)
+	{
+		SimulationData simData;
+		simData.SetSceneBounds(RECT{ 0, 0, 1920, 1080 }, 1.0f);
+		simData.ApplySnowHeapMode(true);
+		simData.SeedRandomStreams(11, 0);
+		simData.ParallelUpdate = pool != nullptr;
+		simData.Workers = pool;
+		SnowField flakes;
+		flakes.Spawn(FLAKES, &simData);
+
+		double clock = 0.0;
+		for (int frame = 0; frame < FRAMES; ++frame)
+		{
+			clock += FRAME_SECONDS;
+			SnowField::AdvanceFlowField(&simData, SnowField::ComputeNoiseTime(clock));
+			flakes.RefreshNoise(FRAME_SECONDS, &simData);
+			flakes.UpdatePositions(FRAME_SECONDS, &simData);
+			SnowField::SmoothSnowHeap(&simData);
+		}
+
+		Result result;
+		result.ColumnHeights = simData.ColumnHeights;
+		for (size_t i = 0; i < flakes.Size(); ++i)
+		{
+			result.PosX.push_back(flakes.GetPos(i).x);
+			result.PosY.push_back(flakes.GetPos(i).y);
+			result.Radius.push_back(flakes.GetRadius(i));
+			result.Rotation.push_back(flakes.GetRotation(i));
+		}
+		return result;
+	}
+
+	void Compare(const Result& expected, const Result& actual, const char* name)
+	{
+		std::printf("%s\n", name);
+		const bool sameHeap = CHECK(actual.ColumnHeights == expected.ColumnHeights);
+		const bool sameFlakes = CHECK(actual.PosX == expected.PosX) & CHECK(actual.PosY == expected.PosY) &
+			CHECK(actual.Radius == expected.Radius) & CHECK(actual.Rotation == expected.Rotation);
+		if (!sameHeap || !sameFlakes) std::fprintf(stderr, "  %s differs from the serial run\n", name);
+	}
+}
+
+int main()
+{
+	const Result serial = Run(nullptr);
+	float settled = 0.0f;
+	for (const float height : serial.ColumnHeights) settled += height;
+	// Snow must actually have landed, or equal heaps prove nothing.
+	CHECK(settled > 0.0f);
+	std::printf("serial: %zu flakes, %.0f px of heap\n", serial.PosX.size(), settled);
+
+	WorkerPool inlinePool(0);
+	Compare(serial, Run(&inlinePool), "0 workers");
+	WorkerPool onePool(1);
+	Compare(serial, Run(&onePool), "1 worker");
+	WorkerPool manyPool(5);
+	Compare(serial, Run(&manyPool), "5 workers");
+	return Test::Result();
+}
@@ -0,0 +1,140 @@
+// Above 60 Hz, SnowField::RefreshNoise re-samples the drift for a round-robin
+// slice of the flakes per frame and carries the rest forward along their last
+// slope. Side by side with the same flakes refreshed every frame, at 60, 144
+// and 240 Hz, the flake positions must stay close (identical at 60 Hz, where
+// every flake is due every frame anyway).
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "SimulationData.h"
+#include "SnowField.h"
+#include "TestUtil.h"
+
+namespace
+{
+	constexpr int FLAKES = 4000;
+	// SnowField::MAX_SPEED (private there), px/s: a flake moving further than
+	// this in one frame was respawned.
+	constexpr float MAX_SPEED = 75.0f;
+	// A NoiseRefreshScale so large every flake is due every frame: the reference.
+	constexpr float EVERY_FRAME = 1e6f;
+
+	// Position error against the reference (px), mean and worst, after a
+	// second. Flake paths are chaotic (see FlowFieldTest): over a longer
+	// horizon a few flakes pass a swirl on the other side and end pixels away,
+	// so there the mean and the 99th percentile are bounded instead.
+	constexpr float SHORT_SECONDS = 1.0f;
+	constexpr float MAX_MEAN_SHORT_ERROR = 0.01f;
+	constexpr float MAX_SHORT_ERROR = 0.1f;
+	constexpr float LONG_SECONDS = 4.0f;
+	constexpr float MAX_MEAN_LONG_ERROR = 0.2f;
+	constexpr float MAX_P99_LONG_ERROR = 1.0f;
+
+	struct Scene
+	{
+		SimulationData SimData;
+		SnowField Flakes;
+
+		explicit Scene(const float noiseRefreshScale)
+		{
+			SimData.SetSceneBounds(RECT{ 0, 0, 1920, 1080 }, 1.0f);
+			SimData.ApplySnowHeapMode(true);
+			SimData.SeedRandomStreams(9, 0);
+			SimData.NoiseRefreshScale = noiseRefreshScale;
+			Flakes.Spawn(FLAKES, &SimData);
+		}
+
+		void Step(const double clock, const float deltaSeconds)
+		{
+			SnowField::AdvanceFlowField(&SimData, SnowField::ComputeNoiseTime(clock));
+			Flakes.RefreshNoise(deltaSeconds, &SimData);
+			Flakes.UpdatePositions(deltaSeconds, &SimData);
+		}
+	};
+
+	bool Jumped(const Vector2 before, const Vector2 after, const float deltaSeconds)
+	{
+		return std::hypot(after.x - before.x, after.y - before.y) > MAX_SPEED * deltaSeconds * 1.5f;
+	}
+
+	void TestRate(const int hertz)
+	{
+		const float deltaSeconds = 1.0f / static_cast<float>(hertz);
+		Scene staggered(1.0f);
+		Scene reference(EVERY_FRAME);
+
+		// Flakes that landed or left the scene in either run respawn with
+		// different draws; they are left out from then on.
+		std::vector<bool> compared(FLAKES, true);
+		std::vector<Vector2> before(FLAKES), referenceBefore(FLAKES);
+		double clock = 37.0; // mid-keyframe
+		const int shortFrames = static_cast<int>(SHORT_SECONDS * hertz);
+		const int longFrames = static_cast<int>(LONG_SECONDS * hertz);
+		for (int frame = 1; frame <= longFrames; ++frame)
+		{
+			for (size_t i = 0; i < FLAKES; ++i)
+			{
+				before[i] = staggered.Flakes.GetPos(i);
+				referenceBefore[i] = reference.Flakes.GetPos(i);
+			}
+			clock += deltaSeconds;
+			staggered.Step(clock, deltaSeconds);
+			reference.Step(clock, deltaSeconds);
+
+			std::vector<float> errors;
+			for (size_t i = 0; i < FLAKES; ++i)
+			{
+				const Vector2 pos = staggered.Flakes.GetPos(i);
+				const Vector2 expected = reference.Flakes.GetPos(i);
+				if (Jumped(before[i], pos, deltaSeconds) || Jumped(referenceBefore[i], expected, deltaSeconds))
+				{
+					compared[i] = false;
+				}
+				if (!compared[i]) continue;
+				errors.push_back(std::hypot(pos.x - expected.x, pos.y - expected.y));
+			}
+
+			if (frame == shortFrames || frame == longFrames)
+			{
+				const bool isShort = frame == shortFrames;
+				const size_t count = errors.size();
+				double sumError = 0.0;
+				for (const float error : errors) sumError += error;
+				const double meanError = sumError / static_cast<double>(count);
+				std::sort(errors.begin(), errors.end());
+				const float p99Error = errors[count * 99 / 100];
+				const float maxError = errors.back();
+				std::printf("%d Hz after %gs: mean error %.4f px, 99th percentile %.4f px, max %.4f px (%zu flakes)\n",
+				            hertz, isShort ? SHORT_SECONDS : LONG_SECONDS, meanError, p99Error, maxError, count);
+				// Most flakes must still be compared, or the bound says little.
+				CHECK(count > FLAKES / 2);
+				if (hertz <= 60)
+				{
+					CHECK(maxError == 0.0f);
+				}
+				else if (isShort)
+				{
+					CHECK(meanError < MAX_MEAN_SHORT_ERROR);
+					CHECK(maxError < MAX_SHORT_ERROR);
+				}
+				else
+				{
+					CHECK(meanError < MAX_MEAN_LONG_ERROR);
+					CHECK(p99Error < MAX_P99_LONG_ERROR);
+				}
+			}
+		}
+	}
+}
+
+int main()
+{
+	for (const int hertz : { 60, 144, 240 })
+	{
+		TestRate(hertz);
+	}
+	return Test::Result();
+}
@@ -0,0 +1,165 @@
+// SnowRaster must draw exactly the dilated cells of the grid: every pixel
+// within `radius` of a set cell (per SnowRaster::RasterizeRows), at any width
+// and radius, and Update's dirty spans must keep a copy of the image current.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "RandomGenerator.h"
+#include "SnowGrid.h"
+#include "SnowRaster.h"
+#include "TestUtil.h"
+
+namespace
+{
+	const uint32_t SNOW = SnowRaster::PackBgra(1.0f, 1.0f, 1.0f, 1.0f);
+
+	void Scatter(SnowGrid& grid, RandomGenerator& rng, const int cells)
+	{
+		for (int i = 0; i < cells; ++i)
+		{
+			const int x = rng.GenerateInt(0, grid.Width() - 1);
+			const int y = rng.GenerateInt(0, grid.Height() - 1);
+			grid.Set(x, y);
+			grid.MarkRowChanged(y);
+		}
+	}
+
+	// Cell (x, y) covers pixels [x - radius, x + radius) x [y - radius, y + radius).
+	std::vector<uint32_t> Reference(const SnowGrid& grid, const int radius)
+	{
+		const int width = grid.Width();
+		const int height = grid.Height();
+		std::vector<uint32_t> image(static_cast<size_t>(width) * height, 0);
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				if (!grid.Get(x, y)) continue;
+				for (int py = (std::max)(y - radius, 0); py < (std::min)(y + radius, height); ++py)
+				{
+					for (int px = (std::max)(x - radius, 0); px < (std::min)(x + radius, width); ++px)
+					{
+						image[static_cast<size_t>(py) * width + px] = SNOW;
+					}
+				}
+			}
+		}
+		return image;
+	}
+
+	int CountMismatches(const std::vector<uint32_t>& actual, const std::vector<uint32_t>& expected)
+	{
+		int mismatches = 0;
+		for (size_t i = 0; i < expected.size(); ++i) mismatches += actual[i] != expected[i];
+		return mismatches;
+	}
+
+	void TestRasterizeRows()
+	{
+		RandomGenerator rng(21);
+		// Widths inside one word, at a word edge, and with partial last words.
+		for (const int width : { 37, 64, 130, 200 })
+		{
+			for (const int radius : { 1, 2, 3, 7, SnowRaster::MAX_RADIUS })
+			{
+				SnowGrid grid;
+				grid.Resize(width, 90);
+				Scatter(grid, rng, width / 4);
+				// Solid runs too, so full words take their fast path.
+				for (int x = 0; x < width; ++x) grid.Set(x, 80);
+
+				const std::vector<uint32_t> expected = Reference(grid, radius);
+				std::vector<uint32_t> image(expected.size(), 0xDEADBEEFu);
+				SnowRaster::RasterizeRows(grid, radius, SNOW, 0, grid.Height(), image.data(),
+				                          static_cast<size_t>(width));
+				const int mismatches = CountMismatches(image, expected);
+				if (!CHECK(mismatches == 0))
+				{
+					std::fprintf(stderr, "  width %d, radius %d: %d pixels differ\n", width, radius, mismatches);
+				}
+			}
+		}
+
+		// Radius is clamped to [1, MAX_RADIUS].
+		SnowGrid grid;
+		grid.Resize(100, 100);
+		Scatter(grid, rng, 20);
+		std::vector<uint32_t> image(100 * 100);
+		SnowRaster::RasterizeRows(grid, 0, SNOW, 0, 100, image.data(), 100);
+		CHECK(CountMismatches(image, Reference(grid, 1)) == 0);
+		SnowRaster::RasterizeRows(grid, 1000, SNOW, 0, 100, image.data(), 100);
+		CHECK(CountMismatches(image, Reference(grid, SnowRaster::MAX_RADIUS)) == 0);
+	}
+
+	// Copy the last Update's spans into `image`, as a backend does.
+	void Apply(const SnowRaster& raster, std::vector<uint32_t>& image)
+	{
+		const size_t width = static_cast<size_t>(raster.Width());
+		for (const SnowRaster::Span& span : raster.DirtySpans())
+		{
+			std::memcpy(image.data() + span.Begin * width, raster.Pixels() + span.Offset,
+			            (span.End - span.Begin) * width * sizeof(uint32_t));
+		}
+	}
+
+	void TestUpdate()
+	{
+		RandomGenerator rng(8);
+		SnowGrid grid;
+		grid.Resize(150, 120);
+		Scatter(grid, rng, 60);
+
+		const int radius = 3;
+		SnowRaster raster;
+		std::vector<uint32_t> image(150 * 120, 0xDEADBEEFu);
+		CHECK(raster.Update(grid, radius, SNOW));
+		// The first update redraws everything, as one span.
+		CHECK(raster.DirtySpans().size() == 1 && raster.DirtySpans()[0].Begin == 0 &&
+			raster.DirtySpans()[0].End == 120);
+		Apply(raster, image);
+		CHECK(CountMismatches(image, Reference(grid, radius)) == 0);
+
+		// Nothing changed: nothing to upload.
+		CHECK(!raster.Update(grid, radius, SNOW));
+
+		for (int round = 0; round < 20; ++round)
+		{
+			Scatter(grid, rng, 3);
+			CHECK(raster.Update(grid, radius, SNOW));
+			size_t redrawn = 0;
+			for (const SnowRaster::Span& span : raster.DirtySpans()) redrawn += span.End - span.Begin;
+			CHECK(redrawn <= 3 * 2 * radius); // only the rows around the new cells
+			Apply(raster, image);
+			CHECK(CountMismatches(image, Reference(grid, radius)) == 0);
+		}
+
+		// Invalidate (lost copy) and a new color both redraw every row.
+		raster.Invalidate();
+		CHECK(raster.Update(grid, radius, SNOW));
+		CHECK(raster.DirtySpans().size() == 1 && raster.DirtySpans()[0].End - raster.DirtySpans()[0].Begin == 120);
+		const uint32_t red = SnowRaster::PackBgra(1.0f, 0.0f, 0.0f, 1.0f);
+		CHECK(raster.Update(grid, radius, red));
+		CHECK(raster.DirtySpans().size() == 1);
+	}
+
+	void TestPackBgra()
+	{
+		CHECK(SnowRaster::PackBgra(1.0f, 1.0f, 1.0f, 1.0f) == 0xFFFFFFFFu);
+		CHECK(SnowRaster::PackBgra(1.0f, 0.5f, 0.0f, 1.0f) == 0xFFFF8000u);
+		// Premultiplied, and clamped.
+		CHECK(SnowRaster::PackBgra(1.0f, 1.0f, 1.0f, 0.5f) == 0x80808080u);
+		CHECK(SnowRaster::PackBgra(2.0f, -1.0f, 0.0f, 1.0f) == 0xFFFF0000u);
+	}
+}
+
+int main()
+{
+	TestRasterizeRows();
+	TestUpdate();
+	TestPackBgra();
+	return Test::Result();
+}
@@ -0,0 +1,280 @@
+// The per-pixel settle pass runs in tiles of grid words, even tiles first,
+// then odd ones. It must behave like one serial pass over the whole row: no
+// cell moves twice in a frame (also across tile edges), no snow appears or
+// vanishes, and piles poured at tile edges grow like piles poured anywhere.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "RandomGenerator.h"
+#include "SimulationData.h"
+#include "SnowField.h"
+#include "TestUtil.h"
+
+namespace
+{
+	// Two words per tile (SnowField::SETTLE_TILE_WORDS): tile edges every 128 columns.
+	constexpr int TILE_COLUMNS = 128;
+
+	void SetUpGrid(SimulationData& simData, const int width, const int height)
+	{
+		simData.SetSceneBounds(RECT{ 0, 0, width, height }, 1.0f);
+		simData.ApplySnowHeapMode(false);
+		simData.SeedRandomStreams(3, 0);
+		simData.MaxSnowHeight = 0; // settle every row
+	}
+
+	void Fill(SimulationData& simData, const int x0, const int x1, const int y)
+	{
+		for (int x = x0; x <= x1; ++x) simData.ScenePixels.Set(x, y);
+		simData.ScenePixels.MarkRowChanged(y);
+	}
+
+	// One loose cell on a step beside a tile edge. Every other cell is wedged
+	// in, so the loose one is the only cell that moves: it can only slide over
+	// the edge onto the step below, in the neighbour tile, then slide once more.
+	// A neighbour running after this tile must not move it again in the same
+	// frame, so it takes one frame per step.
+	void TestNoDoubleMoveAcrossEdge(const int edge, const bool slideRight, const uint64_t seed)
+	{
+		SimulationData simData;
+		const int width = 4 * TILE_COLUMNS;
+		const int floorY = 7;
+		SetUpGrid(simData, width, floorY + 1);
+		simData.SeedRandomStreams(seed, 0);
+
+		const int dir = slideRight ? 1 : -1;
+		const int x = slideRight ? edge - 1 : edge;
+		Fill(simData, 0, width - 1, floorY); // the floor row is never settled
+		if (slideRight) Fill(simData, 0, x + 1, floorY - 1);
+		else Fill(simData, x - 1, width - 1, floorY - 1);
+		Fill(simData, x, x, floorY - 2);             // the step under the loose cell
+		Fill(simData, x - dir, x - dir, floorY - 2); // wedges it against the far side
+		Fill(simData, x, x, floorY - 3);             // the loose cell
+
+		const auto count = [&]
+		{
+			long cells = 0;
+			for (int y = 0; y <= floorY; ++y)
+			{
+				for (int cx = 0; cx < width; ++cx) cells += simData.ScenePixels.Get(cx, y);
+			}
+			return cells;
+		};
+		const long cells = count();
+
+		// Where the loose cell is after each step.
+		const int pathX[] = { x, x + dir, x + 2 * dir };
+		const int pathY[] = { floorY - 3, floorY - 2, floorY - 1 };
+		int step = 0;
+		for (int frame = 0; frame < 200 && step < 2; ++frame)
+		{
+			SnowField::SettleSnow(&simData);
+			const bool stayed = simData.ScenePixels.Get(pathX[step], pathY[step]);
+			const bool stepped = simData.ScenePixels.Get(pathX[step + 1], pathY[step + 1]);
+			if (!CHECK(stayed != stepped && count() == cells))
+			{
+				std::fprintf(stderr, "  edge %d %s, seed %llu, frame %d: left its path at step %d\n", edge,
+				             slideRight ? "right" : "left", static_cast<unsigned long long>(seed), frame, step);
+				return;
+			}
+			step += stepped;
+		}
+		CHECK(step == 2);
+	}
+
+	struct PileStats
+	{
+		long Cells = 0;
+		int Height = 0;     // tallest column
+		int Width = 0;      // columns with any snow
+		double Center = 0.0; // mass-weighted column, relative to the pour column
+	};
+
+	PileStats Measure(const std::vector<int>& columnHeights, const int pourX)
+	{
+		PileStats stats;
+		double moment = 0.0;
+		for (size_t x = 0; x < columnHeights.size(); ++x)
+		{
+			const int h = columnHeights[x];
+			stats.Cells += h;
+			stats.Height = (std::max)(stats.Height, h);
+			stats.Width += h > 0;
+			moment += static_cast<double>(h) * (static_cast<int>(x) - pourX);
+		}
+		stats.Center = stats.Cells > 0 ? moment / static_cast<double>(stats.Cells) : 0.0;
+		return stats;
+	}
+
+	// Serial reference: the same rules on one untiled row at a time, a cell per
+	// step. Bottom-up; each cell flows with the settle odds, straight down if it
+	// can, else diagonally, trying a random side first. Within a row the side
+	// moves go in the order of SnowField's passes (each on the row as it was
+	// before that pass).
+	class SerialSettle
+	{
+	public:
+		SerialSettle(const int width, const int height) :
+			Width(width), Height(height), Cells(static_cast<size_t>(width) * height), Rng(17)
+		{
+		}
+
+		bool Get(const int x, const int y) const
+		{
+			if (x < 0 || x >= Width) return true; // off-grid counts as occupied
+			return Cells[static_cast<size_t>(y) * Width + x] != 0;
+		}
+		void Set(const int x, const int y, const bool set) { Cells[static_cast<size_t>(y) * Width + x] = set; }
+
+		void Step()
+		{
+			std::vector<int> tryLeft;
+			std::vector<int> tryRight;
+			std::vector<int> moving;
+			for (int y = Height - 2; y >= 0; --y)
+			{
+				tryLeft.clear();
+				tryRight.clear();
+				for (int x = 0; x < Width; ++x)
+				{
+					if (!Get(x, y) || Rng.GenerateInt(0, 63) >= SETTLE_FLOW_ODDS) continue;
+					if (!Get(x, y + 1))
+					{
+						Set(x, y, false);
+						Set(x, y + 1, true);
+					}
+					else
+					{
+						(Rng.NextU32() & 1 ? tryLeft : tryRight).push_back(x);
+					}
+				}
+				// Pass order: left-first left, right-first right, then the second sides.
+				SidePass(tryLeft, y, -1, moving);
+				SidePass(tryRight, y, +1, moving);
+				SidePass(tryLeft, y, +1, moving);
+				SidePass(tryRight, y, -1, moving);
+			}
+		}
+
+		std::vector<int> ColumnHeights() const
+		{
+			std::vector<int> heights(static_cast<size_t>(Width), 0);
+			for (int x = 0; x < Width; ++x)
+			{
+				for (int y = 0; y < Height; ++y) heights[x] += Get(x, y);
+			}
+			return heights;
+		}
+
+	private:
+		static constexpr int SETTLE_FLOW_ODDS = 23; // SnowField's: (3 + 1) * 64 / 11, rounded
+
+		int Width;
+		int Height;
+		std::vector<uint8_t> Cells;
+		RandomGenerator Rng;
+
+		void SidePass(std::vector<int>& movers, const int y, const int dx, std::vector<int>& moving)
+		{
+			moving.clear();
+			for (const int x : movers)
+			{
+				if (Get(x, y) && !Get(x + dx, y) && !Get(x + dx, y + 1)) moving.push_back(x);
+			}
+			for (const int x : moving)
+			{
+				Set(x, y, false);
+				Set(x + dx, y + 1, true);
+			}
+			movers.erase(std::remove_if(movers.begin(), movers.end(), [&](const int x)
+			{
+				return std::find(moving.begin(), moving.end(), x) != moving.end();
+			}), movers.end());
+		}
+	};
+
+	// Drop a cell onto the pile at pourX every POUR_INTERVAL frames (when its
+	// spot is free), then let the pile come to rest. Returns the cells poured.
+	constexpr int POUR_INTERVAL = 3;
+
+	template <typename AddCell, typename Step>
+	long Pour(const int pourFrames, const int restFrames, AddCell&& addCell, Step&& step)
+	{
+		long poured = 0;
+		for (int frame = 0; frame < pourFrames + restFrames; ++frame)
+		{
+			if (frame < pourFrames && frame % POUR_INTERVAL == 0) poured += addCell();
+			step();
+		}
+		return poured;
+	}
+
+	void TestPileMatchesSerial(const int pourX)
+	{
+		constexpr int width = 4 * TILE_COLUMNS;
+		constexpr int height = 72;
+		constexpr int pourFrames = 2400;
+		constexpr int restFrames = 1200;
+
+		SimulationData simData;
+		SetUpGrid(simData, width, height);
+		const long tiledPoured = Pour(pourFrames, restFrames, [&]
+		{
+			if (simData.ScenePixels.Get(pourX, 0)) return false;
+			simData.ScenePixels.Set(pourX, 0);
+			simData.ScenePixels.MarkRowChanged(0);
+			return true;
+		}, [&] { SnowField::SettleSnow(&simData); });
+
+		std::vector<int> tiledHeights(static_cast<size_t>(width), 0);
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x) tiledHeights[x] += simData.ScenePixels.Get(x, y);
+		}
+
+		SerialSettle serial(width, height);
+		const long serialPoured = Pour(pourFrames, restFrames, [&]
+		{
+			if (serial.Get(pourX, 0)) return false;
+			serial.Set(pourX, 0, true);
+			return true;
+		}, [&] { serial.Step(); });
+
+		const PileStats tiled = Measure(tiledHeights, pourX);
+		const PileStats reference = Measure(serial.ColumnHeights(), pourX);
+		std::printf("pour at %d: tiled %ld cells, %d high, %d wide, center %+.2f; "
+		            "serial %ld cells, %d high, %d wide, center %+.2f\n",
+		            pourX, tiled.Cells, tiled.Height, tiled.Width, tiled.Center, reference.Cells, reference.Height,
+		            reference.Width, reference.Center);
+
+		// No snow is created or lost; the piles agree in shape and stay centered.
+		CHECK(tiled.Cells == tiledPoured);
+		CHECK(reference.Cells == serialPoured);
+		CHECK(std::abs(tiled.Cells - reference.Cells) <= reference.Cells / 20);
+		CHECK(std::abs(tiled.Height - reference.Height) <= reference.Height / 10 + 1);
+		CHECK(std::abs(tiled.Width - reference.Width) <= reference.Width / 10 + 1);
+		CHECK(std::fabs(tiled.Center) < 2.0);
+		CHECK(std::fabs(tiled.Center - reference.Center) < 2.0);
+	}
+}
+
+int main()
+{
+	for (uint64_t seed = 1; seed <= 64; ++seed)
+	{
+		for (const int edge : { TILE_COLUMNS, 2 * TILE_COLUMNS, 3 * TILE_COLUMNS })
+		{
+			TestNoDoubleMoveAcrossEdge(edge, true, seed);
+			TestNoDoubleMoveAcrossEdge(edge, false, seed);
+		}
+	}
+	// Interior, and on each kind of tile edge (even|odd and odd|even).
+	TestPileMatchesSerial(TILE_COLUMNS / 2 + 3);
+	TestPileMatchesSerial(TILE_COLUMNS);
+	TestPileMatchesSerial(2 * TILE_COLUMNS);
+	return Test::Result();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdio>
+
+// Test Class
+// Checks for the ctest executables: a failed CHECK prints where and what, and
+// the test keeps going so one run reports every failure; main returns
+// Test::Result() (nonzero when anything failed).
+class Test
+{
+public:
+	static bool Check(const bool ok, const char* expression, const char* file, const int line)
+	{
+		if (!ok)
+		{
+			std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+			++Failures;
+		}
+		return ok;
+	}
+
+	static int Result()
+	{
+		if (Failures > 0) std::fprintf(stderr, "%d check(s) failed\n", Failures);
+		return Failures > 0 ? 1 : 0;
+	}
+
+private:
+	static inline int Failures = 0;
+};
+
+#define CHECK(condition) Test::Check((condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,123 @@
+// The FrameSnapshot handoff of DisplayWindow under stress: a producer thread
+// steps rain and publishes snapshots as fast as it can while the consumer
+// acquires and interpolates them. Every snapshot the consumer sees must be
+// one whole step (never a mix of two), newer than the last, and the newest
+// one must arrive once the producer stops. Between runs the slots are cleared
+// as DiscardFrames does.
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+#include "FrameGeometry.h"
+#include "FrameSnapshot.h"
+#include "RainField.h"
+#include "SimulationData.h"
+#include "TestUtil.h"
+#include "TripleBuffer.h"
+
+namespace
+{
+	constexpr float TICK_SECONDS = 1.0f / 60.0f;
+	constexpr int STEPS_PER_RUN = 20000;
+	constexpr int RUNS = 3;
+	// Length of the stamp written into each snapshot; long enough that a torn
+	// copy would show.
+	constexpr size_t STAMP_SIZE = 512;
+
+	// One step of the simulation thread: a rain tick, captured, then stamped
+	// with its number everywhere the consumer can check it.
+	void Produce(TripleBuffer<FrameSnapshot>& frames, const int maxDrops, const int firstStep)
+	{
+		SimulationData simData;
+		simData.SetSceneBounds(RECT{ 0, 0, 640, 480 }, 1.0f);
+		simData.SeedRandomStreams(3, 0);
+		simData.Splatters.Reserve(RainField::SplatterCapacity(static_cast<size_t>(maxDrops)));
+		RainField drops;
+		drops.Reserve(static_cast<size_t>(maxDrops));
+
+		for (int step = firstStep; step < firstStep + STEPS_PER_RUN; ++step)
+		{
+			drops.UpdatePositions(TICK_SECONDS, &simData);
+			const int toGenerate = maxDrops - drops.RemoveDead();
+			if (toGenerate > 0) drops.Spawn(toGenerate, 2, &simData);
+
+			FrameSnapshot& frame = frames.Back();
+			frame.EndTime = step;
+			frame.TickSeconds = TICK_SECONDS;
+			frame.CaptureRain(drops, &simData);
+			frame.SimulateSeconds = static_cast<float>(step);
+			frame.ColumnHeights.assign(STAMP_SIZE + static_cast<size_t>(step % 7), static_cast<float>(step));
+			frames.Publish();
+		}
+	}
+
+	// The snapshot is a single step's: every stamp agrees with its EndTime.
+	bool IsWhole(const FrameSnapshot& frame)
+	{
+		const auto step = static_cast<float>(frame.EndTime);
+		if (frame.SimulateSeconds != step) return false;
+		if (frame.ColumnHeights.size() != STAMP_SIZE + static_cast<size_t>(static_cast<int>(frame.EndTime) % 7)) return false;
+		for (const float value : frame.ColumnHeights)
+		{
+			if (value != step) return false;
+		}
+		return true;
+	}
+
+	void RunHandoff(TripleBuffer<FrameSnapshot>& frames, const int maxDrops, const int firstStep)
+	{
+		std::atomic<bool> producing{ true };
+		std::thread producer([&]
+		{
+			Produce(frames, maxDrops, firstStep);
+			producing.store(false, std::memory_order_release);
+		});
+
+		FrameGeometry geometry;
+		double lastEnd = firstStep - 1;
+		int acquired = 0;
+		int torn = 0;
+		int stale = 0;
+		while (producing.load(std::memory_order_acquire))
+		{
+			if (!frames.Acquire()) continue;
+			const FrameSnapshot& frame = frames.Front();
+			if (!IsWhole(frame)) ++torn;
+			if (frame.EndTime <= lastEnd) ++stale;
+			lastEnd = frame.EndTime;
+			frame.Interpolate(0.5f, geometry);
+			++acquired;
+		}
+		producer.join();
+
+		// The last published step is still waiting, unless the loop took it.
+		const int lastStep = firstStep + STEPS_PER_RUN - 1;
+		if (frames.Acquire())
+		{
+			++acquired;
+			if (!IsWhole(frames.Front())) ++torn;
+		}
+		std::printf("%d drops, steps %d-%d: %d snapshot(s) acquired\n", maxDrops, firstStep, lastStep, acquired);
+		CHECK(torn == 0);
+		CHECK(stale == 0);
+		CHECK(acquired > 0);
+		CHECK(frames.Front().EndTime == lastStep);
+		CHECK(!frames.Acquire());
+	}
+}
+
+int main()
+{
+	TripleBuffer<FrameSnapshot> frames;
+	for (int run = 0; run < RUNS; ++run)
+	{
+		RunHandoff(frames, 200 + run * 400, 1 + run * STEPS_PER_RUN);
+
+		// As DiscardFrames: nothing is left to acquire afterwards.
+		frames.ForEachSlot([](FrameSnapshot& frame) { frame.Clear(); });
+		CHECK(!frames.Acquire());
+		CHECK(frames.Front().EndTime == 0.0);
+	}
+	return Test::Result();
+}
@@ -0,0 +1,131 @@
+// VisibilityTracker through synthetic cover traces, sampled once per frame as
+// the main loop does: a glimpse shorter than OCCLUDE_DELAY_SECONDS changes
+// nothing, a longer cover turns Occluded with a keep-alive step every
+// KEEP_ALIVE_SECONDS, PAUSE_AFTER_SECONDS of cover pauses outright, and
+// uncovering is Visible again at once, after which the delays start over.
+
+#include <cstdio>
+#include <vector>
+
+#include "TestUtil.h"
+#include "VisibilityTracker.h"
+
+namespace
+{
+	using State = VisibilityTracker::State;
+
+	// A power of two, so every delay is a whole number of samples exactly.
+	constexpr double SAMPLE_SECONDS = 1.0 / 64.0;
+
+	struct Trace
+	{
+		std::vector<double> Changes;    // times Update reported a change
+		std::vector<double> KeepAlives; // times a keep-alive step was due
+	};
+
+	// Sample `covered` every SAMPLE_SECONDS for `seconds` from `now`, taking
+	// due keep-alive steps as the render loop does.
+	Trace Run(VisibilityTracker& tracker, double& now, const bool covered, const double seconds)
+	{
+		Trace trace;
+		const double end = now + seconds;
+		while (now < end)
+		{
+			now += SAMPLE_SECONDS;
+			if (tracker.Update(covered, now)) trace.Changes.push_back(now);
+			if (tracker.TakeKeepAliveTick(now)) trace.KeepAlives.push_back(now);
+		}
+		return trace;
+	}
+
+	void TestGlimpse()
+	{
+		VisibilityTracker tracker;
+		double now = 100.0;
+		CHECK(Run(tracker, now, false, 1.0).Changes.empty());
+
+		// Alt-tabbing past a fullscreen window: covered just under the delay.
+		const Trace glimpse = Run(tracker, now, true, VisibilityTracker::OCCLUDE_DELAY_SECONDS - SAMPLE_SECONDS);
+		CHECK(glimpse.Changes.empty());
+		CHECK(glimpse.KeepAlives.empty());
+		CHECK(tracker.GetState() == State::Visible);
+		CHECK(Run(tracker, now, false, 1.0).Changes.empty());
+
+		// Glimpses back to back: each covered run counts from its own start.
+		for (int i = 0; i < 10; ++i)
+		{
+			CHECK(Run(tracker, now, true, VisibilityTracker::OCCLUDE_DELAY_SECONDS - SAMPLE_SECONDS).Changes.empty());
+			CHECK(Run(tracker, now, false, SAMPLE_SECONDS).Changes.empty());
+		}
+		CHECK(tracker.GetState() == State::Visible);
+	}
+
+	void TestOccludeAndPause()
+	{
+		VisibilityTracker tracker;
+		double now = 0.0;
+		Run(tracker, now, false, 1.0);
+
+		// Covered: Occluded once covered for OCCLUDE_DELAY_SECONDS (counted from
+		// the first covered sample), then a keep-alive step every
+		// KEEP_ALIVE_SECONDS, then Paused at PAUSE_AFTER_SECONDS.
+		const double coverStart = now + SAMPLE_SECONDS;
+		const Trace covered = Run(tracker, now, true, VisibilityTracker::PAUSE_AFTER_SECONDS + 5.0);
+		CHECK(covered.Changes.size() == 2);
+		if (covered.Changes.size() == 2)
+		{
+			CHECK(covered.Changes[0] - coverStart == VisibilityTracker::OCCLUDE_DELAY_SECONDS);
+			CHECK(covered.Changes[1] - coverStart == VisibilityTracker::PAUSE_AFTER_SECONDS);
+			std::printf("occluded after %.3f s, paused after %.3f s, %zu keep-alive steps\n",
+			            covered.Changes[0] - coverStart, covered.Changes[1] - coverStart, covered.KeepAlives.size());
+
+			// The first step one interval after occluding, then evenly spaced,
+			// none once paused.
+			double last = covered.Changes[0];
+			bool even = !covered.KeepAlives.empty();
+			for (const double tick : covered.KeepAlives)
+			{
+				even = even && tick - last == VisibilityTracker::KEEP_ALIVE_SECONDS && tick < covered.Changes[1];
+				last = tick;
+			}
+			CHECK(even);
+			// Every interval that ends before the pause (a step due at the
+			// pause itself is not taken).
+			size_t expectedSteps = 0;
+			for (double tick = covered.Changes[0] + VisibilityTracker::KEEP_ALIVE_SECONDS; tick < covered.Changes[1];
+			     tick += VisibilityTracker::KEEP_ALIVE_SECONDS)
+			{
+				++expectedSteps;
+			}
+			CHECK(covered.KeepAlives.size() == expectedSteps);
+		}
+		CHECK(tracker.GetState() == State::Paused);
+		CHECK(!tracker.TakeKeepAliveTick(now + 100.0));
+
+		// Uncovered: Visible at the very next sample, with no keep-alive steps.
+		const double uncoverAt = now + SAMPLE_SECONDS;
+		const Trace uncovered = Run(tracker, now, false, 1.0);
+		CHECK(uncovered.Changes.size() == 1 && uncovered.Changes[0] == uncoverAt);
+		CHECK(uncovered.KeepAlives.empty());
+		CHECK(tracker.GetState() == State::Visible);
+
+		// Covered again: the delay starts over rather than pausing at once.
+		const double recoverStart = now + SAMPLE_SECONDS;
+		const Trace again = Run(tracker, now, true, 2.0);
+		CHECK(again.Changes.size() == 1 &&
+		      again.Changes[0] - recoverStart == VisibilityTracker::OCCLUDE_DELAY_SECONDS);
+		CHECK(tracker.GetState() == State::Occluded);
+
+		// Uncovered while Occluded: Visible at once, and no more steps due.
+		const Trace back = Run(tracker, now, false, 1.0);
+		CHECK(back.Changes.size() == 1 && back.KeepAlives.empty());
+		CHECK(tracker.GetState() == State::Visible);
+	}
+}
+
+int main()
+{
+	TestGlimpse();
+	TestOccludeAndPause();
+	return Test::Result();
+}